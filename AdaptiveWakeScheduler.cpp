@@ -0,0 +1,72 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// AdaptiveWakeScheduler.cpp: Implementation of the AdaptiveWakeScheduler class.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#include "AdaptiveWakeScheduler.h"
+#include <algorithm>
+
+namespace Spectrum {
+    namespace Internal {
+
+        namespace {
+            using Micros = AdaptiveWakeScheduler::Duration;
+
+            constexpr Micros DEFAULT_DEVICE_PERIOD = Micros(10000);
+            constexpr Micros MIN_SLEEP = Micros(1000);
+            constexpr Micros MAX_IDLE_SLEEP = Micros(100000);
+            // Wake this much before the predicted packet to absorb timer slop
+            constexpr Micros WAKE_AHEAD_MARGIN = Micros(1500);
+            // A packet this many intervals overdue means the stream went
+            // idle; until then it is only late, and a fixed retry count ran
+            // out under a millisecond of arrival jitter
+            constexpr int LATE_PACKET_INTERVALS = 2;
+        }
+
+        AdaptiveWakeScheduler::AdaptiveWakeScheduler(
+            Duration devicePeriod,
+            uint32_t sampleRate
+        )
+            : m_devicePeriod(devicePeriod.count() > 0 ? devicePeriod : DEFAULT_DEVICE_PERIOD),
+            m_sampleRate(sampleRate),
+            m_nextSleep(MIN_SLEEP),
+            m_sinceLastPacket(0) {
+        }
+
+        void AdaptiveWakeScheduler::OnWake(
+            uint32_t framesProcessed,
+            uint32_t lastPacketFrames
+        ) noexcept {
+            const Duration interval = PredictPacketInterval(lastPacketFrames);
+
+            if (framesProcessed > 0) {
+                m_sinceLastPacket = Duration(0);
+                m_nextSleep = std::max(MIN_SLEEP, interval - WAKE_AHEAD_MARGIN);
+                return;
+            }
+
+            // Approximate: the sleep just finished, without timer overshoot
+            m_sinceLastPacket += m_nextSleep;
+            if (m_sinceLastPacket < interval * LATE_PACKET_INTERVALS) {
+                m_nextSleep = MIN_SLEEP;
+                return;
+            }
+
+            // Stream is idle: back off exponentially, capped
+            const Duration base = std::max(m_nextSleep, interval);
+            m_nextSleep = std::min(base * 2, MAX_IDLE_SLEEP);
+        }
+
+        AdaptiveWakeScheduler::Duration AdaptiveWakeScheduler::PredictPacketInterval(
+            uint32_t lastPacketFrames
+        ) const noexcept {
+            if (lastPacketFrames == 0 || m_sampleRate == 0) {
+                return m_devicePeriod;
+            }
+
+            const Duration packetDuration = Duration(
+                static_cast<int64_t>(lastPacketFrames) * 1000000 / m_sampleRate
+            );
+            return std::max(MIN_SLEEP, packetDuration);
+        }
+
+    }
+}
@@ -0,0 +1,39 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// AdaptiveWakeScheduler.h: Predicts when the next capture packet is due.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#ifndef SPECTRUM_CPP_ADAPTIVE_WAKE_SCHEDULER_H
+#define SPECTRUM_CPP_ADAPTIVE_WAKE_SCHEDULER_H
+
+// Standard headers only, so the polling policy can be tested off Windows
+#include <chrono>
+#include <cstdint>
+
+namespace Spectrum {
+    namespace Internal {
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // SRP: Predicts when the next packet is due for the polling loop.
+        // Wakes just before the expected packet and backs off while idle.
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        class AdaptiveWakeScheduler {
+        public:
+            using Duration = std::chrono::microseconds;
+
+            AdaptiveWakeScheduler(Duration devicePeriod, uint32_t sampleRate);
+
+            void OnWake(uint32_t framesProcessed, uint32_t lastPacketFrames) noexcept;
+            Duration GetNextSleep() const noexcept { return m_nextSleep; }
+
+        private:
+            Duration PredictPacketInterval(uint32_t lastPacketFrames) const noexcept;
+
+            Duration m_devicePeriod;
+            uint32_t m_sampleRate;
+            Duration m_nextSleep;
+            Duration m_sinceLastPacket;   // Slept since the last packet
+        };
+
+    }
+}
+
+#endif
@@ -13,6 +13,8 @@ namespace Spectrum {
         m_animationTime += deltaTime;
         SpectrumData testData = GenerateTestSpectrum(m_animationTime);
         m_postProcessor.Process(testData);
+        m_history.Push(m_postProcessor.GetSmoothedBars(), SpectrumHistory::Clock::now());
+        ++m_version;
     }
 
     SpectrumData AnimatedAudioSource::GetSpectrum() {
@@ -23,6 +25,7 @@ namespace Spectrum {
         if (m_barCount == count) return;
         m_barCount = count;
         m_postProcessor.SetBarCount(count);
+        ++m_version;
     }
 
     void AnimatedAudioSource::SetSmoothing(float smoothing) {
@@ -5,6 +5,7 @@
 #define SPECTRUM_CPP_ANIMATEDAUDIOSOURCE_H
 
 #include "IAudioSource.h"
+#include "SpectrumHistory.h"
 #include "SpectrumPostProcessor.h"
 
 namespace Spectrum {
@@ -16,6 +17,8 @@ namespace Spectrum {
         bool Initialize() override { return true; }
         void Update(float deltaTime) override;
         SpectrumData GetSpectrum() override;
+        uint64_t GetSpectrumVersion() const override { return m_version; }
+        const SpectrumHistory* GetSpectrumHistory() const override { return &m_history; }
 
         void SetBarCount(size_t count) override;
         void SetSmoothing(float smoothing);
@@ -25,7 +28,9 @@ namespace Spectrum {
 
         float m_animationTime = 0.0f;
         size_t m_barCount;
+        uint64_t m_version = 0;
         SpectrumPostProcessor m_postProcessor;
+        SpectrumHistory m_history;
     };
 
 }
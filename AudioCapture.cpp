@@ -92,7 +92,10 @@ namespace Spectrum {
             m_pimpl->engine = std::make_unique<Internal::EventDrivenEngine>(data->samplesEvent);
         }
         else {
-            m_pimpl->engine = std::make_unique<Internal::PollingEngine>();
+            m_pimpl->engine = std::make_unique<Internal::PollingEngine>(
+                data->devicePeriod,
+                data->waveFormat ? data->waveFormat->nSamplesPerSec : 0
+            );
             if (data->samplesEvent) {
                 CloseHandle(data->samplesEvent);
                 data->samplesEvent = nullptr;
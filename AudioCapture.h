@@ -4,24 +4,12 @@
 #ifndef SPECTRUM_CPP_AUDIO_CAPTURE_H
 #define SPECTRUM_CPP_AUDIO_CAPTURE_H
 
-#include "Common.h"
+#include "Win32Common.h"
+#include "IAudioCaptureCallback.h"
 #include <memory>
 
 namespace Spectrum {
 
-    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
-    // Interface for receiving audio data callbacks.
-    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
-    class IAudioCaptureCallback {
-    public:
-        virtual ~IAudioCaptureCallback() = default;
-        virtual void OnAudioData(
-            const float* data,
-            size_t samples,
-            int channels
-        ) = 0;
-    };
-
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
     // Manages a single audio capture session.
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
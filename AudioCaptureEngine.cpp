@@ -6,6 +6,10 @@
 #include "WASAPIHelper.h"
 #include <chrono>
 
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
 namespace Spectrum {
     namespace Internal {
 
@@ -88,6 +92,11 @@ namespace Spectrum {
                 return false;
             }
 
+            // Only a scheduling hint for the polling engine; not fatal
+            if (FAILED(data.audioClient->GetDevicePeriod(&data.devicePeriod, nullptr))) {
+                data.devicePeriod = 0;
+            }
+
             data.samplesEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
             if (!data.samplesEvent) {
                 LOG_ERROR("Failed to create capture event");
@@ -166,17 +175,19 @@ namespace Spectrum {
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 
         AudioPacketProcessor::AudioPacketProcessor(IAudioCaptureClient* client, int channels)
-            : m_captureClient(client), m_channels(channels), m_callback(nullptr) {
+            : m_captureClient(client), m_channels(channels), m_lastPacketFrames(0), m_callback(nullptr) {
         }
 
         void AudioPacketProcessor::SetCallback(IAudioCaptureCallback* callback) noexcept {
-            std::lock_guard<std::mutex> lock(m_callbackMutex);
-            m_callback = callback;
+            m_callback.store(callback, std::memory_order_release);
         }
 
-        HRESULT AudioPacketProcessor::ProcessAvailablePackets() {
+        HRESULT AudioPacketProcessor::ProcessAvailablePackets(UINT32* framesProcessed) {
             HRESULT hr = S_OK;
             UINT32 packetLen = 0;
+            UINT32 totalFrames = 0;
+
+            if (framesProcessed) *framesProcessed = 0;
 
             while (SUCCEEDED(hr = m_captureClient->GetNextPacketSize(&packetLen)) && packetLen > 0) {
                 BYTE* data = nullptr;
@@ -193,9 +204,9 @@ namespace Spectrum {
                 if (FAILED(hr)) return hr;
 
                 if (frames > 0 && data != nullptr && !(flags & AUDCLNT_BUFFERFLAGS_SILENT)) {
-                    std::lock_guard<std::mutex> lock(m_callbackMutex);
-                    if (m_callback) {
-                        m_callback->OnAudioData(
+                    IAudioCaptureCallback* callback = m_callback.load(std::memory_order_acquire);
+                    if (callback) {
+                        callback->OnAudioData(
                             reinterpret_cast<float*>(data),
                             static_cast<size_t>(frames) * m_channels,
                             m_channels
@@ -205,6 +216,10 @@ namespace Spectrum {
 
                 hr = m_captureClient->ReleaseBuffer(frames);
                 if (FAILED(hr)) return hr;
+
+                if (frames > 0) m_lastPacketFrames = frames;
+                totalFrames += frames;
+                if (framesProcessed) *framesProcessed = totalFrames;
             }
             return hr;
         }
@@ -241,22 +256,53 @@ namespace Spectrum {
             return hr;
         }
 
+        PollingEngine::PollingEngine(REFERENCE_TIME devicePeriod, uint32_t sampleRate)
+            // REFERENCE_TIME is in 100 ns units
+            : m_scheduler(AdaptiveWakeScheduler::Duration(devicePeriod / 10), sampleRate),
+            m_timer(nullptr) {
+            // Windows 10 1803+; older systems fall back to sleep_for
+            m_timer = CreateWaitableTimerExW(
+                nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS
+            );
+            if (!m_timer) {
+                LOG_INFO("High-resolution timer unavailable; polling on the system tick.");
+            }
+        }
+
+        PollingEngine::~PollingEngine() {
+            if (m_timer) CloseHandle(m_timer);
+        }
+
         HRESULT PollingEngine::Run(
             const std::atomic<bool>& stopRequested,
             AudioPacketProcessor& processor
         ) {
-            constexpr auto kPollingInterval = std::chrono::milliseconds(20);
             HRESULT hr = S_OK;
 
             while (!stopRequested) {
-                hr = processor.ProcessAvailablePackets();
+                UINT32 frames = 0;
+                hr = processor.ProcessAvailablePackets(&frames);
                 if (FAILED(hr)) {
                     break;
                 }
-                std::this_thread::sleep_for(kPollingInterval);
+                m_scheduler.OnWake(frames, processor.GetLastPacketFrames());
+                SleepFor(m_scheduler.GetNextSleep());
             }
             return hr;
         }
 
+        void PollingEngine::SleepFor(AdaptiveWakeScheduler::Duration duration) {
+            if (m_timer) {
+                // Negative due time is relative, in 100 ns units
+                LARGE_INTEGER dueTime;
+                dueTime.QuadPart = -static_cast<LONGLONG>(duration.count()) * 10;
+                if (SetWaitableTimer(m_timer, &dueTime, 0, nullptr, nullptr, FALSE) &&
+                    WaitForSingleObject(m_timer, INFINITE) == WAIT_OBJECT_0) {
+                    return;
+                }
+            }
+            std::this_thread::sleep_for(duration);
+        }
+
     }
 }
\ No newline at end of file
@@ -4,7 +4,8 @@
 #ifndef SPECTRUM_CPP_AUDIO_CAPTURE_ENGINE_H
 #define SPECTRUM_CPP_AUDIO_CAPTURE_ENGINE_H
 
-#include "Common.h"
+#include "Win32Common.h"
+#include "AdaptiveWakeScheduler.h"
 
 namespace Spectrum {
 
@@ -20,6 +21,7 @@ namespace Spectrum {
             wrl::ComPtr<IAudioCaptureClient> captureClient;
             WAVEFORMATEX* waveFormat = nullptr;
             HANDLE samplesEvent = nullptr;
+            REFERENCE_TIME devicePeriod = 0;
             bool useEventMode = false;
         };
 
@@ -64,13 +66,16 @@ namespace Spectrum {
         public:
             AudioPacketProcessor(IAudioCaptureClient* client, int channels);
             void SetCallback(IAudioCaptureCallback* callback) noexcept;
-            HRESULT ProcessAvailablePackets();
+            HRESULT ProcessAvailablePackets(UINT32* framesProcessed = nullptr);
+
+            UINT32 GetLastPacketFrames() const noexcept { return m_lastPacketFrames; }
 
         private:
             IAudioCaptureClient* m_captureClient;
             int m_channels;
-            IAudioCaptureCallback* m_callback;
-            std::mutex m_callbackMutex;
+            UINT32 m_lastPacketFrames;
+            // Read on every packet; atomic so the capture thread never locks
+            std::atomic<IAudioCaptureCallback*> m_callback;
         };
 
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
@@ -98,10 +103,23 @@ namespace Spectrum {
 
         class PollingEngine : public ICaptureEngine {
         public:
+            PollingEngine(REFERENCE_TIME devicePeriod, uint32_t sampleRate);
+            ~PollingEngine() override;
+
+            PollingEngine(const PollingEngine&) = delete;
+            PollingEngine& operator=(const PollingEngine&) = delete;
+
             HRESULT Run(
                 const std::atomic<bool>& stopRequested,
                 AudioPacketProcessor& processor
             ) override;
+        private:
+            // Sleeps on the high-resolution timer; the default timer and
+            // sleep_for round up to the ~15.6 ms system tick
+            void SleepFor(AdaptiveWakeScheduler::Duration duration);
+
+            AdaptiveWakeScheduler m_scheduler;
+            HANDLE m_timer;
         };
 
     }
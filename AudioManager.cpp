@@ -6,6 +6,7 @@
 #include "Utils.h"
 #include "RealtimeAudioSource.h"
 #include "AnimatedAudioSource.h"
+#include "SpectrumView.h"
 
 namespace Spectrum {
 
@@ -30,6 +31,7 @@ namespace Spectrum {
     bool AudioManager::Initialize() {
         m_realtimeSource = std::make_unique<RealtimeAudioSource>(m_audioConfig);
         m_animatedSource = std::make_unique<AnimatedAudioSource>(m_audioConfig);
+        if (m_dataListener) m_realtimeSource->SetDataListener(m_dataListener);
 
         if (!m_realtimeSource->Initialize() || !m_animatedSource->Initialize()) {
             return false;
@@ -52,6 +54,39 @@ namespace Spectrum {
         return {};
     }
 
+    bool AudioManager::GetInterpolatedSpectrum(
+        std::chrono::steady_clock::time_point time,
+        SpectrumData& out
+    ) {
+        if (m_currentSource) {
+            return m_currentSource->GetInterpolatedSpectrum(time, out);
+        }
+        out.clear();
+        return false;
+    }
+
+    uint64_t AudioManager::GetSpectrumVersion() const {
+        return m_currentSource ? m_currentSource->GetSpectrumVersion() : 0;
+    }
+
+    const SpectrumHistory* AudioManager::GetSpectrumHistory() const {
+        return m_currentSource ? m_currentSource->GetSpectrumHistory() : nullptr;
+    }
+
+    SpectrumView* AudioManager::AddSpectrumView(size_t barCount) {
+        if (!m_realtimeSource) return nullptr;
+
+        return m_realtimeSource->AddSpectrumView(barCount, m_audioConfig.scaleType);
+    }
+
+    void AudioManager::RemoveSpectrumView(const SpectrumView* view) {
+        if (m_realtimeSource && view) m_realtimeSource->RemoveSpectrumView(view);
+    }
+
+    void AudioManager::SetDataListener(std::function<void()> listener) {
+        m_dataListener = std::move(listener);
+    }
+
     void AudioManager::ToggleCapture() {
         if (m_isAnimating) return;
 
@@ -10,6 +10,8 @@ namespace Spectrum {
 
     class EventBus;
     class IAudioSource;
+    class SpectrumHistory;
+    class SpectrumView;
 
     class AudioManager {
     public:
@@ -20,6 +22,28 @@ namespace Spectrum {
         void Update(float deltaTime);
         SpectrumData GetSpectrum();
 
+        // The primary source's bars as of `time`; see IAudioSource
+        bool GetInterpolatedSpectrum(
+            std::chrono::steady_clock::time_point time,
+            SpectrumData& out
+        );
+
+        // Moves whenever the current source publishes new bars
+        uint64_t GetSpectrumVersion() const;
+
+        // The primary source's history; null if it keeps none
+        const SpectrumHistory* GetSpectrumHistory() const;
+
+        // Bars at another count from the live source's FFT. Scale,
+        // amplification and smoothing follow the Change*() calls like the
+        // main spectrum does. Only the live source feeds them, so they hold
+        // still while the animation runs; null before Initialize()
+        SpectrumView* AddSpectrumView(size_t barCount);
+        void RemoveSpectrumView(const SpectrumView* view);
+
+        // Applied to the capturing source; call before Initialize()
+        void SetDataListener(std::function<void()> listener);
+
         void ToggleCapture();
         void ToggleAnimation();
         void ChangeAmplification(float delta);
@@ -35,6 +59,8 @@ namespace Spectrum {
         std::unique_ptr<IAudioSource> m_animatedSource;
         IAudioSource* m_currentSource = nullptr;
 
+        std::function<void()> m_dataListener;
+
         AudioConfig m_audioConfig;
         bool m_isCapturing = false;
         bool m_isAnimating = false;
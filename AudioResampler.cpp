@@ -0,0 +1,149 @@
+// AudioResampler.cpp
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// AudioResampler.cpp: Implementation of the LinearResampler class.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include "AudioResampler.h"
+
+namespace Spectrum {
+
+    namespace {
+        // Sinc zero crossings on each side of the center, per unit of step
+        constexpr double FILTER_ZERO_CROSSINGS = 8.0;
+        // Cutoff as a fraction of the output Nyquist; the rest is transition
+        constexpr double FILTER_CUTOFF = 0.9;
+    }
+
+    LinearResampler::LinearResampler()
+        : m_step(1.0)
+        , m_phase(0.0)
+        , m_passthrough(true)
+        , m_taps(1, 1.0f)
+        , m_history(1, 0.0f) {
+    }
+
+    void LinearResampler::Configure(size_t inputRate, size_t outputRate) {
+        m_passthrough = inputRate == 0 || outputRate == 0 || inputRate == outputRate;
+        m_step = m_passthrough
+            ? 1.0
+            : static_cast<double>(inputRate) / static_cast<double>(outputRate);
+        DesignAntiAliasFilter();
+        Reset();
+    }
+
+    void LinearResampler::Reset() noexcept {
+        m_phase = 0.0;
+        std::fill(m_history.begin(), m_history.end(), 0.0f);
+    }
+
+    // Blackman-windowed sinc, normalized to unity gain at DC
+    void LinearResampler::DesignAntiAliasFilter() {
+        if (m_passthrough || m_step <= 1.0) {
+            m_taps.assign(1, 1.0f);
+            m_history.assign(1, 0.0f);
+            return;
+        }
+
+        const size_t half = static_cast<size_t>(std::ceil(FILTER_ZERO_CROSSINGS * m_step));
+        const size_t length = 2 * half + 1;
+        const double cutoff = FILTER_CUTOFF * 0.5 / m_step;   // Cycles per input sample
+
+        m_taps.resize(length);
+        double sum = 0.0;
+        for (size_t n = 0; n < length; ++n) {
+            const double x = static_cast<double>(n) - static_cast<double>(half);
+            const double sinc = x == 0.0
+                ? 2.0 * cutoff
+                : std::sin(2.0 * PI * cutoff * x) / (PI * x);
+            const double t = static_cast<double>(n) / static_cast<double>(length - 1);
+            const double window = 0.42 - 0.5 * std::cos(2.0 * PI * t)
+                + 0.08 * std::cos(4.0 * PI * t);
+
+            m_taps[n] = static_cast<float>(sinc * window);
+            sum += sinc * window;
+        }
+        for (float& tap : m_taps) tap = static_cast<float>(tap / sum);
+
+        m_history.assign(length, 0.0f);
+    }
+
+    // Index -1 is the newest sample of the previous call. The taps are
+    // symmetric, so they run forward over the samples.
+    float LinearResampler::FilteredSample(const float* input, ptrdiff_t index) const noexcept {
+        const ptrdiff_t length = static_cast<ptrdiff_t>(m_taps.size());
+        const ptrdiff_t first = index - length + 1;
+
+        if (first >= 0) {
+            return std::inner_product(m_taps.begin(), m_taps.end(), input + first, 0.0f);
+        }
+
+        const ptrdiff_t historySize = static_cast<ptrdiff_t>(m_history.size());
+        float sum = 0.0f;
+        for (ptrdiff_t k = 0; k < length; ++k) {
+            const ptrdiff_t i = first + k;
+            sum += m_taps[k] * (i < 0 ? m_history[historySize + i] : input[i]);
+        }
+        return sum;
+    }
+
+    size_t LinearResampler::Process(
+        const float* input,
+        size_t inputCount,
+        float* output,
+        size_t outputCapacity
+    ) noexcept {
+        if (!input || !output || inputCount == 0) return 0;
+
+        if (m_passthrough) {
+            const size_t count = std::min(inputCount, outputCapacity);
+            std::copy_n(input, count, output);
+            return count;
+        }
+
+        // Position is relative to input[0]; index -1 is the last sample
+        // of the previous call
+        const double lastIndex = static_cast<double>(inputCount - 1);
+        double position = m_phase;
+        size_t produced = 0;
+
+        while (position < lastIndex && produced < outputCapacity) {
+            const double base = std::floor(position);
+            const ptrdiff_t index = static_cast<ptrdiff_t>(base);
+            const float frac = static_cast<float>(position - base);
+
+            const float s0 = FilteredSample(input, index);
+            const float s1 = FilteredSample(input, index + 1);
+
+            output[produced++] = s0 + (s1 - s0) * frac;
+            position += m_step;
+        }
+
+        m_phase = std::max(position - static_cast<double>(inputCount), -1.0);
+
+        // Slide the newest inputs into the history
+        const size_t historySize = m_history.size();
+        if (inputCount >= historySize) {
+            std::copy_n(input + inputCount - historySize, historySize, m_history.begin());
+        }
+        else {
+            std::copy(m_history.begin() + inputCount, m_history.end(), m_history.begin());
+            std::copy_n(input, inputCount, m_history.end() - inputCount);
+        }
+        return produced;
+    }
+
+    size_t LinearResampler::GetInputFramesFor(size_t outputFrames) const noexcept {
+        if (m_passthrough) return outputFrames;
+
+        const size_t frames = static_cast<size_t>(static_cast<double>(outputFrames) * m_step);
+        return std::max<size_t>(1, frames);
+    }
+
+    size_t LinearResampler::GetOutputSlack() const noexcept {
+        if (m_passthrough) return 0;
+
+        // Rounding in GetInputFramesFor can yield a few extra outputs
+        return static_cast<size_t>(std::ceil(1.0 / m_step)) + 2;
+    }
+
+} // namespace Spectrum
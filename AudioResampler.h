@@ -0,0 +1,58 @@
+// AudioResampler.h
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// AudioResampler.h: Streaming linear resampler for mono analysis input,
+// low-pass filtered when it decimates.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#ifndef SPECTRUM_CPP_AUDIO_RESAMPLER_H
+#define SPECTRUM_CPP_AUDIO_RESAMPLER_H
+
+#include "Common.h"
+
+namespace Spectrum {
+
+    // Downsampling first runs a windowed-sinc low-pass at the output
+    // Nyquist rate, so content above it does not fold back into the
+    // spectrum. It is evaluated only at the samples the interpolation
+    // reads. Upsampling needs no filter and interpolates the raw input.
+    class LinearResampler {
+    public:
+        LinearResampler();
+
+        // Configuration; allocates the filter, Process() does not
+        void Configure(size_t inputRate, size_t outputRate);
+        void Reset() noexcept;
+
+        // Processing; keeps interpolation state across calls
+        size_t Process(
+            const float* input,
+            size_t inputCount,
+            float* output,
+            size_t outputCapacity
+        ) noexcept;
+
+        // Sizing helpers for callers that preallocate
+        size_t GetInputFramesFor(size_t outputFrames) const noexcept;
+        size_t GetOutputSlack() const noexcept;
+
+        // Getters
+        bool IsPassthrough() const noexcept { return m_passthrough; }
+        size_t GetFilterLength() const noexcept { return m_taps.size(); }
+
+    private:
+        void DesignAntiAliasFilter();
+        float FilteredSample(const float* input, ptrdiff_t index) const noexcept;
+
+        double m_step;
+        double m_phase;
+        bool m_passthrough;
+
+        // A single unit tap when no filtering is needed
+        std::vector<float> m_taps;
+        // The last m_taps.size() inputs of the previous call, oldest first
+        std::vector<float> m_history;
+    };
+
+} // namespace Spectrum
+
+#endif // SPECTRUM_CPP_AUDIO_RESAMPLER_H
@@ -0,0 +1,106 @@
+// AudioRingBuffer.cpp
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// AudioRingBuffer.cpp: Implementation of the lock-free sample ring.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include "AudioRingBuffer.h"
+#include <cstring>
+
+namespace Spectrum {
+
+    AudioRingBuffer::AudioRingBuffer(size_t minCapacity)
+        : m_capacity(RoundUpToPowerOfTwo(std::max<size_t>(minCapacity, 2))),
+        m_mask(0) {
+        m_mask = m_capacity - 1;
+        m_data = std::make_unique<float[]>(m_capacity);
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Producer
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    size_t AudioRingBuffer::Write(const float* data, size_t count) noexcept {
+        if (!data || count == 0) return 0;
+
+        const size_t writePos = m_writePos.load(std::memory_order_relaxed);
+        const size_t readPos = m_readPos.load(std::memory_order_acquire);
+        const size_t freeSpace = m_capacity - (writePos - readPos);
+
+        // The analyzer fell behind: drop the whole packet instead of
+        // blocking, so interleaved frames never get split across a gap
+        if (count > freeSpace) {
+            m_overruns.fetch_add(1, std::memory_order_relaxed);
+            return 0;
+        }
+
+        const size_t toWrite = count;
+
+        const size_t start = writePos & m_mask;
+        const size_t firstPart = std::min(toWrite, m_capacity - start);
+        std::memcpy(m_data.get() + start, data, firstPart * sizeof(float));
+        if (firstPart < toWrite) {
+            std::memcpy(m_data.get(), data + firstPart, (toWrite - firstPart) * sizeof(float));
+        }
+
+        m_writePos.store(writePos + toWrite, std::memory_order_release);
+        return toWrite;
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Consumer
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    size_t AudioRingBuffer::Read(float* dest, size_t count) noexcept {
+        if (!dest || count == 0) return 0;
+
+        const size_t readPos = m_readPos.load(std::memory_order_relaxed);
+        const size_t writePos = m_writePos.load(std::memory_order_acquire);
+        const size_t toRead = std::min(count, writePos - readPos);
+        if (toRead == 0) return 0;
+
+        const size_t start = readPos & m_mask;
+        const size_t firstPart = std::min(toRead, m_capacity - start);
+        std::memcpy(dest, m_data.get() + start, firstPart * sizeof(float));
+        if (firstPart < toRead) {
+            std::memcpy(dest + firstPart, m_data.get(), (toRead - firstPart) * sizeof(float));
+        }
+
+        m_readPos.store(readPos + toRead, std::memory_order_release);
+        return toRead;
+    }
+
+    size_t AudioRingBuffer::Skip(size_t count) noexcept {
+        const size_t readPos = m_readPos.load(std::memory_order_relaxed);
+        const size_t writePos = m_writePos.load(std::memory_order_acquire);
+        const size_t toSkip = std::min(count, writePos - readPos);
+
+        m_readPos.store(readPos + toSkip, std::memory_order_release);
+        return toSkip;
+    }
+
+    void AudioRingBuffer::Clear() noexcept {
+        m_readPos.store(
+            m_writePos.load(std::memory_order_acquire),
+            std::memory_order_release
+        );
+    }
+
+    size_t AudioRingBuffer::GetAvailable() const noexcept {
+        const size_t writePos = m_writePos.load(std::memory_order_acquire);
+        const size_t readPos = m_readPos.load(std::memory_order_relaxed);
+        return writePos - readPos;
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Helpers
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    size_t AudioRingBuffer::RoundUpToPowerOfTwo(size_t n) noexcept {
+        size_t result = 1;
+        while (result < n) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+} // namespace Spectrum
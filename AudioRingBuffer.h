@@ -0,0 +1,55 @@
+// AudioRingBuffer.h
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// AudioRingBuffer.h: Lock-free single-producer/single-consumer sample ring.
+// The capture thread writes raw interleaved packets; the analyzer drains them.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#ifndef SPECTRUM_CPP_AUDIO_RING_BUFFER_H
+#define SPECTRUM_CPP_AUDIO_RING_BUFFER_H
+
+#include "Common.h"
+
+namespace Spectrum {
+
+    class AudioRingBuffer {
+    public:
+        explicit AudioRingBuffer(size_t minCapacity);
+        ~AudioRingBuffer() = default;
+
+        AudioRingBuffer(const AudioRingBuffer&) = delete;
+        AudioRingBuffer& operator=(const AudioRingBuffer&) = delete;
+
+        // Producer side (capture thread): never allocates, never blocks
+        size_t Write(const float* data, size_t count) noexcept;
+
+        // Consumer side (analyzer thread)
+        size_t Read(float* dest, size_t count) noexcept;
+        size_t Skip(size_t count) noexcept;
+        void Clear() noexcept;
+
+        // Getters
+        size_t GetAvailable() const noexcept;
+        size_t GetCapacity() const noexcept { return m_capacity; }
+        uint64_t GetOverrunCount() const noexcept {
+            return m_overruns.load(std::memory_order_relaxed);
+        }
+
+    private:
+        static size_t RoundUpToPowerOfTwo(size_t n) noexcept;
+
+        static constexpr size_t CACHE_LINE_SIZE = 64;
+
+        std::unique_ptr<float[]> m_data;
+        size_t m_capacity;
+        size_t m_mask;
+
+        // Monotonic positions, kept on separate cache lines to avoid
+        // false sharing between the capture and analyzer threads
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_writePos{ 0 };
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_readPos{ 0 };
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> m_overruns{ 0 };
+    };
+
+} // namespace Spectrum
+
+#endif // SPECTRUM_CPP_AUDIO_RING_BUFFER_H
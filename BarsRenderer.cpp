@@ -30,7 +30,7 @@ namespace Spectrum {
     }
 
     void BarsRenderer::DoRender(
-        GraphicsContext& context,
+        RenderCommandList& commands,
         const SpectrumData& spectrum
     ) {
         const size_t barCount = spectrum.size();
@@ -52,12 +52,12 @@ namespace Spectrum {
                 bl.barWidth,
                 h
             );
-            RenderBar(context, rect, mag);
+            RenderBar(commands, rect, mag);
         }
     }
 
     void BarsRenderer::RenderBar(
-        GraphicsContext& context,
+        RenderCommandList& commands,
         const Rect& rect,
         float magnitude
     ) {
@@ -68,7 +68,7 @@ namespace Spectrum {
 
         if (m_settings.useShadow) {
             Rect shadow(rect.x + 2.0f, rect.y + 2.0f, rect.width, rect.height);
-            context.DrawRoundedRectangle(
+            commands.DrawRoundedRectangle(
                 shadow,
                 m_settings.cornerRadius,
                 Color(0, 0, 0, 0.3f),
@@ -77,7 +77,7 @@ namespace Spectrum {
         }
 
         if (m_settings.cornerRadius > 0.0f) {
-            context.DrawRoundedRectangle(
+            commands.DrawRoundedRectangle(
                 rect,
                 m_settings.cornerRadius,
                 barColor,
@@ -85,7 +85,7 @@ namespace Spectrum {
             );
         }
         else {
-            context.DrawRectangle(rect, barColor, true);
+            commands.DrawRectangle(rect, barColor, true);
         }
 
         if (m_settings.useHighlight) {
@@ -95,7 +95,7 @@ namespace Spectrum {
                 rect.width - 4.0f,
                 std::min(10.0f, rect.height * 0.2f)
             );
-            context.DrawRectangle(hl, Color(1, 1, 1, 0.2f * magnitude), true);
+            commands.DrawRectangle(hl, Color(1, 1, 1, 0.2f * magnitude), true);
         }
     }
 
@@ -16,14 +16,15 @@ namespace Spectrum {
 
         RenderStyle GetStyle() const override { return RenderStyle::Bars; }
         std::string_view GetName() const override { return "Bars"; }
+        bool IsSettled() const override { return true; }
 
     protected:
         void UpdateSettings() override;
-        void DoRender(GraphicsContext& context,
+        void DoRender(RenderCommandList& commands,
             const SpectrumData& spectrum) override;
 
     private:
-        void RenderBar(GraphicsContext& context,
+        void RenderBar(RenderCommandList& commands,
             const Rect& rect,
             float magnitude);
 
@@ -14,38 +14,68 @@ namespace Spectrum {
         m_height(0),
         m_time(0.0f),
         m_aspectRatio(0.0f), // Default: no fixed aspect ratio
-        m_padding(1.0f) {   // Default: full size
+        m_padding(1.0f),    // Default: full size
+        m_frameArena(nullptr),
+        m_spectrumHistory(nullptr),
+        m_fixedTimestep(0.0f),
+        m_stepAccumulator(0.0f) {
     }
 
     void BaseRenderer::SetQuality(RenderQuality quality) {
         if (m_quality == quality) return;
         m_quality = quality;
         UpdateSettings();
+        InvalidateStaticLayer();
     }
 
     void BaseRenderer::SetOverlayMode(bool isOverlay) {
         if (m_isOverlay == isOverlay) return;
         m_isOverlay = isOverlay;
         UpdateSettings();
+        InvalidateStaticLayer();
     }
 
     void BaseRenderer::SetPrimaryColor(const Color& color) {
         m_primaryColor = color;
+        InvalidateStaticLayer();
     }
 
     void BaseRenderer::OnActivate(int width, int height) {
         SetViewport(width, height);
+        InvalidateStaticLayer();
     }
 
     void BaseRenderer::Render(
-        GraphicsContext& context,
-        const SpectrumData& spectrum
+        IRenderBackend& backend,
+        const SpectrumData& spectrum,
+        float deltaTime
     ) {
         if (!IsRenderable(spectrum)) return;
 
-        UpdateTime(FRAME_TIME);
-        UpdateAnimation(spectrum, FRAME_TIME);
-        DoRender(context, spectrum);
+        if (!m_frameArena && m_ownedArena) {
+            m_ownedArena->Reset();
+        }
+
+        Advance(spectrum, std::clamp(deltaTime, 0.0f, MAX_DELTA_TIME));
+
+        m_commandList.Clear();
+        DoRender(m_commandList, spectrum);
+        m_commandList.Execute(backend);
+    }
+
+    FrameArena& BaseRenderer::GetFrameArena() {
+        if (m_frameArena) return *m_frameArena;
+        if (!m_ownedArena) {
+            m_ownedArena = std::make_unique<FrameArena>();
+        }
+        return *m_ownedArena;
+    }
+
+    void BaseRenderer::DrawStaticLayer(RenderCommandList& commands) {
+        if (!m_staticLayer.IsRecorded()) {
+            RenderStaticLayer(m_staticLayer.BeginRecording());
+        }
+        commands.DrawLayer(m_staticLayer);
     }
 
     // Calculates a centered rect, maintaining aspect ratio within the view
@@ -80,6 +110,36 @@ namespace Spectrum {
         );
     }
 
+    void BaseRenderer::SetFixedTimestep(float seconds) noexcept {
+        m_fixedTimestep = std::max(0.0f, seconds);
+        m_stepAccumulator = 0.0f;
+    }
+
+    // Fixed-step renderers may take zero or several steps in one frame;
+    // m_time moves with the steps so time-driven effects stay in sync
+    void BaseRenderer::Advance(const SpectrumData& spectrum, float deltaTime) {
+        if (m_fixedTimestep <= 0.0f) {
+            UpdateTime(deltaTime);
+            UpdateAnimation(spectrum, deltaTime);
+            return;
+        }
+
+        m_stepAccumulator += deltaTime;
+        int steps = 0;
+        while (m_stepAccumulator >= m_fixedTimestep - STEP_TOLERANCE
+            && steps < MAX_STEPS_PER_FRAME) {
+            UpdateTime(m_fixedTimestep);
+            UpdateAnimation(spectrum, m_fixedTimestep);
+            m_stepAccumulator -= m_fixedTimestep;
+            ++steps;
+        }
+
+        // Time beyond the step budget is dropped, not carried forward
+        if (steps == MAX_STEPS_PER_FRAME) {
+            m_stepAccumulator = std::min(m_stepAccumulator, m_fixedTimestep);
+        }
+    }
+
     void BaseRenderer::UpdateTime(float deltaTime) {
         m_time += deltaTime;
         if (m_time > TIME_RESET_THRESHOLD) m_time = 0.0f;
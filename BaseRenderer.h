@@ -5,7 +5,10 @@
 #ifndef SPECTRUM_CPP_BASE_RENDERER_H
 #define SPECTRUM_CPP_BASE_RENDERER_H
 
+#include "FrameArena.h"
 #include "IRenderer.h"
+#include "RenderCommandList.h"
+#include "RetainedLayer.h"
 #include "Common.h"
 
 namespace Spectrum {
@@ -22,11 +25,21 @@ namespace Spectrum {
         void SetPrimaryColor(const Color& color) override;
         void SetOverlayMode(bool isOverlay) override;
         void OnActivate(int width, int height) override;
+        void SetFrameArena(FrameArena* arena) override { m_frameArena = arena; }
+        void SetSpectrumHistory(const SpectrumHistory* history) override {
+            m_spectrumHistory = history;
+        }
         void Render(
-            GraphicsContext& context,
-            const SpectrumData& spectrum
+            IRenderBackend& backend,
+            const SpectrumData& spectrum,
+            float deltaTime
         ) override;
 
+        // Commands recorded by the last Render call
+        const RenderCommandList& GetCommandList() const noexcept {
+            return m_commandList;
+        }
+
     protected:
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
         // Virtual Methods for Child Classes
@@ -39,11 +52,16 @@ namespace Spectrum {
         ) {
         }
 
+        // Records the frame; nothing reaches the backend until it is replayed
         virtual void DoRender(
-            GraphicsContext& context,
+            RenderCommandList& commands,
             const SpectrumData& spectrum
         ) = 0;
 
+        // Content that only changes with size, quality, overlay mode or
+        // color. Recorded again only after the layer is invalidated.
+        virtual void RenderStaticLayer(RenderCommandList& commands) {}
+
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
         // Helper Methods for Child Classes
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
@@ -52,6 +70,23 @@ namespace Spectrum {
         // Calculates a centered rectangle with a fixed aspect ratio
         Rect CalculatePaddedRect() const;
 
+        // Records the static layer if stale and composites it in place
+        void DrawStaticLayer(RenderCommandList& commands);
+        void InvalidateStaticLayer() noexcept { m_staticLayer.Invalidate(); }
+
+        // Per-frame scratch; everything taken from it is gone next frame.
+        // Without an external arena a private one is reset on each Render.
+        FrameArena& GetFrameArena();
+
+        // Null when the audio source keeps no history
+        const SpectrumHistory* GetSpectrumHistory() const noexcept {
+            return m_spectrumHistory;
+        }
+
+        // Non-zero runs UpdateAnimation in steps of exactly this many
+        // seconds, for simulations tuned per step rather than per second
+        void SetFixedTimestep(float seconds) noexcept;
+
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
         // Member State
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
@@ -68,9 +103,29 @@ namespace Spectrum {
 
     private:
         void UpdateTime(float deltaTime);
+        void Advance(const SpectrumData& spectrum, float deltaTime);
         void SetViewport(int width, int height) noexcept;
 
+        // Reused every frame so recording stays allocation-free
+        RenderCommandList m_commandList;
+        RetainedLayer m_staticLayer;
+
+        FrameArena* m_frameArena;
+        std::unique_ptr<FrameArena> m_ownedArena;
+        const SpectrumHistory* m_spectrumHistory;
+
+        float m_fixedTimestep;
+        float m_stepAccumulator;
+
         static constexpr float TIME_RESET_THRESHOLD = 1e6f;
+
+        // Longer gaps (a stall, a dragged window) are clamped so nothing jumps
+        static constexpr float MAX_DELTA_TIME = 0.25f;
+        static constexpr int MAX_STEPS_PER_FRAME = 8;
+
+        // Frame times jitter around the display period; a step this close to
+        // due runs now instead of alternating between zero and two per frame
+        static constexpr float STEP_TOLERANCE = 0.002f;
     };
 
 }
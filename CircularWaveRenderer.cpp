@@ -13,16 +13,11 @@ namespace Spectrum {
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 
     CircularWaveRenderer::CircularWaveRenderer()
-        : m_angle(0.0f), m_waveTime(0.0f) {
+        : m_angle(0.0f), m_waveTime(0.0f), m_isSettled(false) {
         m_primaryColor = Color::FromRGB(0, 150, 255);
         UpdateSettings();
     }
 
-    void CircularWaveRenderer::OnActivate(int width, int height) {
-        BaseRenderer::OnActivate(width, height);
-        m_circlePoints.clear();
-    }
-
     void CircularWaveRenderer::UpdateSettings() {
         // Shared settings
         constexpr float centerRadius = 30.0f;
@@ -99,7 +94,7 @@ namespace Spectrum {
                 break;
             }
         }
-        m_circlePoints.clear();
+        EnsureUnitCircle();
     }
 
     void CircularWaveRenderer::UpdateAnimation(
@@ -118,24 +113,25 @@ namespace Spectrum {
         m_waveTime += m_settings.waveSpeed * deltaTime;
     }
 
-    void CircularWaveRenderer::EnsureCirclePoints() {
-        if (!m_circlePoints.empty()) return;
+    // Rebuilt only when the quality changes the segment count
+    void CircularWaveRenderer::EnsureUnitCircle() {
+        const size_t count = static_cast<size_t>(m_settings.pointsPerCircle);
+        if (m_unitCircle.GetPointCount() == count) return;
 
-        m_circlePoints.reserve(m_settings.pointsPerCircle + 1);
+        std::vector<Point> points;
+        points.reserve(count);
         const float step = TWO_PI / m_settings.pointsPerCircle;
-
-        for (int i = 0; i <= m_settings.pointsPerCircle; ++i) {
-            float a = i * step;
-            m_circlePoints.emplace_back(std::cos(a), std::sin(a));
+        for (size_t i = 0; i < count; ++i) {
+            const float a = i * step;
+            points.emplace_back(std::cos(a), std::sin(a));
         }
+        m_unitCircle.SetPoints(points, true);
     }
 
     void CircularWaveRenderer::DoRender(
-        GraphicsContext& context,
+        RenderCommandList& commands,
         const SpectrumData& spectrum
     ) {
-        EnsureCirclePoints();
-
         const Point center = { m_width * 0.5f, m_height * 0.5f };
         const float maxRadius = std::min(m_width, m_height)
             * m_settings.maxRadiusFactor;
@@ -144,17 +140,27 @@ namespace Spectrum {
             static_cast<int>(spectrum.size()),
             m_settings.maxRings
         );
+        m_isSettled = true;
         if (ringCount == 0) return;
 
         float ringStep = (maxRadius - m_settings.centerRadius) / ringCount;
 
+        // Up to a glow and a main stroke per ring
+        ArenaVector<GeometryInstance> rings(GetFrameArena(), ringCount * 2);
         for (int i = ringCount - 1; i >= 0; i--) {
-            RenderRing(context, spectrum, i, ringCount, ringStep, center, maxRadius);
+            RenderRing(rings, spectrum, i, ringCount, ringStep, center, maxRadius);
         }
+
+        commands.DrawGeometryInstances(
+            m_unitCircle,
+            rings.GetData(),
+            rings.GetSize(),
+            false
+        );
     }
 
     void CircularWaveRenderer::RenderRing(
-        GraphicsContext& context,
+        ArenaVector<GeometryInstance>& rings,
         const SpectrumData& spectrum,
         int index,
         int totalRings,
@@ -164,6 +170,7 @@ namespace Spectrum {
     ) {
         float magnitude = GetRingMagnitude(spectrum, index, totalRings);
         if (magnitude < m_settings.minMagnitudeThreshold) return;
+        m_isSettled = false;
 
         float radius = CalculateRingRadius(index, ringStep, magnitude);
         if (radius <= 0 || radius > maxRadius) return;
@@ -173,14 +180,14 @@ namespace Spectrum {
         float strokeWidth = CalculateStrokeWidth(magnitude);
 
         if (m_settings.useGlow && magnitude > m_settings.glowThreshold) {
-            RenderGlowLayer(context, center, radius, alpha, strokeWidth);
+            RenderGlowLayer(rings, center, radius, alpha, strokeWidth);
         }
 
-        RenderMainRing(context, center, radius, alpha, strokeWidth);
+        RenderMainRing(rings, center, radius, alpha, strokeWidth);
     }
 
     void CircularWaveRenderer::RenderGlowLayer(
-        GraphicsContext& context,
+        ArenaVector<GeometryInstance>& rings,
         const Point& center,
         float radius,
         float alpha,
@@ -190,11 +197,11 @@ namespace Spectrum {
         glowColor.a = alpha * m_settings.glowFactor;
         float glowWidth = strokeWidth * m_settings.glowWidthFactor;
 
-        DrawCirclePath(context, center, radius, glowColor, glowWidth);
+        AddCircle(rings, center, radius, glowColor, glowWidth);
     }
 
     void CircularWaveRenderer::RenderMainRing(
-        GraphicsContext& context,
+        ArenaVector<GeometryInstance>& rings,
         const Point& center,
         float radius,
         float alpha,
@@ -202,27 +209,25 @@ namespace Spectrum {
     ) {
         Color ringColor = m_primaryColor;
         ringColor.a = alpha;
-        DrawCirclePath(context, center, radius, ringColor, strokeWidth);
+        AddCircle(rings, center, radius, ringColor, strokeWidth);
     }
 
-    void CircularWaveRenderer::DrawCirclePath(
-        GraphicsContext& context,
+    void CircularWaveRenderer::AddCircle(
+        ArenaVector<GeometryInstance>& rings,
         const Point& center,
         float radius,
         const Color& color,
         float strokeWidth
     ) {
-        if (m_circlePoints.empty()) return;
+        if (m_unitCircle.IsEmpty() || radius <= 0.0f) return;
 
-        std::vector<Point> path;
-        path.reserve(m_circlePoints.size());
-        for (const auto& p : m_circlePoints) {
-            path.push_back(center + p * radius);
-        }
-        context.DrawPolyline(path, color, strokeWidth);
+        // Strokes scale with the transform, so the width is divided back out
+        const Transform2D placement = {
+            radius, 0.0f, 0.0f, radius, center.x, center.y
+        };
+        rings.PushBack({ placement, color, strokeWidth / radius });
     }
 
-
     float CircularWaveRenderer::CalculateRingRadius(
         int index,
         float ringStep,
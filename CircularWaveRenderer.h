@@ -19,8 +19,8 @@ namespace Spectrum {
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
         RenderStyle GetStyle() const override { return RenderStyle::CircularWave; }
         std::string_view GetName() const override { return "Circular Wave"; }
-
-        void OnActivate(int width, int height) override;
+        // Only the motion of drawn rings changes the picture
+        bool IsSettled() const override { return m_isSettled; }
 
     protected:
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
@@ -32,7 +32,7 @@ namespace Spectrum {
             float deltaTime
         ) override;
         void DoRender(
-            GraphicsContext& context,
+            RenderCommandList& commands,
             const SpectrumData& spectrum
         ) override;
 
@@ -63,9 +63,9 @@ namespace Spectrum {
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
         // Logic & Drawing Helpers
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
-        void EnsureCirclePoints();
+        void EnsureUnitCircle();
         void RenderRing(
-            GraphicsContext& context,
+            ArenaVector<GeometryInstance>& rings,
             const SpectrumData& spectrum,
             int index,
             int totalRings,
@@ -74,21 +74,21 @@ namespace Spectrum {
             float maxRadius
         );
         void RenderGlowLayer(
-            GraphicsContext& context,
+            ArenaVector<GeometryInstance>& rings,
             const Point& center,
             float radius,
             float alpha,
             float strokeWidth
         );
         void RenderMainRing(
-            GraphicsContext& context,
+            ArenaVector<GeometryInstance>& rings,
             const Point& center,
             float radius,
             float alpha,
             float strokeWidth
         );
-        void DrawCirclePath(
-            GraphicsContext& context,
+        void AddCircle(
+            ArenaVector<GeometryInstance>& rings,
             const Point& center,
             float radius,
             const Color& color,
@@ -105,7 +105,11 @@ namespace Spectrum {
         QualitySettings m_settings;
         float m_angle;
         float m_waveTime;
-        std::vector<Point> m_circlePoints;
+        // No ring passed the magnitude threshold in the last frame
+        bool m_isSettled;
+        // Radius-one ring placed by a transform per instance, so all rings
+        // go out as one draw that reuses the same backend path
+        RetainedGeometry m_unitCircle;
     };
 }
 
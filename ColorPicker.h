@@ -6,7 +6,7 @@
 #ifndef SPECTRUM_CPP_COLOR_PICKER_H
 #define SPECTRUM_CPP_COLOR_PICKER_H
 
-#include "Common.h"
+#include "Win32Common.h"
 #include "GraphicsContext.h"
 
 namespace Spectrum {
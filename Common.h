@@ -1,25 +1,13 @@
 // Common.h
 // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
-// Common.h: A central header file for all necessary system and standard libraries.
+// Common.h: Standard library headers, project types and logging shared by
+// every module. Platform headers live in Win32Common.h, so the analysis and
+// render core builds anywhere.
 // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 
 #ifndef SPECTRUM_CPP_COMMON_H
 #define SPECTRUM_CPP_COMMON_H
 
-#define NOMINMAX
-#define WIN32_LEAN_AND_MEAN
-
-// Windows headers
-#include <windows.h>
-#include <windowsx.h>
-#include <d2d1_3.h>
-#include <dwrite_3.h>
-#include <wrl/client.h>
-#include <dwmapi.h>
-#include <mmdeviceapi.h>
-#include <audioclient.h>
-#include <functiondiscoverykeys_devpkey.h>
-
 // Standard library headers
 #include <memory>
 #include <vector>
@@ -42,18 +30,9 @@
 #include <optional>
 #include <variant>
 
-// Link required libraries
-#pragma comment(lib, "d2d1.lib")
-#pragma comment(lib, "dwrite.lib")
-#pragma comment(lib, "ole32.lib")
-#pragma comment(lib, "uuid.lib")
-#pragma comment(lib, "dwmapi.lib")
-
 // Include project types
 #include "Types.h"
 
-namespace wrl = Microsoft::WRL;
-
 // Logging macros
 #ifdef _DEBUG
 #define LOG_DEBUG(msg) std::cout << "[DEBUG] " << msg << std::endl
@@ -11,11 +11,24 @@
 #include "GraphicsContext.h"
 #include "UIManager.h"
 #include "EventBus.h"
+#include "TaskScheduler.h"
+#include "FrameScheduler.h"
+#include "QualityGovernor.h"
+#include "RenderView.h"
 
 namespace Spectrum {
 
+    namespace {
+        // Share of the frame period renderer work may use; the rest is
+        // left for input, audio and presenting
+        constexpr float FRAME_BUDGET_SHARE = 0.75f;
+    }
+
     ControllerCore::ControllerCore(HINSTANCE hInstance)
-        : m_hInstance(hInstance) {
+        : m_hInstance(hInstance),
+        m_needsRedraw(true),
+        m_renderedSpectrumVersion(0),
+        m_isSpectrumBlending(false) {
     }
 
     ControllerCore::~ControllerCore() = default;
@@ -29,7 +42,6 @@ namespace Spectrum {
     }
 
     void ControllerCore::Run() {
-        m_timer.Reset();
         MainLoop();
     }
 
@@ -38,6 +50,17 @@ namespace Spectrum {
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
     bool ControllerCore::InitializeManagers() {
         m_eventBus = std::make_unique<EventBus>();
+        m_taskScheduler = std::make_unique<TaskScheduler>();
+
+        m_frameScheduler = std::make_unique<FrameScheduler>();
+        m_eventBus->Subscribe(InputAction::CycleFrameRate, [this]() {
+            this->CycleFrameRate();
+            });
+
+        m_qualityGovernor = std::make_unique<QualityGovernor>();
+        m_eventBus->Subscribe(InputAction::ToggleQualityGovernor, [this]() {
+            this->ToggleQualityGovernor();
+            });
 
         m_windowManager = std::make_unique<WindowManager>(m_hInstance, this, m_eventBus.get());
         if (!m_windowManager->Initialize()) {
@@ -47,11 +70,15 @@ namespace Spectrum {
         m_inputManager = std::make_unique<InputManager>();
 
         m_audioManager = std::make_unique<AudioManager>(m_eventBus.get());
+        // New samples end an idle wait instead of waiting out the poll interval
+        m_audioManager->SetDataListener([this]() { m_frameScheduler->Wake(); });
         if (!m_audioManager->Initialize()) {
             return false;
         }
 
-        m_rendererManager = std::make_unique<RendererManager>(m_eventBus.get(), m_windowManager.get());
+        m_rendererManager = std::make_unique<RendererManager>(
+            m_eventBus.get(), m_windowManager.get(), m_taskScheduler.get()
+        );
         if (!m_rendererManager->Initialize()) {
             return false;
         }
@@ -75,6 +102,9 @@ namespace Spectrum {
         LOG_INFO("  Q     - Change render quality");
         LOG_INFO("  O     - Toggle Overlay Mode");
         LOG_INFO("  S     - Switch Spectrum Scale");
+        LOG_INFO("  F     - Cycle frame rate (60/120/144/uncapped)");
+        LOG_INFO("  G     - Toggle automatic quality");
+        LOG_INFO("  V     - Open another view window");
         LOG_INFO("  UP/DOWN Arrow  - Change Amplification");
         LOG_INFO("  LEFT/RIGHT Arrow - Change FFT Window");
         LOG_INFO("  -/+ Keys       - Change Bar Count");
@@ -89,19 +119,81 @@ namespace Spectrum {
         while (m_windowManager->IsRunning()) {
             m_windowManager->ProcessMessages();
 
-            // Run loop at a fixed framerate
-            float dt = m_timer.GetElapsedSeconds();
-            if (dt >= FRAME_TIME) {
-                m_timer.Reset();
-                ProcessInput();
-                Update(dt);
-                Render();
+            // Sleeps until the next frame deadline or the next window message
+            if (!m_frameScheduler->WaitForFrame()) {
+                continue;
             }
-            else {
-                // Yield thread to avoid busy-waiting
-                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+            const float deltaTime = m_frameScheduler->GetDeltaTime();
+            ProcessInput();
+            Update(deltaTime);
+
+            // Nothing to draw, or nowhere to draw it: idle until woken
+            const bool presented = IsFrameDirty() && Render(deltaTime);
+            m_frameScheduler->SetIdle(!presented);
+        }
+    }
+
+    // Settled renderers redraw only for new spectrum data or a UI change
+    bool ControllerCore::IsFrameDirty() const {
+        if (m_needsRedraw) return true;
+        if (m_audioManager->GetSpectrumVersion() != m_renderedSpectrumVersion) return true;
+        if (m_isSpectrumBlending) return true;
+
+        for (const auto& view : m_windowManager->GetViews()) {
+            if (view->IsVisible() && !view->IsSettled()) return true;
+        }
+
+        auto* renderer = m_rendererManager->GetCurrentRenderer();
+        return renderer && !renderer->IsSettled();
+    }
+
+    void ControllerCore::RequestRedraw() {
+        m_needsRedraw = true;
+        if (m_frameScheduler) m_frameScheduler->Wake();
+    }
+
+    // Logs how the outgoing rate paced before switching to the next one
+    void ControllerCore::CycleFrameRate() {
+        static constexpr float RATES[] = { 60.0f, 120.0f, 144.0f, 0.0f };
+
+        LOG_INFO("Frame time p50 " << m_frameScheduler->GetPercentileMs(0.5f)
+            << " ms, p99 " << m_frameScheduler->GetPercentileMs(0.99f)
+            << " ms, missed deadlines " << m_frameScheduler->GetMissedDeadlines());
+
+        const float current = m_frameScheduler->GetTargetRate();
+        size_t next = 0;
+        for (size_t i = 0; i < std::size(RATES); ++i) {
+            if (RATES[i] == current) {
+                next = (i + 1) % std::size(RATES);
+                break;
             }
         }
+
+        m_frameScheduler->SetTargetRate(RATES[next]);
+        m_frameScheduler->ResetStatistics();
+
+        if (m_frameScheduler->IsUncapped()) {
+            LOG_INFO("Frame rate: uncapped");
+        }
+        else {
+            LOG_INFO("Frame rate: " << RATES[next] << " FPS");
+        }
+    }
+
+    void ControllerCore::ToggleQualityGovernor() {
+        m_qualityGovernor->SetEnabled(!m_qualityGovernor->IsEnabled());
+        LOG_INFO("Automatic quality: " << (m_qualityGovernor->IsEnabled() ? "on" : "off"));
+    }
+
+    // Uncapped runs have no deadline, so there is nothing to budget against
+    void ControllerCore::UpdateQualityGovernor(float workMs) {
+        const float rate = m_frameScheduler->GetTargetRate();
+        const float budgetMs = rate > 0.0f ? 1000.0f / rate * FRAME_BUDGET_SHARE : 0.0f;
+        if (!m_qualityGovernor->AddSample(workMs, budgetMs)) return;
+
+        LOG_INFO("Automatic quality: " << Utils::ToString(m_qualityGovernor->GetQuality())
+            << " at " << m_qualityGovernor->GetRenderScale() * 100.0f << "% resolution");
     }
 
     void ControllerCore::ProcessInput() {
@@ -111,26 +203,105 @@ namespace Spectrum {
         for (const auto& action : m_actions) {
             m_eventBus->Publish(action);
         }
+        if (!m_actions.empty()) m_needsRedraw = true;
     }
 
     void ControllerCore::Update(float deltaTime) {
         m_audioManager->Update(deltaTime);
     }
 
-    void ControllerCore::Render() {
+    bool ControllerCore::Render(float deltaTime) {
+        const bool isMainVisible = IsMainWindowVisible();
+        if (!isMainVisible && !HasVisibleView()) {
+            return false;
+        }
+
+        // Read before the data so a concurrent bump is caught next frame
+        m_renderedSpectrumVersion = m_audioManager->GetSpectrumVersion();
+        m_needsRedraw = false;
+        m_isSpectrumBlending = m_audioManager->GetInterpolatedSpectrum(
+            std::chrono::steady_clock::now(), m_spectrum
+        );
+        const SpectrumHistory* history = m_audioManager->GetSpectrumHistory();
+        m_rendererManager->SetSpectrumHistory(history);
+
+        // A new user quality restarts the governor from the top
+        m_qualityGovernor->SetCeiling(m_rendererManager->GetQuality());
+        m_rendererManager->SetQualityCap(m_qualityGovernor->GetQuality());
+
+        // The main scene is timed for the governor before any view pass is
+        // queued, so a helping wait inside it cannot pick one up. Views then
+        // draw on the workers while the main window presents; all of them
+        // only read m_spectrum until the wait below.
+        if (isMainVisible) {
+            DrawMainScene(deltaTime);
+        }
+        SubmitViewPasses(history, deltaTime);
+        if (isMainVisible) {
+            PresentMainWindow();
+        }
+        m_taskScheduler->WaitAll(m_viewTasks);
+        m_viewTasks.clear();
+
+        for (const auto& view : m_windowManager->GetViews()) {
+            if (view->RecoverLostDevice()) m_needsRedraw = true;
+        }
+        return true;
+    }
+
+    bool ControllerCore::IsMainWindowVisible() const {
         auto* graphics = m_windowManager->GetGraphics();
         if (!graphics || !m_windowManager->IsActive()) {
-            return;
+            return false;
         }
 
         // D2D can tell us if the window is occluded
         // No need to render if not visible
         if (auto* rt = graphics->GetRenderTarget()) {
             if (rt->CheckWindowState() & D2D1_WINDOW_STATE_OCCLUDED) {
-                return;
+                return false;
             }
         }
+        return true;
+    }
+
+    bool ControllerCore::HasVisibleView() const {
+        for (const auto& view : m_windowManager->GetViews()) {
+            if (view->IsVisible()) return true;
+        }
+        return false;
+    }
+
+    // Settings are applied here on the window thread, never during a pass.
+    // The governor only times the main scene, so views keep the user's
+    // quality at full resolution rather than follow a cost they add nothing to
+    void ControllerCore::SubmitViewPasses(const SpectrumHistory* history, float deltaTime) {
+        const RenderQuality quality = m_rendererManager->GetQuality();
+        const bool vsync = !m_frameScheduler->IsUncapped();
+
+        // Views with their own bar count follow the live analyzer only
+        const bool useOwnBars = !m_audioManager->IsAnimating();
+        const auto now = std::chrono::steady_clock::now();
+
+        for (const auto& view : m_windowManager->GetViews()) {
+            if (!view->IsVisible()) continue;
+
+            view->SetQuality(quality);
+            view->SetVSync(vsync);
+            view->PrepareSpectrum(useOwnBars, now, history);
 
+            RenderView* target = view.get();
+            m_viewTasks.push_back(m_taskScheduler->Submit([this, target, deltaTime]() {
+                target->Render(m_spectrum, deltaTime);
+            }));
+        }
+    }
+
+    void ControllerCore::DrawMainScene(float deltaTime) {
+        auto* graphics = m_windowManager->GetGraphics();
+
+        // Uncapped mode is for measuring, so presents must not wait for vsync
+        graphics->SetVSync(!m_frameScheduler->IsUncapped());
         graphics->BeginDraw();
 
         // Overlay mode requires a transparent background for composition
@@ -138,12 +309,23 @@ namespace Spectrum {
             ? Color::Transparent()
             : Color::FromRGB(13, 13, 26);
         graphics->Clear(clearColor);
+        graphics->SetRenderScale(m_qualityGovernor->GetRenderScale());
 
-        SpectrumData spectrum = m_audioManager->GetSpectrum();
-
+        // Timed from the renderer through the backend flush
+        const auto workStart = std::chrono::steady_clock::now();
+        m_rendererManager->BeginFrame();
+        graphics->BeginScene();
         if (m_rendererManager->GetCurrentRenderer()) {
-            m_rendererManager->GetCurrentRenderer()->Render(*graphics, spectrum);
+            m_rendererManager->GetCurrentRenderer()->Render(*graphics, m_spectrum, deltaTime);
         }
+        graphics->EndScene();
+        UpdateQualityGovernor(std::chrono::duration<float, std::milli>(
+            std::chrono::steady_clock::now() - workStart
+        ).count());
+    }
+
+    void ControllerCore::PresentMainWindow() {
+        auto* graphics = m_windowManager->GetGraphics();
 
         // UI is not visible in overlay mode
         if (auto* uiManager = m_windowManager->GetUIManager()) {
@@ -160,6 +342,7 @@ namespace Spectrum {
             if (hwnd) {
                 m_windowManager->RecreateGraphicsAndNotify(hwnd);
             }
+            m_needsRedraw = true;
         }
     }
 
@@ -176,12 +359,14 @@ namespace Spectrum {
         if (m_rendererManager) {
             m_rendererManager->OnResize(width, height);
         }
+        RequestRedraw();
     }
 
     void ControllerCore::SetPrimaryColor(const Color& color) {
         if (m_rendererManager && m_rendererManager->GetCurrentRenderer()) {
             m_rendererManager->GetCurrentRenderer()->SetPrimaryColor(color);
         }
+        RequestRedraw();
     }
 
     void ControllerCore::OnClose() {
@@ -197,6 +382,10 @@ namespace Spectrum {
     // Win32 Message Handling
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
     LRESULT ControllerCore::HandleWindowMessage(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
+        if (m_windowManager && m_windowManager->IsViewWindow(hwnd)) {
+            return HandleViewMessage(hwnd, msg, wParam, lParam);
+        }
+
         switch (msg) {
         case WM_CLOSE:
             OnClose();
@@ -224,6 +413,40 @@ namespace Spectrum {
         case WM_ERASEBKGND:
             // Prevents flickering by telling Windows we handle all drawing
             return 1;
+        case WM_PAINT:
+            // Exposed after being covered; DefWindowProc validates the region
+            RequestRedraw();
+            break;
+        case WM_KEYDOWN:
+            // Keys are polled per frame, so an idle loop must poll now
+            RequestRedraw();
+            break;
+        }
+        return DefWindowProc(hwnd, msg, wParam, lParam);
+    }
+
+    // View windows only draw; closing one leaves the application running
+    LRESULT ControllerCore::HandleViewMessage(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
+        switch (msg) {
+        case WM_CLOSE:
+            m_windowManager->CloseView(hwnd);
+            return 0;
+        case WM_DESTROY:
+            return 0;
+        case WM_SIZE:
+            if (wParam != SIZE_MINIMIZED) {
+                if (auto* view = m_windowManager->FindView(hwnd)) {
+                    view->OnResize(LOWORD(lParam), HIWORD(lParam));
+                }
+                RequestRedraw();
+            }
+            return 0;
+        case WM_ERASEBKGND:
+            return 1;
+        case WM_PAINT:
+        case WM_KEYDOWN:
+            RequestRedraw();
+            break;
         }
         return DefWindowProc(hwnd, msg, wParam, lParam);
     }
@@ -239,6 +462,7 @@ namespace Spectrum {
 
         // If UI interaction changed something visual, request a new frame
         if (needsRedraw) {
+            RequestRedraw();
             HWND hwnd = m_windowManager->GetCurrentHwnd();
             if (hwnd) {
                 InvalidateRect(hwnd, NULL, FALSE);
@@ -5,9 +5,10 @@
 #ifndef SPECTRUM_CPP_CONTROLLER_CORE_H
 #define SPECTRUM_CPP_CONTROLLER_CORE_H
 
-#include "Common.h"
+#include "Win32Common.h"
 #include "Utils.h"
 #include "EventBus.h"
+#include "TaskScheduler.h"
 #include <memory>
 #include <vector>
 
@@ -17,6 +18,9 @@ namespace Spectrum {
     class AudioManager;
     class RendererManager;
     class InputManager;
+    class FrameScheduler;
+    class QualityGovernor;
+    class SpectrumHistory;
 
     class ControllerCore {
     public:
@@ -41,6 +45,8 @@ namespace Spectrum {
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
         // Provides access to the renderer manager for other components
         RendererManager* GetRendererManager() const { return m_rendererManager.get(); }
+        // Lets view windows take bar configurations of their own
+        AudioManager* GetAudioManager() const { return m_audioManager.get(); }
 
     private:
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
@@ -51,8 +57,19 @@ namespace Spectrum {
         void MainLoop();
         void ProcessInput();
         void Update(float deltaTime);
-        void Render();
+        bool Render(float deltaTime);
+        bool IsMainWindowVisible() const;
+        bool HasVisibleView() const;
+        void SubmitViewPasses(const SpectrumHistory* history, float deltaTime);
+        void DrawMainScene(float deltaTime);
+        void PresentMainWindow();
+        bool IsFrameDirty() const;
+        void RequestRedraw();
+        void CycleFrameRate();
+        void ToggleQualityGovernor();
+        void UpdateQualityGovernor(float workMs);
         LRESULT HandleMouseMessage(UINT msg, LPARAM lParam);
+        LRESULT HandleViewMessage(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
 
     private:
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
@@ -60,14 +77,29 @@ namespace Spectrum {
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
         HINSTANCE m_hInstance;
 
+        // Declared first so worker threads outlive every manager using them,
+        // and the frame scheduler outlives the capture threads waking it
+        std::unique_ptr<TaskScheduler> m_taskScheduler;
+        std::unique_ptr<FrameScheduler> m_frameScheduler;
+        std::unique_ptr<QualityGovernor> m_qualityGovernor;
         std::unique_ptr<WindowManager> m_windowManager;
         std::unique_ptr<AudioManager> m_audioManager;
         std::unique_ptr<RendererManager> m_rendererManager;
         std::unique_ptr<InputManager> m_inputManager;
         std::unique_ptr<EventBus> m_eventBus;
 
-        Utils::Timer m_timer;
         std::vector<InputAction> m_actions;
+
+        // A frame is skipped when nothing it would draw has changed
+        bool m_needsRedraw;
+        uint64_t m_renderedSpectrumVersion;
+
+        // Reused every frame; still blending means the next frame differs
+        SpectrumData m_spectrum;
+        bool m_isSpectrumBlending;
+
+        // One pass per visible view window, waited on within the frame
+        std::vector<TaskScheduler::TaskHandle> m_viewTasks;
     };
 
 }
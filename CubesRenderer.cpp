@@ -7,8 +7,23 @@
 
 namespace Spectrum {
 
+    namespace {
+        constexpr float SHADOW_OFFSET = 3.0f;
+        constexpr Color SHADOW_COLOR = { 0.0f, 0.0f, 0.0f, 0.2f };
+
+        // Maps the unit square onto the parallelogram spanned by the two
+        // edges leaving origin
+        Transform2D MapUnitSquare(const Point& origin, const Point& u, const Point& v) {
+            return { u.x, u.y, v.x, v.y, origin.x, origin.y };
+        }
+    }
+
     CubesRenderer::CubesRenderer() {
         m_primaryColor = Color::FromRGB(200, 100, 255);
+        m_unitSquare.SetPoints(
+            { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } },
+            true
+        );
         UpdateSettings();
     }
 
@@ -30,7 +45,7 @@ namespace Spectrum {
     }
 
     void CubesRenderer::DoRender(
-        GraphicsContext& context,
+        RenderCommandList& commands,
         const SpectrumData& spectrum
     ) {
         const size_t n = spectrum.size();
@@ -38,8 +53,7 @@ namespace Spectrum {
         const auto bl = RenderUtils::ComputeBarLayout(n, spacing, m_width);
         if (bl.barWidth <= 0.0f) return;
 
-        std::vector<CubeData> cubes;
-        cubes.reserve(n);
+        ArenaVector<CubeData> cubes(GetFrameArena(), n);
 
         for (size_t i = 0; i < n; ++i) {
             const float mag = spectrum[i];
@@ -56,40 +70,50 @@ namespace Spectrum {
             cd.topHeight = bl.barWidth * m_settings.topHeightRatio;
             cd.sideWidth = bl.barWidth * m_settings.perspective;
             cd.magnitude = mag;
-            cubes.push_back(cd);
+            cubes.PushBack(cd);
         }
 
+        // Shadows only fall on the background, so they all go first
+        if (m_settings.useShadow) {
+            for (const auto& cube : cubes) {
+                Rect shadow = cube.frontFace;
+                shadow.x += SHADOW_OFFSET;
+                shadow.y += SHADOW_OFFSET;
+                commands.DrawRectangle(shadow, SHADOW_COLOR);
+            }
+        }
+
+        // Every face is the unit square under a per-face transform, kept
+        // in cube order since neighbouring cubes overlap
+        ArenaVector<GeometryInstance> faces(GetFrameArena(), cubes.GetSize() * 3);
         for (const auto& cube : cubes) {
+            const Rect& f = cube.frontFace;
+            const Point depth = { cube.sideWidth, -cube.topHeight };
+
             Color front = m_primaryColor;
             front.a = 0.6f + 0.4f * cube.magnitude;
 
-            if (m_settings.useShadow) {
-                context.DrawRectangle(
-                    { cube.frontFace.x + 3, cube.frontFace.y + 3, cube.frontFace.width, cube.frontFace.height },
-                    { 0, 0, 0, 0.2f }
-                );
-            }
-
             if (m_settings.useSideFace) {
-                Color side = Utils::AdjustBrightness(front, m_settings.sideFaceBrightness);
-                Point p1 = { cube.frontFace.GetRight(), cube.frontFace.y };
-                Point p2 = { p1.x + cube.sideWidth, p1.y - cube.topHeight };
-                Point p3 = { p2.x, p2.y + cube.frontFace.height };
-                Point p4 = { p1.x, cube.frontFace.GetBottom() };
-                context.DrawPolygon({ p1, p2, p3, p4 }, side);
+                faces.PushBack({
+                    MapUnitSquare({ f.GetRight(), f.y }, depth, { 0.0f, f.height }),
+                    Utils::AdjustBrightness(front, m_settings.sideFaceBrightness)
+                });
             }
 
             if (m_settings.useTopFace) {
-                Color top = Utils::AdjustBrightness(front, 1.2f);
-                Point p1 = { cube.frontFace.x, cube.frontFace.y };
-                Point p2 = { cube.frontFace.GetRight(), cube.frontFace.y };
-                Point p3 = { p2.x + cube.sideWidth, p2.y - cube.topHeight };
-                Point p4 = { p1.x + cube.sideWidth, p1.y - cube.topHeight };
-                context.DrawPolygon({ p1, p2, p3, p4 }, top);
+                faces.PushBack({
+                    MapUnitSquare({ f.x, f.y }, { f.width, 0.0f }, depth),
+                    Utils::AdjustBrightness(front, 1.2f)
+                });
             }
 
-            context.DrawRectangle(cube.frontFace, front);
+            faces.PushBack({
+                MapUnitSquare({ f.x, f.y }, { f.width, 0.0f }, { 0.0f, f.height }),
+                front
+            });
         }
+
+        commands.DrawGeometryInstances(m_unitSquare, faces.GetData(), faces.GetSize());
     }
 
 }
\ No newline at end of file
@@ -16,10 +16,11 @@ namespace Spectrum {
 
         RenderStyle GetStyle() const override { return RenderStyle::Cubes; }
         std::string_view GetName() const override { return "Cubes"; }
+        bool IsSettled() const override { return true; }
 
     protected:
         void UpdateSettings() override;
-        void DoRender(GraphicsContext& context,
+        void DoRender(RenderCommandList& commands,
             const SpectrumData& spectrum) override;
 
     private:
@@ -40,6 +41,7 @@ namespace Spectrum {
         };
 
         Settings m_settings;
+        RetainedGeometry m_unitSquare;
     };
 
 } // namespace Spectrum
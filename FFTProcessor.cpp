@@ -25,9 +25,26 @@ namespace Spectrum {
             LOG_ERROR("FFT size must be a power of two. Got: " << m_fftSize);
         }
 
-        m_fftBuffer.resize(m_fftSize);
-        m_magnitudes.resize(m_fftSize / 2 + 1);
-        m_phases.resize(m_fftSize / 2 + 1);
+        AllocateBuffers();
+    }
+
+    void FFTProcessor::SetFFTSize(size_t fftSize) {
+        if (fftSize == m_fftSize) return;
+
+        if (!IsPowerOfTwo(fftSize)) {
+            LOG_ERROR("FFT size must be a power of two. Got: " << fftSize);
+            return;
+        }
+
+        m_fftSize = fftSize;
+        m_logSize = IntegerLog2(fftSize);
+        AllocateBuffers();
+    }
+
+    void FFTProcessor::AllocateBuffers() {
+        m_fftBuffer.assign(m_fftSize, std::complex<float>(0.0f, 0.0f));
+        m_magnitudes.assign(m_fftSize / 2 + 1, 0.0f);
+        m_phases.assign(m_fftSize / 2 + 1, 0.0f);
         m_window.resize(m_fftSize);
 
         InitializeTwiddleFactors();
@@ -19,6 +19,9 @@ namespace Spectrum {
         void Process(const AudioBuffer& input);
         void SetWindowType(FFTWindowType type);
 
+        // Reallocates all buffers; call on configuration changes only
+        void SetFFTSize(size_t fftSize);
+
         // Getters
         const SpectrumData& GetMagnitudes() const noexcept { return m_magnitudes; }
         const SpectrumData& GetPhases() const noexcept { return m_phases; }
@@ -28,6 +31,7 @@ namespace Spectrum {
         // Static window function generators
         static std::vector<float> GenerateWindow(FFTWindowType type, size_t size);
         static float ApplyWindowFunction(FFTWindowType type, size_t index, size_t size);
+        static bool IsPowerOfTwo(size_t n) noexcept;
 
     private:
         // Window and input preparation
@@ -51,7 +55,7 @@ namespace Spectrum {
         // Helpers
         size_t ReverseBits(size_t num, size_t bitCount) const noexcept;
         void InitializeTwiddleFactors();
-        static bool IsPowerOfTwo(size_t n) noexcept;
+        void AllocateBuffers();
 
     private:
         // FFT parameters
@@ -2,14 +2,93 @@
 // FireRenderer.cpp: Implementation of the FireRenderer class.
 // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
 #include "FireRenderer.h"
+#include "TaskScheduler.h"
 #include "Utils.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SPECTRUM_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
 namespace Spectrum {
 
-    FireRenderer::FireRenderer()
-        : m_gridWidth(0), m_gridHeight(0) {
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Constants
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    namespace {
+        // Cells dimmer than this stay fully transparent
+        constexpr float MIN_VISIBLE_INTENSITY = 0.01f;
+
+        // Bands smaller than this cost more to dispatch than to step
+        constexpr int MIN_ROWS_PER_BAND = 16;
+
+        inline uint8_t ToByte(float value) {
+            return static_cast<uint8_t>(Utils::Saturate(value) * 255.0f + 0.5f);
+        }
+
+        // out[x] = pad[x + 1] * center + (pad[x] + pad[x + 2]) * edge
+        void BlurRow(
+            const float* pad,
+            float* out,
+            int count,
+            float center,
+            float edge
+        ) {
+            int x = 0;
+#ifdef SPECTRUM_USE_SSE2
+            const __m128 c = _mm_set1_ps(center);
+            const __m128 e = _mm_set1_ps(edge);
+            for (; x + 4 <= count; x += 4) {
+                const __m128 l = _mm_loadu_ps(pad + x);
+                const __m128 m = _mm_loadu_ps(pad + x + 1);
+                const __m128 r = _mm_loadu_ps(pad + x + 2);
+                _mm_storeu_ps(
+                    out + x,
+                    _mm_add_ps(_mm_mul_ps(m, c), _mm_mul_ps(_mm_add_ps(l, r), e))
+                );
+            }
+#endif
+            for (; x < count; ++x) {
+                out[x] = pad[x + 1] * center + (pad[x] + pad[x + 2]) * edge;
+            }
+        }
+
+        // Rounds saturated values to 0..255
+        void QuantizeRow(const float* src, uint8_t* dst, int count) {
+            int x = 0;
+#ifdef SPECTRUM_USE_SSE2
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 one = _mm_set1_ps(1.0f);
+            const __m128 scale = _mm_set1_ps(255.0f);
+            const __m128 half = _mm_set1_ps(0.5f);
+            for (; x + 8 <= count; x += 8) {
+                const __m128 a = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + x), zero), one);
+                const __m128 b = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + x + 4), zero), one);
+                const __m128i ia = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(a, scale), half));
+                const __m128i ib = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(b, scale), half));
+                const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(ia, ib), ia);
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + x), packed);
+            }
+#endif
+            for (; x < count; ++x) {
+                dst[x] = ToByte(src[x]);
+            }
+        }
+    }
+
+    FireRenderer::FireRenderer(TaskScheduler* scheduler)
+        : m_scheduler(scheduler),
+        m_settings{},
+        m_gridWidth(0),
+        m_gridHeight(0),
+        m_hasWind(false),
+        m_bandCount(1),
+        m_isSettled(false) {
+        // Decay and rise are tuned per simulation step
+        SetFixedTimestep(FRAME_TIME);
         UpdateSettings();
         CreateFirePalette();
+        CreatePaletteLut();
     }
 
     void FireRenderer::OnActivate(int width, int height) {
@@ -18,6 +97,8 @@ namespace Spectrum {
     }
 
     void FireRenderer::UpdateSettings() {
+        const float previousPixelSize = m_settings.pixelSize;
+
         switch (m_quality) {
         case RenderQuality::Low:
             m_settings = { false, false, 12.0f, 0.93f, 1.2f };
@@ -32,6 +113,11 @@ namespace Spectrum {
             m_settings = { true, true, 8.0f, 0.95f, 1.5f };
             break;
         }
+
+        // The grid is sized in cells of pixelSize, so a new size rebuilds it
+        if (m_settings.pixelSize != previousPixelSize) {
+            InitializeGrid();
+        }
     }
 
     void FireRenderer::CreateFirePalette() {
@@ -47,6 +133,19 @@ namespace Spectrum {
         };
     }
 
+    // One entry per texture level, so texels index the table directly
+    void FireRenderer::CreatePaletteLut() {
+        static_assert(PaletteLut::SIZE == 256, "Fire texels are 8-bit");
+
+        m_paletteLut.Generate([this](float intensity) {
+            if (intensity < MIN_VISIBLE_INTENSITY) return Color::Transparent();
+
+            Color c = GetColorFromPalette(intensity);
+            c.a = Utils::SmoothStep(0.0f, 0.8f, intensity);
+            return c;
+        });
+    }
+
     Color FireRenderer::GetColorFromPalette(float intensity) const {
         if (intensity <= 0.0f) return m_firePalette.front();
         if (intensity >= 1.0f) return m_firePalette.back();
@@ -60,92 +159,174 @@ namespace Spectrum {
     }
 
     void FireRenderer::InitializeGrid() {
-        if (m_width <= 0 || m_height <= 0) {
+        m_gridWidth = m_gridHeight = 0;
+        if (m_width > 0 && m_height > 0) {
+            m_gridWidth = static_cast<int>(m_width / m_settings.pixelSize);
+            m_gridHeight = static_cast<int>(m_height / m_settings.pixelSize);
+        }
+
+        if (m_gridWidth <= 0 || m_gridHeight <= 0) {
             m_gridWidth = m_gridHeight = 0;
             m_fireGrid.clear();
+            m_nextGrid.clear();
+            m_intensity.clear();
+            m_image.Resize(0, 0);
             return;
         }
 
-        m_gridWidth = static_cast<int>(m_width / m_settings.pixelSize);
-        m_gridHeight = static_cast<int>(m_height / m_settings.pixelSize);
+        const size_t cells = static_cast<size_t>(m_gridWidth) * m_gridHeight;
+        m_fireGrid.assign(cells, 0.0f);
+        m_nextGrid.assign(cells, 0.0f);
+        m_intensity.assign(cells, 0);
+        m_sourceColumns.resize(static_cast<size_t>(m_gridWidth));
+        m_image.Resize(m_gridWidth, m_gridHeight);
 
-        if (m_gridWidth > 0 && m_gridHeight > 0) {
-            m_fireGrid.assign(
-                static_cast<size_t>(m_gridWidth * m_gridHeight),
-                0.0f
-            );
-        }
-        else {
-            m_fireGrid.clear();
-        }
+        const size_t workers = m_scheduler ? m_scheduler->GetWorkerCount() : 1;
+        const size_t maxBands = static_cast<size_t>(
+            std::max(1, (m_gridHeight - 1) / MIN_ROWS_PER_BAND)
+        );
+        m_bandCount = std::clamp<size_t>(workers, 1, maxBands);
+        m_bandScratch.resize(m_bandCount * (2 * static_cast<size_t>(m_gridWidth) + 2));
     }
 
     void FireRenderer::UpdateAnimation(const SpectrumData& spectrum, float deltaTime) {
         (void)deltaTime;
         if (m_gridWidth == 0 || m_gridHeight == 0) return;
 
-        for (float& v : m_fireGrid) {
-            v *= m_settings.decay;
+        InjectHeat(spectrum);
+        UpdateSourceColumns();
+
+        // Every row above the bottom reads only the row below it in the
+        // previous state, so bands are independent
+        const int rows = m_gridHeight - 1;
+        const size_t scratchStride = 2 * static_cast<size_t>(m_gridWidth) + 2;
+        const auto stepBand = [&](size_t band) {
+            const int first = static_cast<int>(band * rows / m_bandCount);
+            const int last = static_cast<int>((band + 1) * rows / m_bandCount);
+            StepRows(first, last, m_bandScratch.data() + band * scratchStride);
+            WriteTexels(first, last);
+        };
+
+        if (m_scheduler && m_bandCount > 1) {
+            m_scheduler->ParallelFor(m_bandCount, stepBand);
+        }
+        else {
+            for (size_t band = 0; band < m_bandCount; ++band) stepBand(band);
+        }
+        WriteTexels(rows, m_gridHeight);
+
+        m_fireGrid.swap(m_nextGrid);
+        m_image.MarkDirty();
+
+        // Heat only decays without new input, so a dark texture stays dark
+        m_isSettled = std::all_of(
+            m_intensity.begin(), m_intensity.end(),
+            [](uint8_t texel) { return texel == 0; }
+        );
+    }
+
+    // The bottom row decays in place and takes the new heat
+    void FireRenderer::InjectHeat(const SpectrumData& spectrum) {
+        const size_t bottom = static_cast<size_t>(m_gridHeight - 1) * m_gridWidth;
+        const float* src = m_fireGrid.data() + bottom;
+        float* dst = m_nextGrid.data() + bottom;
+
+        for (int x = 0; x < m_gridWidth; ++x) {
+            dst[x] = src[x] * m_settings.decay;
         }
 
-        const int bottomY = m_gridHeight - 1;
         for (size_t i = 0; i < spectrum.size(); ++i) {
             const int x = static_cast<int>(
                 (static_cast<float>(i) / std::max<size_t>(1, spectrum.size() - 1)) *
                 (m_gridWidth - 1)
                 );
-            const int idx = bottomY * m_gridWidth + Utils::Clamp(x, 0, m_gridWidth - 1);
-            m_fireGrid[idx] = std::max(
-                m_fireGrid[idx],
-                spectrum[i] * m_settings.heatMultiplier
-            );
+            const int idx = Utils::Clamp(x, 0, m_gridWidth - 1);
+            dst[idx] = std::max(dst[idx], spectrum[i] * m_settings.heatMultiplier);
         }
+    }
+
+    // Wind depends only on the column and time, so one table serves all rows
+    void FireRenderer::UpdateSourceColumns() {
+        m_hasWind = false;
+        if (!m_settings.useWind) return;
+
+        for (int x = 0; x < m_gridWidth; ++x) {
+            const int windOffset = static_cast<int>(std::sin(m_time * 2.0f + x * 0.5f) * 2.0f);
+            const int srcX = Utils::Clamp(x - windOffset, 0, m_gridWidth - 1);
+            m_sourceColumns[x] = srcX;
+            m_hasWind |= srcX != x;
+        }
+    }
 
-        for (int y = 0; y < m_gridHeight - 1; ++y) {
-            for (int x = 0; x < m_gridWidth; ++x) {
-                int windOffset = 0;
-                if (m_settings.useWind) {
-                    windOffset = static_cast<int>(std::sin(m_time * 2.0f + x * 0.5f) * 2.0f);
-                }
-                const int srcX = Utils::Clamp(x - windOffset, 0, m_gridWidth - 1);
-                const int srcY = y + 1;
-
-                float val = m_fireGrid[srcY * m_gridWidth + srcX];
-                if (m_settings.useSmoothing) {
-                    const float c = val;
-                    const float l = (srcX > 0) ? m_fireGrid[srcY * m_gridWidth + srcX - 1] : c;
-                    const float r = (srcX < m_gridWidth - 1) ? m_fireGrid[srcY * m_gridWidth + srcX + 1] : c;
-                    val = c * 0.5f + (l + r) * 0.25f;
-                }
-
-                m_fireGrid[y * m_gridWidth + x] = val;
+    // Row y takes the blurred row y + 1, shifted by the wind table. The
+    // bottom row was already decayed by InjectHeat; the others decay here.
+    void FireRenderer::StepRows(int firstRow, int lastRow, float* scratch) {
+        const int width = m_gridWidth;
+        const int bottomY = m_gridHeight - 1;
+        float* pad = scratch;
+        float* blurred = scratch + width + 2;
+
+        for (int y = firstRow; y < lastRow; ++y) {
+            const int srcY = y + 1;
+            const bool fromBottom = srcY == bottomY;
+            const float* src = (fromBottom ? m_nextGrid.data() : m_fireGrid.data())
+                + static_cast<size_t>(srcY) * width;
+            const float scale = fromBottom ? 1.0f : m_settings.decay;
+            float* dst = m_nextGrid.data() + static_cast<size_t>(y) * width;
+
+            // Edge replication makes the blur branch-free
+            std::copy(src, src + width, pad + 1);
+            pad[0] = src[0];
+            pad[width + 1] = src[width - 1];
+
+            const float center = m_settings.useSmoothing ? 0.5f * scale : scale;
+            const float edge = m_settings.useSmoothing ? 0.25f * scale : 0.0f;
+
+            if (!m_hasWind) {
+                BlurRow(pad, dst, width, center, edge);
+                continue;
+            }
+
+            BlurRow(pad, blurred, width, center, edge);
+            for (int x = 0; x < width; ++x) {
+                dst[x] = blurred[m_sourceColumns[x]];
             }
         }
     }
 
+    void FireRenderer::WriteTexels(int firstRow, int lastRow) {
+        const size_t begin = static_cast<size_t>(firstRow) * m_gridWidth;
+        const size_t end = static_cast<size_t>(lastRow) * m_gridWidth;
+        if (begin >= end) return;
+
+        QuantizeRow(
+            m_nextGrid.data() + begin,
+            m_intensity.data() + begin,
+            static_cast<int>(end - begin)
+        );
+
+        const uint32_t* lut = m_paletteLut.GetPixels();
+        uint32_t* pixels = m_image.GetPixels();
+        for (size_t i = begin; i < end; ++i) {
+            pixels[i] = lut[m_intensity[i]];
+        }
+    }
+
     void FireRenderer::DoRender(
-        GraphicsContext& context,
+        RenderCommandList& commands,
         const SpectrumData& /*spectrum*/
     ) {
-        if (m_gridWidth == 0 || m_gridHeight == 0) return;
+        if (m_gridWidth == 0 || m_gridHeight == 0 || m_image.IsEmpty()) return;
 
-        for (int y = 0; y < m_gridHeight; ++y) {
-            for (int x = 0; x < m_gridWidth; ++x) {
-                const float intensity = m_fireGrid[y * m_gridWidth + x];
-                if (intensity < 0.01f) continue;
-
-                Color c = GetColorFromPalette(Utils::Clamp(intensity, 0.0f, 1.0f));
-                c.a = Utils::SmoothStep(0.0f, 0.8f, intensity);
-
-                const Rect pixelRect = {
-                    x * m_settings.pixelSize,
-                    y * m_settings.pixelSize,
-                    m_settings.pixelSize,
-                    m_settings.pixelSize
-                };
-                context.DrawRectangle(pixelRect, c);
-            }
-        }
+        commands.DrawImage(
+            m_image,
+            Rect(
+                0.0f,
+                0.0f,
+                m_gridWidth * m_settings.pixelSize,
+                m_gridHeight * m_settings.pixelSize
+            )
+        );
     }
 
-}
\ No newline at end of file
+}
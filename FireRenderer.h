@@ -6,12 +6,18 @@
 #define SPECTRUM_CPP_FIRE_RENDERER_H
 
 #include "BaseRenderer.h"
+#include "PaletteLut.h"
 
 namespace Spectrum {
 
+    class TaskScheduler;
+
+    // The simulation runs on a float grid stepped a row band at a time;
+    // the result is quantized into an 8-bit intensity texture, mapped
+    // through a palette table and drawn as one image.
     class FireRenderer final : public BaseRenderer {
     public:
-        FireRenderer();
+        explicit FireRenderer(TaskScheduler* scheduler = nullptr);
         ~FireRenderer() override = default;
 
         RenderStyle GetStyle() const override {
@@ -23,6 +29,9 @@ namespace Spectrum {
         bool SupportsPrimaryColor() const override {
             return false;
         }
+        bool IsSettled() const override {
+            return m_isSettled;
+        }
         void SetPrimaryColor(const Color& color) override {
             (void)color;
         }
@@ -32,14 +41,21 @@ namespace Spectrum {
         void UpdateSettings() override;
         void UpdateAnimation(const SpectrumData& spectrum,
             float deltaTime) override;
-        void DoRender(GraphicsContext& context,
+        void DoRender(RenderCommandList& commands,
             const SpectrumData& spectrum) override;
 
     private:
         void InitializeGrid();
         void CreateFirePalette();
+        void CreatePaletteLut();
         Color GetColorFromPalette(float intensity) const;
 
+        // Simulation kernels, each touching a contiguous range of rows
+        void InjectHeat(const SpectrumData& spectrum);
+        void UpdateSourceColumns();
+        void StepRows(int firstRow, int lastRow, float* scratch);
+        void WriteTexels(int firstRow, int lastRow);
+
         struct Settings {
             bool useSmoothing;
             bool useWind;
@@ -48,10 +64,27 @@ namespace Spectrum {
             float heatMultiplier;
         };
 
+        TaskScheduler* m_scheduler;
         Settings m_settings;
         int m_gridWidth;
         int m_gridHeight;
+
+        // Current and next simulation state, swapped every step
         std::vector<float> m_fireGrid;
+        std::vector<float> m_nextGrid;
+
+        // Source column per destination column for this step's wind
+        std::vector<int> m_sourceColumns;
+        bool m_hasWind;
+
+        // Padded source row plus blurred row for each band
+        std::vector<float> m_bandScratch;
+        size_t m_bandCount;
+
+        std::vector<uint8_t> m_intensity;
+        PaletteLut m_paletteLut;
+        RetainedImage m_image;
+        bool m_isSettled;
         ColorPalette m_firePalette;
     };
 
@@ -0,0 +1,71 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// FrameArena.cpp: Implementation of the FrameArena class.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#include "FrameArena.h"
+
+namespace Spectrum {
+
+    FrameArena::FrameArena(size_t initialCapacity)
+        : m_blockIndex(0),
+        m_offset(0),
+        m_usedBytes(0),
+        m_capacity(0),
+        m_peakBytes(0),
+        m_blockAllocations(0) {
+        AddBlock(std::max<size_t>(initialCapacity, 1));
+    }
+
+    void FrameArena::Reset() {
+        m_peakBytes = std::max(m_peakBytes, GetUsedBytes());
+
+        // The frame spilled into extra blocks; merge them so the next
+        // frame of the same size fits in one
+        if (m_blocks.size() > 1) {
+            const size_t total = m_capacity;
+            m_blocks.clear();
+            m_capacity = 0;
+            AddBlock(total);
+        }
+
+        m_blockIndex = 0;
+        m_offset = 0;
+        m_usedBytes = 0;
+    }
+
+    void* FrameArena::Allocate(size_t bytes, size_t alignment) {
+        if (bytes == 0) bytes = 1;
+
+        auto tryAllocate = [&]() -> void* {
+            Block& block = m_blocks[m_blockIndex];
+            const uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+            const uintptr_t aligned =
+                (base + m_offset + alignment - 1) & ~(uintptr_t(alignment) - 1);
+            const size_t end = static_cast<size_t>(aligned - base) + bytes;
+            if (end > block.size) return nullptr;
+
+            m_offset = end;
+            return reinterpret_cast<void*>(aligned);
+        };
+
+        if (void* result = tryAllocate()) {
+            return result;
+        }
+
+        // Grow geometrically so a burst settles after a few frames
+        m_usedBytes += m_offset;
+        AddBlock(std::max(bytes + alignment, m_capacity));
+        m_blockIndex = m_blocks.size() - 1;
+        m_offset = 0;
+        return tryAllocate();
+    }
+
+    void FrameArena::AddBlock(size_t minBytes) {
+        Block block;
+        block.data = std::make_unique<uint8_t[]>(minBytes);
+        block.size = minBytes;
+        m_blocks.push_back(std::move(block));
+        m_capacity += minBytes;
+        ++m_blockAllocations;
+    }
+
+}
@@ -0,0 +1,130 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// FrameArena.h: Bump allocator for scratch data that lives for one frame.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#ifndef SPECTRUM_CPP_FRAME_ARENA_H
+#define SPECTRUM_CPP_FRAME_ARENA_H
+
+#include "Common.h"
+#include <cstring>
+#include <type_traits>
+
+namespace Spectrum {
+
+    // Hands out memory by bumping an offset; nothing is freed on its own.
+    // Reset() rewinds everything at once. A frame that overflowed the
+    // first block leaves one block of the combined size behind, so after
+    // warming up a steady frame never reaches the heap. No destructors
+    // run, hence only trivially destructible types may live here.
+    class FrameArena {
+    public:
+        static constexpr size_t DEFAULT_CAPACITY = 64 * 1024;
+
+        explicit FrameArena(size_t initialCapacity = DEFAULT_CAPACITY);
+        ~FrameArena() = default;
+
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        // Invalidates every pointer handed out since the previous Reset()
+        void Reset();
+
+        void* Allocate(size_t bytes, size_t alignment);
+
+        // Uninitialized storage for count objects
+        template <typename T>
+        T* AllocateArray(size_t count) {
+            static_assert(
+                std::is_trivially_destructible_v<T>,
+                "FrameArena never runs destructors"
+            );
+            return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+        }
+
+        // Getters
+        size_t GetCapacity() const noexcept { return m_capacity; }
+        size_t GetUsedBytes() const noexcept { return m_usedBytes + m_offset; }
+        size_t GetPeakBytes() const noexcept { return m_peakBytes; }
+        // Heap blocks obtained so far; stops growing once the arena fits a frame
+        size_t GetBlockAllocationCount() const noexcept { return m_blockAllocations; }
+
+    private:
+        struct Block {
+            std::unique_ptr<uint8_t[]> data;
+            size_t size = 0;
+        };
+
+        void AddBlock(size_t minBytes);
+
+        std::vector<Block> m_blocks;
+        size_t m_blockIndex;
+        size_t m_offset;
+        size_t m_usedBytes;     // Bytes in blocks before m_blockIndex
+        size_t m_capacity;
+        size_t m_peakBytes;
+        size_t m_blockAllocations;
+    };
+
+    // Growable array backed by a FrameArena. Growing copies into a new
+    // allocation and abandons the old one until the arena is reset, so
+    // reserve up front when the size is known.
+    template <typename T>
+    class ArenaVector {
+        static_assert(
+            std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>,
+            "ArenaVector moves elements with memcpy and never destroys them"
+        );
+
+    public:
+        explicit ArenaVector(FrameArena& arena, size_t capacity = 0)
+            : m_arena(&arena), m_data(nullptr), m_size(0), m_capacity(0) {
+            Reserve(capacity);
+        }
+
+        void Reserve(size_t capacity) {
+            if (capacity <= m_capacity) return;
+            T* grown = m_arena->AllocateArray<T>(capacity);
+            if (m_size > 0) {
+                std::memcpy(grown, m_data, m_size * sizeof(T));
+            }
+            m_data = grown;
+            m_capacity = capacity;
+        }
+
+        void PushBack(const T& value) {
+            if (m_size == m_capacity) Grow();
+            m_data[m_size++] = value;
+        }
+
+        template <typename... Args>
+        T& EmplaceBack(Args&&... args) {
+            if (m_size == m_capacity) Grow();
+            return *new (m_data + m_size++) T{ std::forward<Args>(args)... };
+        }
+
+        void Clear() noexcept { m_size = 0; }
+
+        size_t GetSize() const noexcept { return m_size; }
+        bool IsEmpty() const noexcept { return m_size == 0; }
+        T* GetData() noexcept { return m_data; }
+        const T* GetData() const noexcept { return m_data; }
+
+        T& operator[](size_t index) noexcept { return m_data[index]; }
+        const T& operator[](size_t index) const noexcept { return m_data[index]; }
+
+        T* begin() noexcept { return m_data; }
+        T* end() noexcept { return m_data + m_size; }
+        const T* begin() const noexcept { return m_data; }
+        const T* end() const noexcept { return m_data + m_size; }
+
+    private:
+        void Grow() { Reserve(m_capacity > 0 ? m_capacity * 2 : 16); }
+
+        FrameArena* m_arena;
+        T* m_data;
+        size_t m_size;
+        size_t m_capacity;
+    };
+
+}
+
+#endif
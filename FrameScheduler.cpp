@@ -0,0 +1,247 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// FrameScheduler.cpp: Implementation of the FrameScheduler class.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#include "FrameScheduler.h"
+#include "Types.h"
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#endif
+
+namespace Spectrum {
+
+    namespace {
+        using Clock = std::chrono::steady_clock;
+
+        // The timer wakes this early; the rest of the wait yields in a loop.
+        // Standard timers only promise the system tick, hence the wider margin.
+        constexpr auto HIGH_RESOLUTION_MARGIN = std::chrono::microseconds(500);
+        constexpr auto COARSE_MARGIN = std::chrono::milliseconds(2);
+
+        // How often an idle loop still runs a frame without being woken
+        constexpr auto IDLE_FRAME_INTERVAL = std::chrono::milliseconds(100);
+
+        class SystemFrameClock final : public IFrameClock {
+        public:
+            SystemFrameClock() {
+#ifdef _WIN32
+                m_timer = CreateWaitableTimerExW(
+                    nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS
+                );
+                m_highResolution = m_timer != nullptr;
+                if (!m_timer) {
+                    m_timer = CreateWaitableTimerW(nullptr, TRUE, nullptr);
+                }
+                m_wakeEvent = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+#endif
+            }
+
+            ~SystemFrameClock() override {
+#ifdef _WIN32
+                if (m_timer) CloseHandle(m_timer);
+                if (m_wakeEvent) CloseHandle(m_wakeEvent);
+#endif
+            }
+
+            TimePoint Now() override { return Clock::now(); }
+
+            void SleepUntil(TimePoint deadline) override {
+                const auto margin = m_highResolution ? Clock::duration(HIGH_RESOLUTION_MARGIN)
+                    : Clock::duration(COARSE_MARGIN);
+                const TimePoint wake = deadline - margin;
+
+                if (Clock::now() < wake && !WaitForTimer(wake)) {
+                    return;
+                }
+                while (Clock::now() < deadline) {
+                    std::this_thread::yield();
+                }
+            }
+
+            void Wake() override {
+#ifdef _WIN32
+                if (m_timer && m_wakeEvent) {
+                    SetEvent(m_wakeEvent);
+                    return;
+                }
+#endif
+                {
+                    std::lock_guard<std::mutex> lock(m_wakeMutex);
+                    m_wakePending = true;
+                }
+                m_wakeCondition.notify_one();
+            }
+
+        private:
+            // False when woken early by input or Wake(), so the caller
+            // handles that first
+            bool WaitForTimer(TimePoint wake) {
+#ifdef _WIN32
+                if (m_timer && m_wakeEvent) {
+                    const auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        wake - Clock::now()
+                    );
+                    LARGE_INTEGER due{};
+                    due.QuadPart = -static_cast<LONGLONG>(remaining.count() / 100); // Relative, 100 ns
+                    if (due.QuadPart < 0
+                        && SetWaitableTimer(m_timer, &due, 0, nullptr, nullptr, FALSE)) {
+                        const HANDLE handles[] = { m_timer, m_wakeEvent };
+                        const DWORD result = MsgWaitForMultipleObjects(
+                            2, handles, FALSE, INFINITE, QS_ALLINPUT
+                        );
+                        if (result != WAIT_OBJECT_0) {
+                            CancelWaitableTimer(m_timer);
+                            return false;
+                        }
+                        return true;
+                    }
+                }
+#endif
+                std::unique_lock<std::mutex> lock(m_wakeMutex);
+                const bool woken = m_wakeCondition.wait_until(
+                    lock, wake, [this] { return m_wakePending; }
+                );
+                m_wakePending = false;
+                return !woken;
+            }
+
+#ifdef _WIN32
+            HANDLE m_timer = nullptr;
+            HANDLE m_wakeEvent = nullptr;
+#endif
+            bool m_highResolution = false;
+
+            std::mutex m_wakeMutex;
+            std::condition_variable m_wakeCondition;
+            bool m_wakePending = false;
+        };
+    }
+
+    std::unique_ptr<IFrameClock> CreateSystemFrameClock() {
+        return std::make_unique<SystemFrameClock>();
+    }
+
+    FrameScheduler::FrameScheduler(std::unique_ptr<IFrameClock> clock)
+        : m_clock(clock ? std::move(clock) : CreateSystemFrameClock()),
+        m_targetRate(0.0f),
+        m_period(Duration::zero()),
+        m_hasStarted(false),
+        m_deltaTime(0.0f),
+        m_idle(false),
+        m_wakeRequested(false),
+        m_frameCount(0),
+        m_missedDeadlines(0),
+        m_sampleCount(0),
+        m_histogram{} {
+        SetTargetRate(DEFAULT_FPS);
+    }
+
+    void FrameScheduler::SetTargetRate(float framesPerSecond) {
+        m_targetRate = framesPerSecond > 0.0f ? framesPerSecond : 0.0f;
+        m_period = IsUncapped()
+            ? Duration::zero()
+            : std::chrono::duration_cast<Duration>(
+                std::chrono::duration<double>(1.0 / m_targetRate)
+            );
+
+        // The new period starts from the last frame, not the old grid
+        if (m_hasStarted) m_nextDeadline = m_lastFrameStart + m_period;
+    }
+
+    bool FrameScheduler::WaitForFrame() {
+        TimePoint now = m_clock->Now();
+        if (!m_hasStarted) {
+            m_hasStarted = true;
+            m_lastFrameStart = now;
+            m_nextDeadline = now;
+        }
+
+        TimePoint deadline = m_nextDeadline;
+        if (IsIdle() && !m_wakeRequested.load(std::memory_order_acquire)) {
+            deadline = std::max(deadline, m_lastFrameStart + Duration(IDLE_FRAME_INTERVAL));
+        }
+
+        if (now < deadline) {
+            m_clock->SleepUntil(deadline);
+            now = m_clock->Now();
+            if (now < deadline) return false;
+        }
+
+        m_wakeRequested.store(false, std::memory_order_relaxed);
+        StartFrame(now);
+        return true;
+    }
+
+    void FrameScheduler::SetIdle(bool idle) noexcept {
+        m_idle.store(idle, std::memory_order_relaxed);
+    }
+
+    void FrameScheduler::Wake() {
+        if (!IsIdle() || m_wakeRequested.exchange(true, std::memory_order_acq_rel)) return;
+        m_clock->Wake();
+    }
+
+    void FrameScheduler::StartFrame(TimePoint now) {
+        const Duration interval = now - m_lastFrameStart;
+        m_deltaTime = std::chrono::duration<float>(interval).count();
+        m_lastFrameStart = now;
+
+        // Idle intervals are chosen, not missed, so they stay out of the stats
+        const bool idle = IsIdle();
+        if (m_frameCount++ > 0 && !idle) RecordInterval(interval);
+
+        if (IsUncapped()) {
+            m_nextDeadline = now;
+            return;
+        }
+        if (idle) {
+            m_nextDeadline = now + m_period;
+            return;
+        }
+
+        // One late slot is caught up on; more than that is dropped
+        m_nextDeadline += m_period;
+        if (now >= m_nextDeadline + m_period) {
+            ++m_missedDeadlines;
+            m_nextDeadline = now + m_period;
+        }
+    }
+
+    void FrameScheduler::RecordInterval(Duration interval) noexcept {
+        const float ms = std::chrono::duration<float, std::milli>(interval).count();
+        size_t bucket = static_cast<size_t>(ms / HISTOGRAM_BUCKET_MS);
+        if (bucket >= HISTOGRAM_BUCKETS) bucket = HISTOGRAM_BUCKETS - 1;
+        ++m_histogram[bucket];
+        ++m_sampleCount;
+    }
+
+    float FrameScheduler::GetPercentileMs(float fraction) const noexcept {
+        if (m_sampleCount == 0) return 0.0f;
+
+        const uint64_t target = static_cast<uint64_t>(
+            std::ceil(static_cast<double>(fraction) * m_sampleCount)
+        );
+        uint64_t seen = 0;
+        for (size_t i = 0; i < HISTOGRAM_BUCKETS; ++i) {
+            seen += m_histogram[i];
+            if (seen >= target && seen > 0) {
+                return (i + 1) * HISTOGRAM_BUCKET_MS;
+            }
+        }
+        return HISTOGRAM_BUCKETS * HISTOGRAM_BUCKET_MS;
+    }
+
+    void FrameScheduler::ResetStatistics() noexcept {
+        m_histogram.fill(0);
+        m_sampleCount = 0;
+        m_missedDeadlines = 0;
+    }
+
+}
@@ -0,0 +1,125 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// FrameScheduler.h: Deadline-based frame pacing for the main loop.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#ifndef SPECTRUM_CPP_FRAME_SCHEDULER_H
+#define SPECTRUM_CPP_FRAME_SCHEDULER_H
+
+// Standard headers only, so the scheduler builds off Windows with a fake clock
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+namespace Spectrum {
+
+    // Time source the scheduler waits on. The system clock sleeps on a
+    // high-resolution waitable timer and wakes early for window messages;
+    // ManualFrameClock stands in to drive the scheduler deterministically.
+    class IFrameClock {
+    public:
+        using TimePoint = std::chrono::steady_clock::time_point;
+
+        virtual ~IFrameClock() = default;
+
+        virtual TimePoint Now() = 0;
+
+        // May return before the deadline; callers check Now() again
+        virtual void SleepUntil(TimePoint deadline) = 0;
+
+        // Cuts a pending or the next SleepUntil short; callable from any thread
+        virtual void Wake() {}
+    };
+
+    std::unique_ptr<IFrameClock> CreateSystemFrameClock();
+
+    // Time moves only when told to: SleepUntil() jumps straight to the
+    // deadline and Advance() stands in for frame work. Single-threaded.
+    class ManualFrameClock final : public IFrameClock {
+    public:
+        explicit ManualFrameClock(TimePoint start = TimePoint()) : m_now(start) {}
+
+        TimePoint Now() override { return m_now; }
+        void SleepUntil(TimePoint deadline) override {
+            if (deadline > m_now) m_now = deadline;
+        }
+
+        void SetNow(TimePoint now) { m_now = now; }
+        void Advance(std::chrono::steady_clock::duration step) { m_now += step; }
+
+    private:
+        TimePoint m_now;
+    };
+
+    // Frames start on a fixed grid of deadlines rather than "period after
+    // the last frame", so a slow frame does not push every later one back.
+    // Falling more than a period behind resyncs instead of bursting.
+    class FrameScheduler {
+    public:
+        using Duration = std::chrono::steady_clock::duration;
+        using TimePoint = IFrameClock::TimePoint;
+
+        // Frame intervals in 0.5 ms buckets; the last bucket collects the rest
+        static constexpr size_t HISTOGRAM_BUCKETS = 80;
+        static constexpr float HISTOGRAM_BUCKET_MS = 0.5f;
+
+        explicit FrameScheduler(std::unique_ptr<IFrameClock> clock = nullptr);
+
+        // Zero or below runs uncapped
+        void SetTargetRate(float framesPerSecond);
+        float GetTargetRate() const noexcept { return m_targetRate; }
+        bool IsUncapped() const noexcept { return m_targetRate <= 0.0f; }
+
+        // True when the next frame should run now. Otherwise sleeps toward
+        // the deadline and returns false, so the caller can pump messages
+        // and ask again.
+        bool WaitForFrame();
+
+        // Seconds between the starts of the last two frames
+        float GetDeltaTime() const noexcept { return m_deltaTime; }
+
+        // While idle, frames are polled at a slow interval and leave the
+        // statistics alone. Wake() brings the next frame forward; it is the
+        // only member safe to call from other threads.
+        void SetIdle(bool idle) noexcept;
+        bool IsIdle() const noexcept { return m_idle.load(std::memory_order_relaxed); }
+        void Wake();
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Statistics
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        uint64_t GetFrameCount() const noexcept { return m_frameCount; }
+        uint64_t GetMissedDeadlines() const noexcept { return m_missedDeadlines; }
+        const std::array<uint32_t, HISTOGRAM_BUCKETS>& GetHistogram() const noexcept {
+            return m_histogram;
+        }
+
+        // Upper edge of the bucket holding the given fraction of intervals
+        float GetPercentileMs(float fraction) const noexcept;
+        void ResetStatistics() noexcept;
+
+    private:
+        void StartFrame(TimePoint now);
+        void RecordInterval(Duration interval) noexcept;
+
+        std::unique_ptr<IFrameClock> m_clock;
+
+        float m_targetRate;
+        Duration m_period;
+        TimePoint m_nextDeadline;
+        TimePoint m_lastFrameStart;
+        bool m_hasStarted;
+        float m_deltaTime;
+
+        std::atomic<bool> m_idle;
+        std::atomic<bool> m_wakeRequested;
+
+        uint64_t m_frameCount;
+        uint64_t m_missedDeadlines;
+        uint64_t m_sampleCount;
+        std::array<uint32_t, HISTOGRAM_BUCKETS> m_histogram;
+    };
+
+}
+
+#endif
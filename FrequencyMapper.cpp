@@ -12,12 +12,15 @@ namespace Spectrum {
         : m_barCount(barCount)
         , m_sampleRate(sampleRate)
         , m_nyquistFrequency(sampleRate * 0.5f)
-        , m_currentFFTSize(0) {
+        , m_currentFFTSize(0)
+        , m_tableScale(SpectrumScale::Linear)
+        , m_tableDirty(true) {
     }
 
     void FrequencyMapper::SetBarCount(size_t newBarCount) {
         if (newBarCount > 0 && newBarCount != m_barCount) {
             m_barCount = newBarCount;
+            m_tableDirty = true;
         }
     }
 
@@ -25,6 +28,13 @@ namespace Spectrum {
         if (newSampleRate > 0 && newSampleRate != m_sampleRate) {
             m_sampleRate = newSampleRate;
             m_nyquistFrequency = newSampleRate * 0.5f;
+            m_tableDirty = true;
+        }
+    }
+
+    void FrequencyMapper::Prepare(size_t fftSize, SpectrumScale scaleType) {
+        if (!IsTableValid(fftSize, scaleType)) {
+            RebuildBinTable(fftSize, scaleType);
         }
     }
 
@@ -37,22 +47,16 @@ namespace Spectrum {
             return;
         }
 
-        // Store FFT size for frequency calculations
-        m_currentFFTSize = (fftMagnitudes.size() - 1) * 2;
+        // Only rebuilt when size, scale, rate or bar count change
+        const size_t fftSize = (fftMagnitudes.size() - 1) * 2;
+        if (!IsTableValid(fftSize, scaleType)) {
+            RebuildBinTable(fftSize, scaleType);
+        }
 
-        switch (scaleType) {
-        case SpectrumScale::Linear:
-            MapLinearScale(fftMagnitudes, outputBars);
-            break;
-        case SpectrumScale::Logarithmic:
-            MapLogarithmicScale(fftMagnitudes, outputBars);
-            break;
-        case SpectrumScale::Mel:
-            MapMelScale(fftMagnitudes, outputBars);
-            break;
-        default:
-            MapLinearScale(fftMagnitudes, outputBars);
-            break;
+        const bool useAverage = UsesAverage(scaleType);
+        for (size_t i = 0; i < m_barCount; ++i) {
+            const BinRange& range = m_binTable[i];
+            outputBars[i] = AggregateValues(fftMagnitudes, range.start, range.end, useAverage);
         }
     }
 
@@ -137,46 +141,51 @@ namespace Spectrum {
         }
     }
 
-    float FrequencyMapper::CalculateBarValue(
-        const SpectrumData& magnitudes,
-        size_t startBin,
-        size_t endBin,
-        bool useAverage
+    FrequencyMapper::FrequencyRange FrequencyMapper::GetRange(
+        SpectrumScale scaleType,
+        size_t barIndex
     ) const {
-        size_t validStart = startBin;
-        size_t validEnd = endBin;
-
-        if (!ValidateBinRange(validStart, validEnd, magnitudes.size())) {
-            return 0.0f;
+        switch (scaleType) {
+        case SpectrumScale::Logarithmic:
+            return GetLogarithmicRange(barIndex);
+        case SpectrumScale::Mel:
+            return GetMelRange(barIndex);
+        case SpectrumScale::Linear:
+        default:
+            return GetLinearRange(barIndex);
         }
-
-        return AggregateValues(magnitudes, validStart, validEnd, useAverage);
     }
 
-    void FrequencyMapper::MapLinearScale(const SpectrumData& mags, SpectrumData& bars) {
-        for (size_t i = 0; i < m_barCount; ++i) {
-            auto range = GetLinearRange(i);
-            const size_t startBin = GetBinForFrequency(range.start, m_currentFFTSize);
-            const size_t endBin = GetBinForFrequency(range.end, m_currentFFTSize);
-            bars[i] = CalculateBarValue(mags, startBin, endBin, false);
-        }
+    bool FrequencyMapper::UsesAverage(SpectrumScale scaleType) noexcept {
+        return scaleType == SpectrumScale::Logarithmic;
     }
 
-    void FrequencyMapper::MapLogarithmicScale(const SpectrumData& mags, SpectrumData& bars) {
-        for (size_t i = 0; i < m_barCount; ++i) {
-            auto range = GetLogarithmicRange(i);
-            const size_t startBin = GetBinForFrequency(range.start, m_currentFFTSize);
-            const size_t endBin = GetBinForFrequency(range.end, m_currentFFTSize);
-            bars[i] = CalculateBarValue(mags, startBin, endBin, true);
-        }
+    bool FrequencyMapper::IsTableValid(
+        size_t fftSize,
+        SpectrumScale scaleType
+    ) const noexcept {
+        return !m_tableDirty
+            && m_currentFFTSize == fftSize
+            && m_tableScale == scaleType
+            && m_binTable.size() == m_barCount;
     }
 
-    void FrequencyMapper::MapMelScale(const SpectrumData& mags, SpectrumData& bars) {
+    void FrequencyMapper::RebuildBinTable(size_t fftSize, SpectrumScale scaleType) {
+        m_currentFFTSize = fftSize;
+        m_tableScale = scaleType;
+        m_tableDirty = false;
+        m_binTable.resize(m_barCount);
+
+        const size_t maxBin = fftSize / 2 + 1;
         for (size_t i = 0; i < m_barCount; ++i) {
-            auto range = GetMelRange(i);
-            const size_t startBin = GetBinForFrequency(range.start, m_currentFFTSize);
-            const size_t endBin = GetBinForFrequency(range.end, m_currentFFTSize);
-            bars[i] = CalculateBarValue(mags, startBin, endBin, false);
+            const FrequencyRange range = GetRange(scaleType, i);
+            size_t startBin = GetBinForFrequency(range.start, fftSize);
+            size_t endBin = GetBinForFrequency(range.end, fftSize);
+
+            if (!ValidateBinRange(startBin, endBin, maxBin)) {
+                startBin = endBin = 0;
+            }
+            m_binTable[i] = { startBin, endBin };
         }
     }
 
@@ -27,6 +27,9 @@ namespace Spectrum {
         void SetBarCount(size_t newBarCount);
         void SetSampleRate(size_t newSampleRate);
 
+        // Builds the bin table up front so the first mapped frame doesn't pay for it
+        void Prepare(size_t fftSize, SpectrumScale scaleType);
+
         // Frequency calculations
         float GetFrequencyForBin(size_t bin, size_t fftSize) const;
         size_t GetBinForFrequency(float frequency, size_t fftSize) const;
@@ -42,22 +45,21 @@ namespace Spectrum {
             float end;
         };
 
+        // Precomputed [start, end) bin range per bar
+        struct BinRange {
+            size_t start;
+            size_t end;
+        };
+
         FrequencyRange GetLinearRange(size_t barIndex) const;
         FrequencyRange GetLogarithmicRange(size_t barIndex) const;
         FrequencyRange GetMelRange(size_t barIndex) const;
+        FrequencyRange GetRange(SpectrumScale scaleType, size_t barIndex) const;
 
-        // Mapping implementations
-        void MapLinearScale(const SpectrumData& mags, SpectrumData& bars);
-        void MapLogarithmicScale(const SpectrumData& mags, SpectrumData& bars);
-        void MapMelScale(const SpectrumData& mags, SpectrumData& bars);
-
-        // Bar value calculation
-        float CalculateBarValue(
-            const SpectrumData& magnitudes,
-            size_t startBin,
-            size_t endBin,
-            bool useAverage
-        ) const;
+        // Table management
+        void RebuildBinTable(size_t fftSize, SpectrumScale scaleType);
+        bool IsTableValid(size_t fftSize, SpectrumScale scaleType) const noexcept;
+        static bool UsesAverage(SpectrumScale scaleType) noexcept;
 
         // Helper methods
         bool ValidateBinRange(size_t& startBin, size_t& endBin, size_t maxBin) const;
@@ -76,6 +78,10 @@ namespace Spectrum {
         size_t m_sampleRate;
         float m_nyquistFrequency;
         size_t m_currentFFTSize;
+
+        std::vector<BinRange> m_binTable;
+        SpectrumScale m_tableScale;
+        bool m_tableDirty;
     };
 
 } // namespace Spectrum
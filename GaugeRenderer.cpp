@@ -22,6 +22,8 @@ namespace Spectrum {
         constexpr float ANGLE_END = -30.0f;
         constexpr float ANGLE_TOTAL_RANGE = ANGLE_END - ANGLE_START;
         constexpr int   PEAK_HOLD_DURATION = 15;
+        constexpr float SETTLED_DB_EPSILON = 0.01f;
+        constexpr float SETTLED_ANGLE_EPSILON = 0.01f;
 
         // Geometry constants (standard mode)
         constexpr float BG_OUTER_CORNER_RADIUS = 8.0f;
@@ -94,24 +96,28 @@ namespace Spectrum {
         const std::vector<float> MINOR_MARK_VALUES = InitializeMinorMarks();
 
         // Color palettes and gradient stops
-        const std::vector<D2D1_GRADIENT_STOP> GAUGE_BACKGROUND_STOPS = {
-            {0.0f, D2D1::ColorF(250 / 255.f, 250 / 255.f, 240 / 255.f)},
-            {1.0f, D2D1::ColorF(230 / 255.f, 230 / 255.f, 215 / 255.f)}
+        const std::vector<GradientStop> GAUGE_BACKGROUND_STOPS = {
+            {0.0f, Color(250 / 255.f, 250 / 255.f, 240 / 255.f)},
+            {1.0f, Color(230 / 255.f, 230 / 255.f, 215 / 255.f)}
         };
-        const std::vector<D2D1_GRADIENT_STOP> NEEDLE_CENTER_STOPS = {
-            {0.0f, D2D1::ColorF(D2D1::ColorF::White)},
-            {0.3f, D2D1::ColorF(180 / 255.f, 180 / 255.f, 180 / 255.f)},
-            {1.0f, D2D1::ColorF(60 / 255.f, 60 / 255.f, 60 / 255.f)}
+        const std::vector<GradientStop> NEEDLE_CENTER_STOPS = {
+            {0.0f, Color::White()},
+            {0.3f, Color(180 / 255.f, 180 / 255.f, 180 / 255.f)},
+            {1.0f, Color(60 / 255.f, 60 / 255.f, 60 / 255.f)}
         };
-        const std::vector<D2D1_GRADIENT_STOP> ACTIVE_LAMP_STOPS = {
-            {0.0f, D2D1::ColorF(D2D1::ColorF::White)},
-            {0.3f, D2D1::ColorF(1.0f, 180 / 255.f, 180 / 255.f)},
-            {1.0f, D2D1::ColorF(D2D1::ColorF::Red)}
+        const std::vector<GradientStop> ACTIVE_LAMP_STOPS = {
+            {0.0f, Color::White()},
+            {0.3f, Color(1.0f, 180 / 255.f, 180 / 255.f)},
+            {1.0f, Color::Red()}
         };
-        const std::vector<D2D1_GRADIENT_STOP> INACTIVE_LAMP_STOPS = {
-            {0.0f, D2D1::ColorF(220 / 255.f, 220 / 255.f, 220 / 255.f)},
-            {0.3f, D2D1::ColorF(180 / 255.f, 0.f, 0.f)},
-            {1.0f, D2D1::ColorF(80 / 255.f, 0.f, 0.f)}
+        const std::vector<GradientStop> INACTIVE_LAMP_STOPS = {
+            {0.0f, Color(220 / 255.f, 220 / 255.f, 220 / 255.f)},
+            {0.3f, Color(180 / 255.f, 0.f, 0.f)},
+            {1.0f, Color(80 / 255.f, 0.f, 0.f)}
+        };
+        const std::vector<GradientStop> PEAK_GLOW_STOPS = {
+            {0.0f, Color(1.f, 0.f, 0.f, 0.3f)},
+            {1.0f, Color(1.f, 0.f, 0.f, 0.0f)}
         };
     }
 
@@ -123,10 +129,13 @@ namespace Spectrum {
         : m_currentDbValue(DB_MIN),
         m_currentNeedleAngle(ANGLE_START),
         m_peakHoldCounter(0),
-        m_peakActive(false) {
+        m_peakActive(false),
+        m_isSettled(false) {
         // This renderer requires a fixed aspect ratio
         m_aspectRatio = 2.0f;
         m_padding = 0.8f;
+        // Needle smoothing and peak hold count steps, not seconds
+        SetFixedTimestep(FRAME_TIME);
         UpdateSettings();
     }
 
@@ -185,10 +194,17 @@ namespace Spectrum {
         else {
             m_peakActive = false;
         }
+
+        // The lamp is steady once it is held on or fully released
+        bool lampSteady = targetDb >= DB_PEAK_THRESHOLD
+            || (m_peakHoldCounter == 0 && !m_peakActive);
+        m_isSettled = lampSteady
+            && std::abs(targetDb - m_currentDbValue) < SETTLED_DB_EPSILON
+            && std::abs(targetAngle - m_currentNeedleAngle) < SETTLED_ANGLE_EPSILON;
     }
 
     void GaugeRenderer::DoRender(
-        GraphicsContext& context,
+        RenderCommandList& commands,
         const SpectrumData& /*spectrum*/
     ) {
         // Use the helper from BaseRenderer to get the main drawing area
@@ -196,18 +212,27 @@ namespace Spectrum {
 
         if (gaugeRect.width <= 0 || gaugeRect.height <= 0) return;
 
-        DrawGaugeBackground(context, gaugeRect);
-        DrawScale(context, gaugeRect);
-        DrawNeedle(context, gaugeRect);
-        DrawPeakLamp(context, gaugeRect);
+        DrawStaticLayer(commands);
+        DrawNeedle(commands, gaugeRect);
+        DrawPeakLamp(commands, gaugeRect);
+    }
+
+    // Casing, scale and labels depend only on the layout and quality
+    void GaugeRenderer::RenderStaticLayer(RenderCommandList& commands) {
+        Rect gaugeRect = CalculatePaddedRect();
+
+        if (gaugeRect.width <= 0 || gaugeRect.height <= 0) return;
+
+        DrawGaugeBackground(commands, gaugeRect);
+        DrawScale(commands, gaugeRect);
     }
 
     // Creates a layered look for the gauge casing
     void GaugeRenderer::DrawGaugeBackground(
-        GraphicsContext& context,
+        RenderCommandList& commands,
         const Rect& rect
     ) {
-        context.DrawRoundedRectangle(
+        commands.DrawRoundedRectangle(
             rect, BG_OUTER_CORNER_RADIUS, Color::FromRGB(80, 80, 80), true
         );
 
@@ -217,7 +242,7 @@ namespace Spectrum {
             rect.width - BG_INNER_PADDING * 2,
             rect.height - BG_INNER_PADDING * 2
         );
-        context.DrawRoundedRectangle(
+        commands.DrawRoundedRectangle(
             innerRect, BG_INNER_CORNER_RADIUS, Color::FromRGB(105, 105, 105), true
         );
 
@@ -227,13 +252,13 @@ namespace Spectrum {
             innerRect.width - BG_BACKGROUND_PADDING * 2,
             innerRect.height - BG_BACKGROUND_PADDING * 2
         );
-        context.DrawGradientRectangle(backgroundRect, GAUGE_BACKGROUND_STOPS, false);
+        commands.DrawGradientRectangle(backgroundRect, GAUGE_BACKGROUND_STOPS, false);
 
-        DrawVuText(context, backgroundRect, rect.height);
+        DrawVuText(commands, backgroundRect, rect.height);
     }
 
     void GaugeRenderer::DrawVuText(
-        GraphicsContext& context,
+        RenderCommandList& commands,
         const Rect& backgroundRect,
         float fullHeight
     ) {
@@ -242,17 +267,17 @@ namespace Spectrum {
             backgroundRect.GetBottom()
                 - backgroundRect.height * BG_VU_TEXT_BOTTOM_OFFSET
         };
-        context.DrawText(
+        commands.DrawText(
             L"VU",
             pos,
             Color::Black(),
             fullHeight * BG_VU_TEXT_SIZE_RATIO,
-            DWRITE_TEXT_ALIGNMENT_CENTER
+            TextAlignment::Center
         );
     }
 
     void GaugeRenderer::DrawScale(
-        GraphicsContext& context,
+        RenderCommandList& commands,
         const Rect& rect
     ) {
         float centerX = rect.x + rect.width / 2.0f;
@@ -267,16 +292,16 @@ namespace Spectrum {
         Point radius = { radiusX, radiusY };
 
         for (const auto& mark : MAJOR_MARKS) {
-            DrawMark(context, center, radius, mark.first, mark.second);
+            DrawMark(commands, center, radius, mark.first, mark.second);
         }
         for (const auto& value : MINOR_MARK_VALUES) {
-            DrawMark(context, center, radius, value, nullptr);
+            DrawMark(commands, center, radius, value, nullptr);
         }
     }
 
     // Renders a single tick mark and its optional label
     void GaugeRenderer::DrawMark(
-        GraphicsContext& context,
+        RenderCommandList& commands,
         const Point& center,
         const Point& radius,
         float value,
@@ -301,15 +326,15 @@ namespace Spectrum {
         Color tickColor = (value >= 0)
             ? Color::FromRGB(220, 0, 0)
             : Color::FromRGB(80, 80, 80);
-        context.DrawLine(start, end, tickColor, 1.8f);
+        commands.DrawLine(start, end, tickColor, 1.8f);
 
         if (label) {
-            DrawTickLabel(context, center, radius, value, label, angle);
+            DrawTickLabel(commands, center, radius, value, label, angle);
         }
     }
 
     void GaugeRenderer::DrawTickLabel(
-        GraphicsContext& context,
+        RenderCommandList& commands,
         const Point& center,
         const Point& radius,
         float value,
@@ -329,18 +354,18 @@ namespace Spectrum {
             center.y + (radius.y + textOffset) * std::sin(rad)
         };
 
-        DWRITE_TEXT_ALIGNMENT alignment = (angle < -120.0f)
-            ? DWRITE_TEXT_ALIGNMENT_TRAILING
+        TextAlignment alignment = (angle < -120.0f)
+            ? TextAlignment::Trailing
             : (angle > -60.0f)
-            ? DWRITE_TEXT_ALIGNMENT_LEADING
-            : DWRITE_TEXT_ALIGNMENT_CENTER;
+            ? TextAlignment::Leading
+            : TextAlignment::Center;
 
         Color textColor = (value >= 0) ? Color::FromRGB(200, 0, 0) : Color::Black();
-        context.DrawText(label, pos, textColor, textSize, alignment);
+        commands.DrawText(label, pos, textColor, textSize, alignment);
     }
 
     void GaugeRenderer::DrawNeedle(
-        GraphicsContext& context,
+        RenderCommandList& commands,
         const Rect& rect
     ) {
         float centerYOffset = rect.height
@@ -358,13 +383,13 @@ namespace Spectrum {
         float centerRadius = rect.width
             * (m_isOverlay ? NEEDLE_CENTER_RADIUS_OVERLAY : NEEDLE_CENTER_RADIUS);
 
-        DrawNeedleShape(context, center, m_currentNeedleAngle, needleLength);
-        DrawNeedleCenter(context, center, centerRadius);
+        DrawNeedleShape(commands, center, m_currentNeedleAngle, needleLength);
+        DrawNeedleCenter(commands, center, centerRadius);
     }
 
     // Draws the needle using transformations for cleaner code
     void GaugeRenderer::DrawNeedleShape(
-        GraphicsContext& context,
+        RenderCommandList& commands,
         const Point& center,
         float angle,
         float needleLength
@@ -375,41 +400,45 @@ namespace Spectrum {
         Point baseRight = { NEEDLE_BASE_WIDTH, 0.0f };
 
         // Creates rotation and translation matrices
-        D2D1_MATRIX_3X2_F rotation = D2D1::Matrix3x2F::Rotation(
-            angle + 90.0f, // Add 90 because our model points up, not right
-            D2D1::Point2F(0.0f, 0.0f)
+        Transform2D rotation = Transform2D::Rotation(
+            angle + 90.0f // Add 90 because our model points up, not right
         );
-        D2D1_MATRIX_3X2_F translation = D2D1::Matrix3x2F::Translation(
+        Transform2D translation = Transform2D::Translation(
             center.x, center.y
         );
 
+        // The local shape only changes with size, so the backend keeps
+        // its built path while the transform does the per-frame work
+        const Point needle[] = { tip, baseLeft, baseRight };
+        m_needleGeometry.SetPoints(needle, 3, true);
+
         // Apply transform, draw, then reset
-        context.SetTransform(rotation * translation);
-        context.DrawPolygon({ tip, baseLeft, baseRight }, Color::Black(), true);
-        context.ResetTransform();
+        commands.SetTransform(rotation * translation);
+        commands.DrawGeometry(m_needleGeometry, Color::Black(), true);
+        commands.ResetTransform();
     }
 
     // Adds a metallic-looking pivot for the needle
     void GaugeRenderer::DrawNeedleCenter(
-        GraphicsContext& context,
+        RenderCommandList& commands,
         const Point& center,
         float radius
     ) {
         if (m_currentSettings.useGradients) {
-            context.DrawRadialGradient(center, radius, NEEDLE_CENTER_STOPS);
+            commands.DrawRadialGradient(center, radius, NEEDLE_CENTER_STOPS);
         }
         else {
-            context.DrawCircle(center, radius, Color::FromRGB(60, 60, 60), true);
+            commands.DrawCircle(center, radius, Color::FromRGB(60, 60, 60), true);
         }
 
         if (m_currentSettings.useHighlights) {
             Point highlightCenter = { center.x - radius * 0.25f, center.y - radius * 0.25f };
-            context.DrawCircle(highlightCenter, radius * 0.4f, Color(1, 1, 1, 0.6f), true);
+            commands.DrawCircle(highlightCenter, radius * 0.4f, Color(1, 1, 1, 0.6f), true);
         }
     }
 
     void GaugeRenderer::DrawPeakLamp(
-        GraphicsContext& context,
+        RenderCommandList& commands,
         const Rect& rect
     ) {
         float lampRadius = std::min(rect.width, rect.height)
@@ -420,23 +449,19 @@ namespace Spectrum {
         };
 
         if (m_peakActive && m_currentSettings.useGlow) {
-            std::vector<D2D1_GRADIENT_STOP> glowStops = {
-                {0.0f, D2D1::ColorF(1.f, 0.f, 0.f, 0.3f)},
-                {1.0f, D2D1::ColorF(1.f, 0.f, 0.f, 0.0f)}
-            };
-            context.DrawRadialGradient(
+            commands.DrawRadialGradient(
                 lampCenter,
                 lampRadius * PEAK_LAMP_GLOW_RADIUS * 2.f,
-                glowStops
+                PEAK_GLOW_STOPS
             );
         }
 
-        context.DrawRadialGradient(
+        commands.DrawRadialGradient(
             lampCenter,
             lampRadius * PEAK_LAMP_INNER_RADIUS,
             m_peakActive ? ACTIVE_LAMP_STOPS : INACTIVE_LAMP_STOPS
         );
-        context.DrawCircle(lampCenter, lampRadius, Color::FromRGB(40, 40, 40), false, 1.2f);
+        commands.DrawCircle(lampCenter, lampRadius, Color::FromRGB(40, 40, 40), false, 1.2f);
 
         Point textPos = {
             lampCenter.x,
@@ -444,12 +469,12 @@ namespace Spectrum {
         };
         Color textColor = m_peakActive ? Color::Red() : Color::FromRGB(180, 0, 0);
 
-        context.DrawText(
+        commands.DrawText(
             L"PEAK",
             textPos,
             textColor,
             lampRadius,
-            DWRITE_TEXT_ALIGNMENT_CENTER
+            TextAlignment::Center
         );
     }
 
@@ -20,6 +20,7 @@ namespace Spectrum {
         RenderStyle GetStyle() const override { return RenderStyle::Gauge; }
         std::string_view GetName() const override { return "Gauge"; }
         bool SupportsPrimaryColor() const override { return false; }
+        bool IsSettled() const override { return m_isSettled; }
 
     protected:
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
@@ -33,10 +34,12 @@ namespace Spectrum {
         ) override;
 
         void DoRender(
-            GraphicsContext& context,
+            RenderCommandList& commands,
             const SpectrumData& spectrum
         ) override;
 
+        void RenderStaticLayer(RenderCommandList& commands) override;
+
     private:
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
         // Settings
@@ -54,23 +57,23 @@ namespace Spectrum {
         // Drawing Helpers
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
         void DrawGaugeBackground(
-            GraphicsContext& context,
+            RenderCommandList& commands,
             const Rect& rect
         );
 
         void DrawVuText(
-            GraphicsContext& context,
+            RenderCommandList& commands,
             const Rect& backgroundRect,
             float fullHeight
         );
 
         void DrawScale(
-            GraphicsContext& context,
+            RenderCommandList& commands,
             const Rect& rect
         );
 
         void DrawMark(
-            GraphicsContext& context,
+            RenderCommandList& commands,
             const Point& center,
             const Point& radius,
             float value,
@@ -78,7 +81,7 @@ namespace Spectrum {
         );
 
         void DrawTickLabel(
-            GraphicsContext& context,
+            RenderCommandList& commands,
             const Point& center,
             const Point& radius,
             float value,
@@ -87,25 +90,25 @@ namespace Spectrum {
         );
 
         void DrawNeedle(
-            GraphicsContext& context,
+            RenderCommandList& commands,
             const Rect& rect
         );
 
         void DrawNeedleShape(
-            GraphicsContext& context,
+            RenderCommandList& commands,
             const Point& center,
             float angle,
             float needleLength
         );
 
         void DrawNeedleCenter(
-            GraphicsContext& context,
+            RenderCommandList& commands,
             const Point& center,
             float radius
         );
 
         void DrawPeakLamp(
-            GraphicsContext& context,
+            RenderCommandList& commands,
             const Rect& rect
         );
 
@@ -124,6 +127,8 @@ namespace Spectrum {
         float m_currentNeedleAngle;
         int m_peakHoldCounter;
         bool m_peakActive;
+        bool m_isSettled;
+        RetainedGeometry m_needleGeometry;
     };
 
 }
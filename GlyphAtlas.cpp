@@ -0,0 +1,182 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// GlyphAtlas.cpp: Implementation of the GlyphAtlas class.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#include "GlyphAtlas.h"
+#include "Utils.h"
+
+namespace Spectrum {
+
+    namespace {
+        constexpr int DOT_COLUMNS = 5;
+        constexpr int DOT_ROWS = 7;
+        // One blank dot column separates neighbouring glyphs
+        constexpr int CELL_COLUMNS = DOT_COLUMNS + 1;
+
+        // Cap height relative to the em, close to the Arial the Direct2D
+        // path uses, so labels take up similar space on both backends
+        constexpr float CAP_HEIGHT_EM = 0.7f;
+
+        // Seven rows per glyph, bit 4 is the leftmost column
+        constexpr uint8_t FONT_5X7[GlyphAtlas::GLYPH_COUNT][DOT_ROWS] = {
+            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // ' '
+            { 0x04, 0x04, 0x04, 0x04, 0x00, 0x00, 0x04 }, // '!'
+            { 0x0A, 0x0A, 0x0A, 0x00, 0x00, 0x00, 0x00 }, // '"'
+            { 0x0A, 0x0A, 0x1F, 0x0A, 0x1F, 0x0A, 0x0A }, // '#'
+            { 0x04, 0x0F, 0x14, 0x0E, 0x05, 0x1E, 0x04 }, // '$'
+            { 0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03 }, // '%'
+            { 0x0C, 0x12, 0x14, 0x08, 0x15, 0x12, 0x0D }, // '&'
+            { 0x0C, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00 }, // '''
+            { 0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02 }, // '('
+            { 0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08 }, // ')'
+            { 0x00, 0x04, 0x15, 0x0E, 0x15, 0x04, 0x00 }, // '*'
+            { 0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00 }, // '+'
+            { 0x00, 0x00, 0x00, 0x00, 0x0C, 0x04, 0x08 }, // ','
+            { 0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00 }, // '-'
+            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C }, // '.'
+            { 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00 }, // '/'
+            { 0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E }, // '0'
+            { 0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E }, // '1'
+            { 0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F }, // '2'
+            { 0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E }, // '3'
+            { 0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02 }, // '4'
+            { 0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E }, // '5'
+            { 0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E }, // '6'
+            { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08 }, // '7'
+            { 0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E }, // '8'
+            { 0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C }, // '9'
+            { 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00 }, // ':'
+            { 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x04, 0x08 }, // ';'
+            { 0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02 }, // '<'
+            { 0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00 }, // '='
+            { 0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08 }, // '>'
+            { 0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04 }, // '?'
+            { 0x0E, 0x11, 0x01, 0x0D, 0x15, 0x15, 0x0E }, // '@'
+            { 0x0E, 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11 }, // 'A'
+            { 0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E }, // 'B'
+            { 0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E }, // 'C'
+            { 0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C }, // 'D'
+            { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F }, // 'E'
+            { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10 }, // 'F'
+            { 0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F }, // 'G'
+            { 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11 }, // 'H'
+            { 0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E }, // 'I'
+            { 0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C }, // 'J'
+            { 0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11 }, // 'K'
+            { 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F }, // 'L'
+            { 0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11 }, // 'M'
+            { 0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11 }, // 'N'
+            { 0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E }, // 'O'
+            { 0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10 }, // 'P'
+            { 0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D }, // 'Q'
+            { 0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11 }, // 'R'
+            { 0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E }, // 'S'
+            { 0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 }, // 'T'
+            { 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E }, // 'U'
+            { 0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04 }, // 'V'
+            { 0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A }, // 'W'
+            { 0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11 }, // 'X'
+            { 0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04 }, // 'Y'
+            { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F }, // 'Z'
+            { 0x0E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0E }, // '['
+            { 0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00 }, // '\'
+            { 0x0E, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0E }, // ']'
+            { 0x04, 0x0A, 0x11, 0x00, 0x00, 0x00, 0x00 }, // '^'
+            { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F }, // '_'
+            { 0x08, 0x04, 0x02, 0x00, 0x00, 0x00, 0x00 }, // '`'
+            { 0x00, 0x00, 0x0E, 0x01, 0x0F, 0x11, 0x0F }, // 'a'
+            { 0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x1E }, // 'b'
+            { 0x00, 0x00, 0x0E, 0x10, 0x10, 0x11, 0x0E }, // 'c'
+            { 0x01, 0x01, 0x0D, 0x13, 0x11, 0x11, 0x0F }, // 'd'
+            { 0x00, 0x00, 0x0E, 0x11, 0x1F, 0x10, 0x0E }, // 'e'
+            { 0x06, 0x09, 0x08, 0x1C, 0x08, 0x08, 0x08 }, // 'f'
+            { 0x00, 0x0F, 0x11, 0x11, 0x0F, 0x01, 0x0E }, // 'g'
+            { 0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x11 }, // 'h'
+            { 0x04, 0x00, 0x0C, 0x04, 0x04, 0x04, 0x0E }, // 'i'
+            { 0x02, 0x00, 0x06, 0x02, 0x02, 0x12, 0x0C }, // 'j'
+            { 0x10, 0x10, 0x12, 0x14, 0x18, 0x14, 0x12 }, // 'k'
+            { 0x0C, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E }, // 'l'
+            { 0x00, 0x00, 0x1A, 0x15, 0x15, 0x11, 0x11 }, // 'm'
+            { 0x00, 0x00, 0x16, 0x19, 0x11, 0x11, 0x11 }, // 'n'
+            { 0x00, 0x00, 0x0E, 0x11, 0x11, 0x11, 0x0E }, // 'o'
+            { 0x00, 0x00, 0x1E, 0x11, 0x1E, 0x10, 0x10 }, // 'p'
+            { 0x00, 0x00, 0x0D, 0x13, 0x0F, 0x01, 0x01 }, // 'q'
+            { 0x00, 0x00, 0x16, 0x19, 0x10, 0x10, 0x10 }, // 'r'
+            { 0x00, 0x00, 0x0E, 0x10, 0x0E, 0x01, 0x1E }, // 's'
+            { 0x08, 0x08, 0x1C, 0x08, 0x08, 0x09, 0x06 }, // 't'
+            { 0x00, 0x00, 0x11, 0x11, 0x11, 0x13, 0x0D }, // 'u'
+            { 0x00, 0x00, 0x11, 0x11, 0x11, 0x0A, 0x04 }, // 'v'
+            { 0x00, 0x00, 0x11, 0x11, 0x15, 0x15, 0x0A }, // 'w'
+            { 0x00, 0x00, 0x11, 0x0A, 0x04, 0x0A, 0x11 }, // 'x'
+            { 0x00, 0x00, 0x11, 0x11, 0x0F, 0x01, 0x0E }, // 'y'
+            { 0x00, 0x00, 0x1F, 0x02, 0x04, 0x08, 0x1F }, // 'z'
+            { 0x02, 0x04, 0x04, 0x08, 0x04, 0x04, 0x02 }, // '{'
+            { 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 }, // '|'
+            { 0x08, 0x04, 0x04, 0x02, 0x04, 0x04, 0x08 }, // '}'
+            { 0x00, 0x00, 0x00, 0x0D, 0x12, 0x00, 0x00 }  // '~'
+        };
+
+        // Share of each dot span [0, dots) falling into each of the
+        // pixels output pixels, normalized so full coverage sums to one
+        std::vector<float> DotWeights(int dots, int pixels) {
+            std::vector<float> weights(static_cast<size_t>(dots) * pixels, 0.0f);
+            const float dotsPerPixel = static_cast<float>(dots) / pixels;
+            for (int p = 0; p < pixels; ++p) {
+                const float start = p * dotsPerPixel;
+                const float end = start + dotsPerPixel;
+                for (int d = 0; d < dots; ++d) {
+                    const float overlap = std::min(end, d + 1.0f) - std::max(start, static_cast<float>(d));
+                    if (overlap > 0.0f) {
+                        weights[static_cast<size_t>(p) * dots + d] = overlap / dotsPerPixel;
+                    }
+                }
+            }
+            return weights;
+        }
+    }
+
+    const uint8_t* GlyphAtlas::Page::GetGlyph(wchar_t c) const noexcept {
+        if (c < FIRST_CHAR || c > LAST_CHAR) c = L'?';
+        return coverage.data() + static_cast<size_t>(c - FIRST_CHAR) * cellWidth;
+    }
+
+    const GlyphAtlas::Page& GlyphAtlas::GetPage(int pixelSize) {
+        pixelSize = Utils::Clamp(pixelSize, MIN_PIXEL_SIZE, MAX_PIXEL_SIZE);
+
+        Page& page = m_pages[pixelSize];
+        if (page.coverage.empty()) Rasterize(page, pixelSize);
+        return page;
+    }
+
+    void GlyphAtlas::Rasterize(Page& page, int pixelSize) {
+        const float dotSize = pixelSize * CAP_HEIGHT_EM / DOT_ROWS;
+        page.cellWidth = std::max(1, static_cast<int>(std::lround(CELL_COLUMNS * dotSize)));
+        page.cellHeight = std::max(1, static_cast<int>(std::lround(DOT_ROWS * dotSize)));
+        page.coverage.assign(page.GetStride() * page.cellHeight, 0);
+
+        const std::vector<float> columnWeights = DotWeights(CELL_COLUMNS, page.cellWidth);
+        const std::vector<float> rowWeights = DotWeights(DOT_ROWS, page.cellHeight);
+
+        for (size_t glyph = 0; glyph < GLYPH_COUNT; ++glyph) {
+            const uint8_t* rows = FONT_5X7[glyph];
+            for (int py = 0; py < page.cellHeight; ++py) {
+                uint8_t* dst = page.coverage.data()
+                    + static_cast<size_t>(py) * page.GetStride()
+                    + glyph * page.cellWidth;
+                const float* wy = rowWeights.data() + static_cast<size_t>(py) * DOT_ROWS;
+
+                for (int px = 0; px < page.cellWidth; ++px) {
+                    const float* wx = columnWeights.data() + static_cast<size_t>(px) * CELL_COLUMNS;
+                    float sum = 0.0f;
+                    for (int r = 0; r < DOT_ROWS; ++r) {
+                        if (wy[r] <= 0.0f) continue;
+                        for (int c = 0; c < DOT_COLUMNS; ++c) {
+                            if (rows[r] & (0x10 >> c)) sum += wy[r] * wx[c];
+                        }
+                    }
+                    dst[px] = static_cast<uint8_t>(Utils::Saturate(sum) * 255.0f + 0.5f);
+                }
+            }
+        }
+    }
+
+}
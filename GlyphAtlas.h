@@ -0,0 +1,50 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// GlyphAtlas.h: Built-in bitmap font rasterized to coverage strips per size.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#ifndef SPECTRUM_CPP_GLYPH_ATLAS_H
+#define SPECTRUM_CPP_GLYPH_ATLAS_H
+
+#include "Common.h"
+
+namespace Spectrum {
+
+    // Text for backends without a font engine. Printable ASCII comes from a
+    // 5x7 dot font; each pixel size is area-sampled once into an 8-bit
+    // coverage strip holding every glyph, so drawing a string is a copy.
+    class GlyphAtlas {
+    public:
+        static constexpr wchar_t FIRST_CHAR = L' ';
+        static constexpr wchar_t LAST_CHAR = L'~';
+        static constexpr size_t GLYPH_COUNT = LAST_CHAR - FIRST_CHAR + 1;
+
+        static constexpr int MIN_PIXEL_SIZE = 4;
+        static constexpr int MAX_PIXEL_SIZE = 256;
+
+        // Glyph cells side by side; the cell width is also the advance
+        struct Page {
+            int cellWidth = 0;
+            int cellHeight = 0;
+            std::vector<uint8_t> coverage;
+
+            size_t GetStride() const noexcept { return GLYPH_COUNT * cellWidth; }
+
+            // Top-left of the glyph's cell; characters outside the font map to '?'
+            const uint8_t* GetGlyph(wchar_t c) const noexcept;
+        };
+
+        // Em size in device pixels, clamped to the supported range. The
+        // page is built on first use; the reference stays valid until Clear().
+        const Page& GetPage(int pixelSize);
+
+        size_t GetPageCount() const noexcept { return m_pages.size(); }
+        void Clear() noexcept { m_pages.clear(); }
+
+    private:
+        static void Rasterize(Page& page, int pixelSize);
+
+        std::unordered_map<int, Page> m_pages;
+    };
+
+}
+
+#endif
@@ -3,11 +3,53 @@
 // =-=-=-=-=-=-=-=-=-=-=
 
 #include "GraphicsContext.h"
+#include "RenderCommandList.h"
+#include "RetainedImage.h"
 #include "Utils.h"
+#include <cstring>
 
 namespace Spectrum {
 
     namespace {
+        // Entries untouched for this many frames are released
+        constexpr uint64_t RESOURCE_CACHE_TTL_FRAMES = 120;
+
+        constexpr float MIN_RENDER_SCALE = 0.25f;
+
+        inline uint64_t HashGradientStops(const GradientStop* stops, size_t count) noexcept {
+            // FNV-1a over the raw stop bytes
+            uint64_t hash = 14695981039346656037ull;
+            const auto* bytes = reinterpret_cast<const uint8_t*>(stops);
+            for (size_t i = 0; i < count * sizeof(GradientStop); ++i) {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        inline uint64_t HashText(
+            std::wstring_view text,
+            float fontSize,
+            TextAlignment alignment
+        ) noexcept {
+            // FNV-1a over the characters, then the size and alignment
+            uint64_t hash = 14695981039346656037ull;
+            auto mix = [&hash](uint32_t value) {
+                hash ^= value;
+                hash *= 1099511628211ull;
+            };
+            for (wchar_t c : text) mix(static_cast<uint32_t>(c));
+
+            uint32_t sizeBits;
+            std::memcpy(&sizeBits, &fontSize, sizeof(sizeBits));
+            mix(sizeBits);
+            mix(static_cast<uint32_t>(alignment));
+            return hash;
+        }
+
+        // Width of the box text is laid out in; wide enough for any label
+        constexpr float TEXT_BOX_WIDTH = 1000.f;
+
         inline D2D1_COLOR_F ToD2DColor(const Color& c) {
             return D2D1::ColorF(c.r, c.g, c.b, c.a);
         }
@@ -18,25 +60,22 @@ namespace Spectrum {
             return D2D1::SizeU(rc.right - rc.left, rc.bottom - rc.top);
         }
 
-        inline bool CreateGradientStopCollection(
-            ID2D1RenderTarget* rt,
-            const std::vector<D2D1_GRADIENT_STOP>& stops,
-            wrl::ComPtr<ID2D1GradientStopCollection>& out
-        ) {
-            if (stops.empty() || !rt) return false;
-            HRESULT hr = rt->CreateGradientStopCollection(
-                stops.data(),
-                static_cast<UINT32>(stops.size()),
-                D2D1_GAMMA_2_2,
-                D2D1_EXTEND_MODE_CLAMP,
-                out.GetAddressOf()
-            );
-            return SUCCEEDED(hr);
+        inline D2D1_MATRIX_3X2_F ToD2DMatrix(const Transform2D& t) {
+            return D2D1::Matrix3x2F(t.m11, t.m12, t.m21, t.m22, t.dx, t.dy);
+        }
+
+        inline DWRITE_TEXT_ALIGNMENT ToDWriteAlignment(TextAlignment alignment) {
+            switch (alignment) {
+            case TextAlignment::Center:   return DWRITE_TEXT_ALIGNMENT_CENTER;
+            case TextAlignment::Trailing: return DWRITE_TEXT_ALIGNMENT_TRAILING;
+            default:                      return DWRITE_TEXT_ALIGNMENT_LEADING;
+            }
         }
     }
 
     GraphicsContext::GraphicsContext(HWND hwnd)
-        : m_hwnd(hwnd), m_width(0), m_height(0) {
+        : m_hwnd(hwnd), m_width(0), m_height(0), m_vsync(true), m_drawTarget(nullptr)
+        , m_sceneSize{}, m_renderScale(1.0f), m_frameIndex(0), m_drawCallCount(0), m_lastFrameDrawCalls(0) {
         RECT rect;
         if (GetClientRect(hwnd, &rect)) {
             m_width = rect.right - rect.left;
@@ -70,10 +109,15 @@ namespace Spectrum {
 
         HRESULT hr = m_d2dFactory->CreateHwndRenderTarget(
             D2D1::RenderTargetProperties(),
-            D2D1::HwndRenderTargetProperties(m_hwnd, ClientSize(m_hwnd)),
+            D2D1::HwndRenderTargetProperties(
+                m_hwnd,
+                ClientSize(m_hwnd),
+                m_vsync ? D2D1_PRESENT_OPTIONS_NONE : D2D1_PRESENT_OPTIONS_IMMEDIATELY
+            ),
             m_renderTarget.GetAddressOf()
         );
         if (FAILED(hr)) return false;
+        m_drawTarget = m_renderTarget.Get();
 
         hr = m_renderTarget->CreateSolidColorBrush(
             D2D1::ColorF(D2D1::ColorF::White),
@@ -83,24 +127,104 @@ namespace Spectrum {
     }
 
     void GraphicsContext::DiscardDeviceResources() {
-        m_radialBrush.Reset();
-        m_linearBrush.Reset();
+        m_imageCache.clear();
+        m_layerCache.clear();
+        m_gradientCache.clear();
         m_solidBrush.Reset();
+        m_sceneTarget.Reset();
+        m_drawTarget = nullptr;
         m_renderTarget.Reset();
     }
 
     void GraphicsContext::BeginDraw() {
+        ++m_frameIndex;
+        m_drawCallCount = 0;
         if (!m_renderTarget) CreateDeviceResources();
         if (m_renderTarget) m_renderTarget->BeginDraw();
     }
 
     HRESULT GraphicsContext::EndDraw() {
+        m_lastFrameDrawCalls = m_drawCallCount;
+        TrimResourceCaches();
         if (!m_renderTarget) return S_OK;
         HRESULT hr = m_renderTarget->EndDraw();
         if (FAILED(hr)) DiscardDeviceResources();
         return hr;
     }
 
+    void GraphicsContext::SetVSync(bool enabled) {
+        if (m_vsync == enabled) return;
+        m_vsync = enabled;
+        DiscardDeviceResources();
+    }
+
+    void GraphicsContext::SetRenderScale(float scale) {
+        m_renderScale = std::clamp(scale, MIN_RENDER_SCALE, 1.0f);
+        if (m_renderScale >= 1.0f) m_sceneTarget.Reset();
+    }
+
+    void GraphicsContext::BeginScene() {
+        if (!m_renderTarget || m_renderScale >= 1.0f) return;
+
+        const D2D1_SIZE_U full = m_renderTarget->GetPixelSize();
+        const D2D1_SIZE_U size = D2D1::SizeU(
+            std::max(1u, static_cast<UINT32>(full.width * m_renderScale)),
+            std::max(1u, static_cast<UINT32>(full.height * m_renderScale))
+        );
+
+        if (!m_sceneTarget
+            || m_sceneSize.width != size.width
+            || m_sceneSize.height != size.height) {
+            // Same size in DIPs with fewer pixels: the target's DPI absorbs
+            // the scale, so nothing drawn into it needs adjusting
+            m_sceneTarget.Reset();
+            const D2D1_SIZE_F dips = m_renderTarget->GetSize();
+            HRESULT hr = m_renderTarget->CreateCompatibleRenderTarget(
+                &dips,
+                &size,
+                nullptr,
+                D2D1_COMPATIBLE_RENDER_TARGET_OPTIONS_NONE,
+                m_sceneTarget.GetAddressOf()
+            );
+            if (FAILED(hr)) {
+                m_sceneTarget.Reset();
+                return;
+            }
+            m_sceneSize = size;
+        }
+
+        m_sceneTarget->BeginDraw();
+        m_sceneTarget->SetTransform(D2D1::Matrix3x2F::Identity());
+        m_sceneTarget->Clear(D2D1::ColorF(0.0f, 0.0f, 0.0f, 0.0f));
+        m_drawTarget = m_sceneTarget.Get();
+    }
+
+    void GraphicsContext::EndScene() {
+        if (!m_sceneTarget || m_drawTarget != m_sceneTarget.Get()) {
+            if (m_drawTarget) m_drawTarget->Flush();
+            return;
+        }
+
+        m_drawTarget = m_renderTarget.Get();
+
+        wrl::ComPtr<ID2D1Bitmap> bitmap;
+        HRESULT hr = m_sceneTarget->EndDraw();
+        if (SUCCEEDED(hr)) hr = m_sceneTarget->GetBitmap(bitmap.GetAddressOf());
+        if (FAILED(hr)) {
+            m_sceneTarget.Reset();
+            return;
+        }
+
+        const D2D1_SIZE_F dips = m_renderTarget->GetSize();
+        m_renderTarget->DrawBitmap(
+            bitmap.Get(),
+            D2D1::RectF(0.0f, 0.0f, dips.width, dips.height),
+            1.0f,
+            D2D1_BITMAP_INTERPOLATION_MODE_LINEAR
+        );
+        ++m_drawCallCount;
+    }
+
     void GraphicsContext::Resize(int width, int height) {
         m_width = width;
         m_height = height;
@@ -124,6 +248,214 @@ namespace Spectrum {
         return m_solidBrush.Get();
     }
 
+    bool GraphicsContext::CreateGradientStops(
+        const GradientStop* stops,
+        size_t stopCount,
+        wrl::ComPtr<ID2D1GradientStopCollection>& out
+    ) {
+        if (!stops || stopCount == 0 || !m_renderTarget) return false;
+
+        m_stopScratch.resize(stopCount);
+        for (size_t i = 0; i < stopCount; ++i) {
+            m_stopScratch[i] = { stops[i].position, ToD2DColor(stops[i].color) };
+        }
+
+        HRESULT hr = m_renderTarget->CreateGradientStopCollection(
+            m_stopScratch.data(),
+            static_cast<UINT32>(m_stopScratch.size()),
+            D2D1_GAMMA_2_2,
+            D2D1_EXTEND_MODE_CLAMP,
+            out.GetAddressOf()
+        );
+        return SUCCEEDED(hr);
+    }
+
+    bool GraphicsContext::CreatePathGeometry(
+        const Point* points,
+        size_t count,
+        bool filled,
+        bool closed,
+        wrl::ComPtr<ID2D1PathGeometry>& out
+    ) {
+        ++m_cacheStats.geometryBuilds;
+        HRESULT hr = m_d2dFactory->CreatePathGeometry(out.GetAddressOf());
+        if (FAILED(hr)) return false;
+
+        wrl::ComPtr<ID2D1GeometrySink> sink;
+        hr = out->Open(sink.GetAddressOf());
+        if (FAILED(hr)) return false;
+
+        sink->BeginFigure(
+            D2D1::Point2F(points[0].x, points[0].y),
+            filled ? D2D1_FIGURE_BEGIN_FILLED : D2D1_FIGURE_BEGIN_HOLLOW
+        );
+        // Point and D2D1_POINT_2F are both two packed floats
+        static_assert(sizeof(Point) == sizeof(D2D1_POINT_2F));
+        sink->AddLines(
+            reinterpret_cast<const D2D1_POINT_2F*>(points + 1),
+            static_cast<UINT32>(count - 1)
+        );
+        sink->EndFigure(closed ? D2D1_FIGURE_END_CLOSED : D2D1_FIGURE_END_OPEN);
+        return SUCCEEDED(sink->Close());
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Resource Caches
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    GraphicsContext::GradientCacheEntry* GraphicsContext::GetGradientEntry(
+        const GradientStop* stops,
+        size_t stopCount
+    ) {
+        if (!stops || stopCount == 0 || !m_renderTarget) return nullptr;
+
+        auto& entry = m_gradientCache[HashGradientStops(stops, stopCount)];
+        entry.lastUsedFrame = m_frameIndex;
+
+        // A hash collision simply rebuilds the slot for the new stops
+        const bool matches = entry.collection
+            && entry.stops.size() == stopCount
+            && std::memcmp(entry.stops.data(), stops, stopCount * sizeof(GradientStop)) == 0;
+        if (matches) {
+            ++m_cacheStats.gradientHits;
+            return &entry;
+        }
+
+        ++m_cacheStats.gradientMisses;
+        entry.linearBrush.Reset();
+        entry.radialBrush.Reset();
+        entry.collection.Reset();
+        entry.stops.assign(stops, stops + stopCount);
+
+        if (!CreateGradientStops(stops, stopCount, entry.collection)) {
+            entry.stops.clear();
+            return nullptr;
+        }
+        return &entry;
+    }
+
+    ID2D1PathGeometry* GraphicsContext::GetRetainedGeometry(
+        GeometryHandle handle,
+        const Point* points,
+        size_t count,
+        bool filled,
+        bool closed
+    ) {
+        if (handle.id == 0) {
+            m_transientGeometry.Reset();
+            if (!CreatePathGeometry(points, count, filled, closed, m_transientGeometry)) {
+                return nullptr;
+            }
+            return m_transientGeometry.Get();
+        }
+
+        auto& entry = m_geometryCache[handle.id];
+        entry.lastUsedFrame = m_frameIndex;
+
+        const bool matches = entry.geometry
+            && entry.revision == handle.revision
+            && entry.filled == filled
+            && entry.closed == closed;
+        if (matches) {
+            ++m_cacheStats.geometryHits;
+            return entry.geometry.Get();
+        }
+
+        ++m_cacheStats.geometryMisses;
+        entry.geometry.Reset();
+        if (!CreatePathGeometry(points, count, filled, closed, entry.geometry)) {
+            entry.geometry.Reset();
+            return nullptr;
+        }
+        entry.revision = handle.revision;
+        entry.filled = filled;
+        entry.closed = closed;
+        return entry.geometry.Get();
+    }
+
+    bool GraphicsContext::RenderLayer(
+        ID2D1RenderTarget* parent,
+        LayerCacheEntry& entry,
+        LayerHandle handle,
+        const RenderCommandList& content
+    ) {
+        const D2D1_SIZE_U size = parent->GetPixelSize();
+        if (!entry.target || entry.size.width != size.width || entry.size.height != size.height) {
+            entry.bitmap.Reset();
+            entry.target.Reset();
+
+            // Matching the parent's DIPs and pixels keeps a scaled scene's
+            // layer at the scene's resolution
+            const D2D1_SIZE_F dips = parent->GetSize();
+            HRESULT hr = parent->CreateCompatibleRenderTarget(
+                &dips,
+                &size,
+                nullptr,
+                D2D1_COMPATIBLE_RENDER_TARGET_OPTIONS_NONE,
+                entry.target.GetAddressOf()
+            );
+            if (FAILED(hr)) return false;
+            entry.size = size;
+        }
+
+        entry.target->BeginDraw();
+        entry.target->SetTransform(D2D1::Matrix3x2F::Identity());
+        entry.target->Clear(D2D1::ColorF(0.0f, 0.0f, 0.0f, 0.0f));
+
+        // Compatible targets share the window's resource domain, so the
+        // cached brushes and geometry work unchanged while redirected
+        ID2D1RenderTarget* previous = m_drawTarget;
+        m_drawTarget = entry.target.Get();
+        content.Execute(*this);
+        m_drawTarget = previous;
+
+        HRESULT hr = entry.target->EndDraw();
+        if (SUCCEEDED(hr)) hr = entry.target->GetBitmap(entry.bitmap.ReleaseAndGetAddressOf());
+        if (FAILED(hr)) {
+            entry.bitmap.Reset();
+            entry.target.Reset();
+            return false;
+        }
+
+        entry.revision = handle.revision;
+        return true;
+    }
+
+    // Handles have no release hook, so entries are aged out instead
+    void GraphicsContext::TrimResourceCaches() {
+        auto trim = [this](auto& cache) {
+            for (auto it = cache.begin(); it != cache.end();) {
+                if (m_frameIndex - it->second.lastUsedFrame > RESOURCE_CACHE_TTL_FRAMES) {
+                    it = cache.erase(it);
+                }
+                else {
+                    ++it;
+                }
+            }
+        };
+        trim(m_gradientCache);
+        trim(m_geometryCache);
+        trim(m_layerCache);
+        trim(m_imageCache);
+        trim(m_textFormatCache);
+        trim(m_textLayoutCache);
+    }
+
+    // Nonzero winding so overlapping figures stay filled instead of
+    // cancelling out the way the default alternate mode would
+    bool GraphicsContext::OpenBatchGeometry(
+        wrl::ComPtr<ID2D1PathGeometry>& geometry,
+        wrl::ComPtr<ID2D1GeometrySink>& sink
+    ) {
+        HRESULT hr = m_d2dFactory->CreatePathGeometry(geometry.GetAddressOf());
+        if (FAILED(hr)) return false;
+
+        hr = geometry->Open(sink.GetAddressOf());
+        if (FAILED(hr)) return false;
+
+        sink->SetFillMode(D2D1_FILL_MODE_WINDING);
+        return true;
+    }
+
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
     // Drawing Primitives
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
@@ -133,16 +465,18 @@ namespace Spectrum {
         bool filled,
         float strokeWidth
     ) {
-        if (!m_renderTarget) return;
+        if (!m_drawTarget) return;
         ID2D1SolidColorBrush* b = GetSolidBrush(color);
         if (!b) return;
 
         D2D1_RECT_F r = D2D1::RectF(rect.x, rect.y, rect.GetRight(), rect.GetBottom());
         if (filled) {
-            m_renderTarget->FillRectangle(&r, b);
+            m_drawTarget->FillRectangle(&r, b);
+            ++m_drawCallCount;
         }
         else {
-            m_renderTarget->DrawRectangle(&r, b, strokeWidth);
+            m_drawTarget->DrawRectangle(&r, b, strokeWidth);
+            ++m_drawCallCount;
         }
     }
 
@@ -153,7 +487,7 @@ namespace Spectrum {
         bool filled,
         float strokeWidth
     ) {
-        if (!m_renderTarget) return;
+        if (!m_drawTarget) return;
         ID2D1SolidColorBrush* b = GetSolidBrush(color);
         if (!b) return;
 
@@ -163,10 +497,12 @@ namespace Spectrum {
             radius
         );
         if (filled) {
-            m_renderTarget->FillRoundedRectangle(&rr, b);
+            m_drawTarget->FillRoundedRectangle(&rr, b);
+            ++m_drawCallCount;
         }
         else {
-            m_renderTarget->DrawRoundedRectangle(&rr, b, strokeWidth);
+            m_drawTarget->DrawRoundedRectangle(&rr, b, strokeWidth);
+            ++m_drawCallCount;
         }
     }
 
@@ -188,16 +524,18 @@ namespace Spectrum {
         bool filled,
         float strokeWidth
     ) {
-        if (!m_renderTarget) return;
+        if (!m_drawTarget) return;
         ID2D1SolidColorBrush* b = GetSolidBrush(color);
         if (!b) return;
 
         D2D1_ELLIPSE e = D2D1::Ellipse(D2D1::Point2F(center.x, center.y), radiusX, radiusY);
         if (filled) {
-            m_renderTarget->FillEllipse(&e, b);
+            m_drawTarget->FillEllipse(&e, b);
+            ++m_drawCallCount;
         }
         else {
-            m_renderTarget->DrawEllipse(&e, b, strokeWidth);
+            m_drawTarget->DrawEllipse(&e, b, strokeWidth);
+            ++m_drawCallCount;
         }
     }
 
@@ -207,86 +545,214 @@ namespace Spectrum {
         const Color& color,
         float strokeWidth
     ) {
-        if (!m_renderTarget) return;
+        if (!m_drawTarget) return;
         ID2D1SolidColorBrush* b = GetSolidBrush(color);
         if (!b) return;
-        m_renderTarget->DrawLine(
+        m_drawTarget->DrawLine(
             D2D1::Point2F(start.x, start.y),
             D2D1::Point2F(end.x, end.y),
             b,
             strokeWidth
         );
+        ++m_drawCallCount;
     }
 
     void GraphicsContext::DrawPolyline(
-        const std::vector<Point>& points,
+        const Point* points,
+        size_t count,
         const Color& color,
         float strokeWidth
     ) {
-        if (!m_renderTarget || points.size() < 2) return;
+        if (!m_drawTarget || !points || count < 2) return;
 
         wrl::ComPtr<ID2D1PathGeometry> geo;
-        HRESULT hr = m_d2dFactory->CreatePathGeometry(geo.GetAddressOf());
-        if (FAILED(hr)) return;
-
-        wrl::ComPtr<ID2D1GeometrySink> sink;
-        hr = geo->Open(sink.GetAddressOf());
-        if (FAILED(hr)) return;
-
-        sink->BeginFigure(
-            D2D1::Point2F(points[0].x, points[0].y),
-            D2D1_FIGURE_BEGIN_HOLLOW
-        );
-        std::vector<D2D1_POINT_2F> d2dPoints;
-        for (size_t i = 1; i < points.size(); ++i) {
-            d2dPoints.push_back(D2D1::Point2F(points[i].x, points[i].y));
-        }
-        sink->AddLines(d2dPoints.data(), static_cast<UINT32>(d2dPoints.size()));
-        sink->EndFigure(D2D1_FIGURE_END_OPEN);
-        hr = sink->Close();
-        if (FAILED(hr)) return;
+        if (!CreatePathGeometry(points, count, false, false, geo)) return;
 
         ID2D1SolidColorBrush* b = GetSolidBrush(color);
         if (!b) return;
 
-        m_renderTarget->DrawGeometry(geo.Get(), b, strokeWidth);
+        m_drawTarget->DrawGeometry(geo.Get(), b, strokeWidth);
+        ++m_drawCallCount;
     }
 
     void GraphicsContext::DrawPolygon(
-        const std::vector<Point>& points,
+        const Point* points,
+        size_t count,
         const Color& color,
         bool filled,
         float strokeWidth
     ) {
-        if (!m_renderTarget || points.size() < 3) return;
+        if (!m_drawTarget || !points || count < 3) return;
+
         wrl::ComPtr<ID2D1PathGeometry> geo;
-        HRESULT hr = m_d2dFactory->CreatePathGeometry(geo.GetAddressOf());
-        if (FAILED(hr)) return;
+        if (!CreatePathGeometry(points, count, filled, true, geo)) return;
 
-        wrl::ComPtr<ID2D1GeometrySink> sink;
-        hr = geo->Open(sink.GetAddressOf());
-        if (FAILED(hr)) return;
+        ID2D1SolidColorBrush* b = GetSolidBrush(color);
+        if (!b) return;
 
-        sink->BeginFigure(
-            D2D1::Point2F(points[0].x, points[0].y),
-            filled ? D2D1_FIGURE_BEGIN_FILLED : D2D1_FIGURE_BEGIN_HOLLOW
-        );
-        for (size_t i = 1; i < points.size(); ++i) {
-            sink->AddLine(D2D1::Point2F(points[i].x, points[i].y));
+        if (filled) {
+            m_drawTarget->FillGeometry(geo.Get(), b);
+            ++m_drawCallCount;
         }
-        sink->EndFigure(D2D1_FIGURE_END_CLOSED);
-        hr = sink->Close();
-        if (FAILED(hr)) return;
+        else {
+            m_drawTarget->DrawGeometry(geo.Get(), b, strokeWidth);
+            ++m_drawCallCount;
+        }
+    }
+
+    void GraphicsContext::DrawGeometry(
+        GeometryHandle handle,
+        const Point* points,
+        size_t count,
+        bool closed,
+        const Color& color,
+        bool filled,
+        float strokeWidth
+    ) {
+        if (!m_drawTarget || !points || count < (filled ? 3u : 2u)) return;
+
+        ID2D1PathGeometry* geo = GetRetainedGeometry(handle, points, count, filled, closed);
+        if (!geo) return;
 
         ID2D1SolidColorBrush* b = GetSolidBrush(color);
         if (!b) return;
 
         if (filled) {
-            m_renderTarget->FillGeometry(geo.Get(), b);
+            m_drawTarget->FillGeometry(geo, b);
         }
         else {
-            m_renderTarget->DrawGeometry(geo.Get(), b, strokeWidth);
+            m_drawTarget->DrawGeometry(geo, b, strokeWidth);
+        }
+        ++m_drawCallCount;
+    }
+
+    void GraphicsContext::DrawGeometryInstances(
+        GeometryHandle handle,
+        const Point* points,
+        size_t count,
+        bool closed,
+        const GeometryInstance* instances,
+        size_t instanceCount,
+        bool filled
+    ) {
+        if (!m_drawTarget || !points || count < (filled ? 3u : 2u)) return;
+        if (!instances || instanceCount == 0) return;
+
+        ID2D1PathGeometry* geo = GetRetainedGeometry(handle, points, count, filled, closed);
+        if (!geo) return;
+
+        D2D1_MATRIX_3X2_F base;
+        m_drawTarget->GetTransform(&base);
+        const Transform2D current = {
+            base._11, base._12, base._21, base._22, base._31, base._32
+        };
+
+        for (size_t i = 0; i < instanceCount; ++i) {
+            const GeometryInstance& instance = instances[i];
+            ID2D1SolidColorBrush* b = GetSolidBrush(instance.color);
+            if (!b) break;
+
+            m_drawTarget->SetTransform(ToD2DMatrix(instance.transform * current));
+            if (filled) {
+                m_drawTarget->FillGeometry(geo, b);
+            }
+            else {
+                m_drawTarget->DrawGeometry(geo, b, instance.strokeWidth);
+            }
+            ++m_drawCallCount;
+        }
+
+        m_drawTarget->SetTransform(base);
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Batched Fills
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    void GraphicsContext::FillRectangles(
+        const Rect* rects,
+        size_t count,
+        const Color& color
+    ) {
+        if (!m_drawTarget || !rects || count == 0) return;
+        ID2D1SolidColorBrush* b = GetSolidBrush(color);
+        if (!b) return;
+
+        if (count == 1) {
+            D2D1_RECT_F r = D2D1::RectF(
+                rects[0].x, rects[0].y, rects[0].GetRight(), rects[0].GetBottom()
+            );
+            m_drawTarget->FillRectangle(&r, b);
+            ++m_drawCallCount;
+            return;
+        }
+
+        wrl::ComPtr<ID2D1PathGeometry> geo;
+        wrl::ComPtr<ID2D1GeometrySink> sink;
+        if (!OpenBatchGeometry(geo, sink)) return;
+
+        for (size_t i = 0; i < count; ++i) {
+            const Rect& r = rects[i];
+            const D2D1_POINT_2F corners[3] = {
+                D2D1::Point2F(r.GetRight(), r.y),
+                D2D1::Point2F(r.GetRight(), r.GetBottom()),
+                D2D1::Point2F(r.x, r.GetBottom())
+            };
+            sink->BeginFigure(D2D1::Point2F(r.x, r.y), D2D1_FIGURE_BEGIN_FILLED);
+            sink->AddLines(corners, 3);
+            sink->EndFigure(D2D1_FIGURE_END_CLOSED);
+        }
+        if (FAILED(sink->Close())) return;
+
+        m_drawTarget->FillGeometry(geo.Get(), b);
+        ++m_drawCallCount;
+    }
+
+    void GraphicsContext::FillEllipses(
+        const Rect* bounds,
+        size_t count,
+        const Color& color
+    ) {
+        if (!m_drawTarget || !bounds || count == 0) return;
+        ID2D1SolidColorBrush* b = GetSolidBrush(color);
+        if (!b) return;
+
+        if (count == 1) {
+            const Rect& r = bounds[0];
+            D2D1_ELLIPSE e = D2D1::Ellipse(
+                D2D1::Point2F(r.x + r.width * 0.5f, r.y + r.height * 0.5f),
+                r.width * 0.5f,
+                r.height * 0.5f
+            );
+            m_drawTarget->FillEllipse(&e, b);
+            ++m_drawCallCount;
+            return;
         }
+
+        wrl::ComPtr<ID2D1PathGeometry> geo;
+        wrl::ComPtr<ID2D1GeometrySink> sink;
+        if (!OpenBatchGeometry(geo, sink)) return;
+
+        // Two half arcs per ellipse, starting and ending on the left edge
+        for (size_t i = 0; i < count; ++i) {
+            const Rect& r = bounds[i];
+            const D2D1_SIZE_F radii = D2D1::SizeF(r.width * 0.5f, r.height * 0.5f);
+            const float midY = r.y + radii.height;
+            const D2D1_POINT_2F left = D2D1::Point2F(r.x, midY);
+            const D2D1_POINT_2F right = D2D1::Point2F(r.GetRight(), midY);
+
+            sink->BeginFigure(left, D2D1_FIGURE_BEGIN_FILLED);
+            sink->AddArc(D2D1::ArcSegment(
+                right, radii, 0.0f, D2D1_SWEEP_DIRECTION_CLOCKWISE, D2D1_ARC_SIZE_SMALL
+            ));
+            sink->AddArc(D2D1::ArcSegment(
+                left, radii, 0.0f, D2D1_SWEEP_DIRECTION_CLOCKWISE, D2D1_ARC_SIZE_SMALL
+            ));
+            sink->EndFigure(D2D1_FIGURE_END_CLOSED);
+        }
+        if (FAILED(sink->Close())) return;
+
+        m_drawTarget->FillGeometry(geo.Get(), b);
+        ++m_drawCallCount;
     }
 
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
@@ -294,73 +760,257 @@ namespace Spectrum {
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
     void GraphicsContext::DrawGradientRectangle(
         const Rect& rect,
-        const std::vector<D2D1_GRADIENT_STOP>& stops,
+        const GradientStop* stops,
+        size_t stopCount,
         bool horizontal
     ) {
-        if (!m_renderTarget) return;
+        if (!m_drawTarget) return;
 
-        wrl::ComPtr<ID2D1GradientStopCollection> stopCollection;
-        if (!CreateGradientStopCollection(m_renderTarget.Get(), stops, stopCollection)) return;
+        GradientCacheEntry* entry = GetGradientEntry(stops, stopCount);
+        if (!entry) return;
 
         D2D1_POINT_2F start = D2D1::Point2F(rect.x, rect.y);
         D2D1_POINT_2F end = horizontal
             ? D2D1::Point2F(rect.GetRight(), rect.y)
             : D2D1::Point2F(rect.x, rect.GetBottom());
 
-        m_linearBrush.Reset();
-        HRESULT hr = m_renderTarget->CreateLinearGradientBrush(
-            D2D1::LinearGradientBrushProperties(start, end),
-            stopCollection.Get(),
-            m_linearBrush.GetAddressOf()
-        );
-
-        if (SUCCEEDED(hr)) {
-            D2D1_RECT_F r = D2D1::RectF(rect.x, rect.y, rect.GetRight(), rect.GetBottom());
-            m_renderTarget->FillRectangle(&r, m_linearBrush.Get());
+        if (entry->linearBrush) {
+            entry->linearBrush->SetStartPoint(start);
+            entry->linearBrush->SetEndPoint(end);
+        }
+        else {
+            HRESULT hr = m_renderTarget->CreateLinearGradientBrush(
+                D2D1::LinearGradientBrushProperties(start, end),
+                entry->collection.Get(),
+                entry->linearBrush.GetAddressOf()
+            );
+            if (FAILED(hr)) return;
         }
+
+        D2D1_RECT_F r = D2D1::RectF(rect.x, rect.y, rect.GetRight(), rect.GetBottom());
+        m_drawTarget->FillRectangle(&r, entry->linearBrush.Get());
+        ++m_drawCallCount;
     }
 
     void GraphicsContext::DrawRadialGradient(
         const Point& center,
         float radius,
-        const std::vector<D2D1_GRADIENT_STOP>& stops
+        const GradientStop* stops,
+        size_t stopCount
     ) {
-        if (!m_renderTarget) return;
-
-        wrl::ComPtr<ID2D1GradientStopCollection> stopCollection;
-        if (!CreateGradientStopCollection(m_renderTarget.Get(), stops, stopCollection)) return;
-
-        m_radialBrush.Reset();
-        HRESULT hr = m_renderTarget->CreateRadialGradientBrush(
-            D2D1::RadialGradientBrushProperties(
-                D2D1::Point2F(center.x, center.y),
-                D2D1::Point2F(0, 0),
-                radius,
-                radius
+        if (!m_drawTarget) return;
+
+        GradientCacheEntry* entry = GetGradientEntry(stops, stopCount);
+        if (!entry) return;
+
+        const D2D1_POINT_2F c = D2D1::Point2F(center.x, center.y);
+        if (entry->radialBrush) {
+            entry->radialBrush->SetCenter(c);
+            entry->radialBrush->SetRadiusX(radius);
+            entry->radialBrush->SetRadiusY(radius);
+        }
+        else {
+            HRESULT hr = m_renderTarget->CreateRadialGradientBrush(
+                D2D1::RadialGradientBrushProperties(
+                    c,
+                    D2D1::Point2F(0, 0),
+                    radius,
+                    radius
+                ),
+                entry->collection.Get(),
+                entry->radialBrush.GetAddressOf()
+            );
+            if (FAILED(hr)) return;
+        }
+
+        D2D1_ELLIPSE e = D2D1::Ellipse(c, radius, radius);
+        m_drawTarget->FillEllipse(&e, entry->radialBrush.Get());
+        ++m_drawCallCount;
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Images
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    void GraphicsContext::DrawImage(
+        const RetainedImage& image,
+        const Rect& destination,
+        const Rect& source
+    ) {
+        if (!m_drawTarget || image.IsEmpty()) return;
+
+        const ImageHandle handle = image.GetHandle();
+        const uint32_t* pixels = image.GetPixels();
+        const int width = image.GetWidth();
+        const int height = image.GetHeight();
+
+        auto& entry = m_imageCache[handle.id];
+        entry.lastUsedFrame = m_frameIndex;
+
+        const D2D1_SIZE_U size = D2D1::SizeU(width, height);
+        bool created = false;
+        if (!entry.bitmap || entry.size.width != size.width || entry.size.height != size.height) {
+            entry.bitmap.Reset();
+            HRESULT hr = m_renderTarget->CreateBitmap(
+                size,
+                nullptr,
+                0,
+                D2D1::BitmapProperties(D2D1::PixelFormat(
+                    DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED
+                )),
+                entry.bitmap.GetAddressOf()
+            );
+            if (FAILED(hr)) return;
+            entry.size = size;
+            created = true;
+        }
+
+        if (created || handle.id == 0 || entry.revision != handle.revision) {
+            ++m_cacheStats.imageMisses;
+
+            // A fresh bitmap, or a copy older than the image's dirty log,
+            // takes every row
+            int first = 0;
+            int count = height;
+            if (!created && handle.id != 0) {
+                image.GetRowsDirtySince(entry.revision, first, count);
+            }
+
+            if (count > 0) {
+                const D2D1_RECT_U rows = D2D1::RectU(0, first, width, first + count);
+                const UINT32 pitch = static_cast<UINT32>(width) * sizeof(uint32_t);
+                HRESULT hr = entry.bitmap->CopyFromMemory(
+                    &rows, pixels + static_cast<size_t>(first) * width, pitch
+                );
+                if (FAILED(hr)) return;
+                m_cacheStats.imageRowsUploaded += static_cast<size_t>(count);
+            }
+            entry.revision = handle.revision;
+        }
+        else {
+            ++m_cacheStats.imageHits;
+        }
+
+        const D2D1_RECT_F sourceRect = D2D1::RectF(
+            source.x, source.y, source.GetRight(), source.GetBottom()
+        );
+        const bool wholeImage = source.width <= 0.0f || source.height <= 0.0f;
+
+        m_drawTarget->DrawBitmap(
+            entry.bitmap.Get(),
+            D2D1::RectF(
+                destination.x, destination.y,
+                destination.GetRight(), destination.GetBottom()
             ),
-            stopCollection.Get(),
-            m_radialBrush.GetAddressOf()
+            1.0f,
+            D2D1_BITMAP_INTERPOLATION_MODE_NEAREST_NEIGHBOR,
+            wholeImage ? nullptr : &sourceRect
         );
+        ++m_drawCallCount;
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Retained Layers
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    void GraphicsContext::DrawLayer(
+        LayerHandle handle,
+        const RenderCommandList& content
+    ) {
+        if (!m_drawTarget) return;
+
+        // A layer drawn inside another layer's recording is just flattened
+        // into it; the window and the scaled scene both cache
+        ID2D1RenderTarget* target = m_drawTarget;
+        if (target != m_renderTarget.Get() && target != m_sceneTarget.Get()) {
+            content.Execute(*this);
+            return;
+        }
+
+        auto& entry = m_layerCache[handle.id];
+        entry.lastUsedFrame = m_frameIndex;
 
-        if (SUCCEEDED(hr)) {
-            D2D1_ELLIPSE e = D2D1::Ellipse(D2D1::Point2F(center.x, center.y), radius, radius);
-            m_renderTarget->FillEllipse(&e, m_radialBrush.Get());
+        const D2D1_SIZE_U size = target->GetPixelSize();
+        const bool matches = entry.bitmap
+            && entry.revision == handle.revision
+            && entry.size.width == size.width
+            && entry.size.height == size.height;
+        if (matches) {
+            ++m_cacheStats.layerHits;
         }
+        else {
+            ++m_cacheStats.layerMisses;
+            if (!RenderLayer(target, entry, handle, content)) {
+                content.Execute(*this);
+                return;
+            }
+        }
+
+        D2D1_MATRIX_3X2_F saved;
+        target->GetTransform(&saved);
+        target->SetTransform(D2D1::Matrix3x2F::Identity());
+
+        const D2D1_SIZE_F dips = target->GetSize();
+        target->DrawBitmap(
+            entry.bitmap.Get(),
+            D2D1::RectF(0.0f, 0.0f, dips.width, dips.height),
+            1.0f,
+            D2D1_BITMAP_INTERPOLATION_MODE_NEAREST_NEIGHBOR
+        );
+        ++m_drawCallCount;
+
+        target->SetTransform(saved);
     }
 
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
     // Text
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
     void GraphicsContext::DrawText(
-        const std::wstring& text,
+        std::wstring_view text,
         const Point& position,
         const Color& color,
         float fontSize,
-        DWRITE_TEXT_ALIGNMENT alignment
+        TextAlignment alignment
     ) {
-        if (!m_renderTarget || text.empty() || !m_writeFactory) return;
+        if (!m_drawTarget || text.empty() || !m_writeFactory) return;
+
+        IDWriteTextLayout* layout = GetTextLayout(text, fontSize, alignment);
+        if (!layout) return;
 
-        wrl::ComPtr<IDWriteTextFormat> tf;
+        ID2D1SolidColorBrush* b = GetSolidBrush(color);
+        if (!b) return;
+
+        // The layout box is TEXT_BOX_WIDTH wide and centred vertically on
+        // the position; alignment picks which edge the position anchors
+        float left = position.x;
+        if (alignment == TextAlignment::Center) {
+            left -= TEXT_BOX_WIDTH / 2.f;
+        }
+        else if (alignment == TextAlignment::Trailing) {
+            left -= TEXT_BOX_WIDTH;
+        }
+
+        m_drawTarget->DrawTextLayout(
+            D2D1::Point2F(left, position.y - fontSize),
+            layout,
+            b
+        );
+        ++m_drawCallCount;
+    }
+
+    // Formats differ only by size and alignment; the family is fixed
+    IDWriteTextFormat* GraphicsContext::GetTextFormat(float fontSize, TextAlignment alignment) {
+        uint32_t sizeBits;
+        std::memcpy(&sizeBits, &fontSize, sizeof(sizeBits));
+        const uint64_t key = (static_cast<uint64_t>(sizeBits) << 8)
+            | static_cast<uint64_t>(alignment);
+
+        auto& entry = m_textFormatCache[key];
+        entry.lastUsedFrame = m_frameIndex;
+        if (entry.format) {
+            ++m_cacheStats.textFormatHits;
+            return entry.format.Get();
+        }
+
+        ++m_cacheStats.textFormatMisses;
         HRESULT hr = m_writeFactory->CreateTextFormat(
             L"Arial",
             nullptr,
@@ -369,58 +1019,70 @@ namespace Spectrum {
             DWRITE_FONT_STRETCH_NORMAL,
             fontSize,
             L"en-US",
-            tf.GetAddressOf()
+            entry.format.GetAddressOf()
         );
-        if (FAILED(hr)) return;
+        if (FAILED(hr)) return nullptr;
 
-        tf->SetTextAlignment(alignment);
-        tf->SetParagraphAlignment(DWRITE_PARAGRAPH_ALIGNMENT_CENTER);
+        entry.format->SetTextAlignment(ToDWriteAlignment(alignment));
+        entry.format->SetParagraphAlignment(DWRITE_PARAGRAPH_ALIGNMENT_CENTER);
+        return entry.format.Get();
+    }
 
-        ID2D1SolidColorBrush* b = GetSolidBrush(color);
-        if (!b) return;
+    // Shaping happens once per distinct label instead of on every draw
+    IDWriteTextLayout* GraphicsContext::GetTextLayout(
+        std::wstring_view text,
+        float fontSize,
+        TextAlignment alignment
+    ) {
+        auto& entry = m_textLayoutCache[HashText(text, fontSize, alignment)];
+        entry.lastUsedFrame = m_frameIndex;
 
-        D2D1_RECT_F layoutRect;
-        constexpr float boxWidth = 1000.f;
-        if (alignment == DWRITE_TEXT_ALIGNMENT_CENTER) {
-            layoutRect = D2D1::RectF(
-                position.x - boxWidth / 2.f, position.y - fontSize,
-                position.x + boxWidth / 2.f, position.y + fontSize
-            );
-        }
-        else if (alignment == DWRITE_TEXT_ALIGNMENT_LEADING) {
-            layoutRect = D2D1::RectF(
-                position.x, position.y - fontSize,
-                position.x + boxWidth, position.y + fontSize
-            );
-        }
-        else { // Trailing
-            layoutRect = D2D1::RectF(
-                position.x - boxWidth, position.y - fontSize,
-                position.x, position.y + fontSize
-            );
+        // A hash collision simply rebuilds the slot for the new text
+        const bool matches = entry.layout
+            && entry.fontSize == fontSize
+            && entry.alignment == alignment
+            && entry.text == text;
+        if (matches) {
+            ++m_cacheStats.textLayoutHits;
+            return entry.layout.Get();
         }
 
-        m_renderTarget->DrawTextW(
-            text.c_str(),
-            static_cast<UINT32>(text.length()),
-            tf.Get(),
-            &layoutRect,
-            b
+        ++m_cacheStats.textLayoutMisses;
+        entry.layout.Reset();
+        entry.text.assign(text.data(), text.size());
+        entry.fontSize = fontSize;
+        entry.alignment = alignment;
+
+        IDWriteTextFormat* format = GetTextFormat(fontSize, alignment);
+        if (!format) return nullptr;
+
+        HRESULT hr = m_writeFactory->CreateTextLayout(
+            entry.text.data(),
+            static_cast<UINT32>(entry.text.size()),
+            format,
+            TEXT_BOX_WIDTH,
+            fontSize * 2.f,
+            entry.layout.GetAddressOf()
         );
+        if (FAILED(hr)) {
+            entry.text.clear();
+            return nullptr;
+        }
+        return entry.layout.Get();
     }
 
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
     // Transformations
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
-    void GraphicsContext::SetTransform(const D2D1_MATRIX_3X2_F& transform) {
-        if (m_renderTarget) {
-            m_renderTarget->SetTransform(transform);
+    void GraphicsContext::SetTransform(const Transform2D& transform) {
+        if (m_drawTarget) {
+            m_drawTarget->SetTransform(ToD2DMatrix(transform));
         }
     }
 
     void GraphicsContext::ResetTransform() {
-        if (m_renderTarget) {
-            m_renderTarget->SetTransform(D2D1::Matrix3x2F::Identity());
+        if (m_drawTarget) {
+            m_drawTarget->SetTransform(D2D1::Matrix3x2F::Identity());
         }
     }
 }
\ No newline at end of file
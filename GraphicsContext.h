@@ -5,14 +5,32 @@
 #ifndef SPECTRUM_CPP_GRAPHICS_CONTEXT_H
 #define SPECTRUM_CPP_GRAPHICS_CONTEXT_H
 
-#include "Common.h"
+#include "Win32Common.h"
+#include "IRenderBackend.h"
 
 namespace Spectrum {
 
-    class GraphicsContext {
+    class GraphicsContext final : public IRenderBackend {
     public:
+        struct ResourceCacheStats {
+            size_t gradientHits = 0;
+            size_t gradientMisses = 0;
+            size_t geometryHits = 0;
+            size_t geometryMisses = 0;
+            size_t geometryBuilds = 0;    // Every path built, retained or not
+            size_t layerHits = 0;
+            size_t layerMisses = 0;
+            size_t imageHits = 0;
+            size_t imageMisses = 0;
+            size_t imageRowsUploaded = 0;
+            size_t textFormatHits = 0;
+            size_t textFormatMisses = 0;
+            size_t textLayoutHits = 0;
+            size_t textLayoutMisses = 0;
+        };
+
         explicit GraphicsContext(HWND hwnd);
-        ~GraphicsContext();
+        ~GraphicsContext() override;
 
         bool Initialize();
         void BeginDraw();
@@ -20,29 +38,36 @@ namespace Spectrum {
         void Resize(int width, int height);
         void Clear(const Color& color);
 
+        // With vsync off EndDraw presents immediately; the target is
+        // recreated on the next BeginDraw when the setting changes
+        void SetVSync(bool enabled);
+        bool IsVSyncEnabled() const noexcept { return m_vsync; }
+
+        // Below 1, drawing between BeginScene and EndScene lands in an
+        // offscreen target with that fraction of the window's pixels and
+        // is stretched over the window. Coordinates are unaffected.
+        void SetRenderScale(float scale);
+        float GetRenderScale() const noexcept { return m_renderScale; }
+        void BeginScene();
+        // Also flushes an unscaled scene, so timing it covers the backend
+        void EndScene();
+
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
-        // Drawing Primitives
+        // IRenderBackend Implementation
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
         void DrawRectangle(
             const Rect& rect,
             const Color& color,
             bool filled = true,
             float strokeWidth = 1.0f
-        );
+        ) override;
         void DrawRoundedRectangle(
             const Rect& rect,
             float radius,
             const Color& color,
             bool filled = true,
             float strokeWidth = 1.0f
-        );
-        void DrawCircle(
-            const Point& center,
-            float radius,
-            const Color& color,
-            bool filled = true,
-            float strokeWidth = 1.0f
-        );
+        ) override;
         void DrawEllipse(
             const Point& center,
             float radiusX,
@@ -50,55 +75,93 @@ namespace Spectrum {
             const Color& color,
             bool filled = true,
             float strokeWidth = 1.0f
-        );
+        ) override;
         void DrawLine(
             const Point& start,
             const Point& end,
             const Color& color,
             float strokeWidth = 1.0f
-        );
+        ) override;
         void DrawPolyline(
-            const std::vector<Point>& points,
+            const Point* points,
+            size_t count,
             const Color& color,
             float strokeWidth = 1.0f
-        );
+        ) override;
         void DrawPolygon(
-            const std::vector<Point>& points,
+            const Point* points,
+            size_t count,
             const Color& color,
             bool filled = true,
             float strokeWidth = 1.0f
-        );
-
-        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
-        // Gradients
-        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        ) override;
+        void DrawGeometry(
+            GeometryHandle handle,
+            const Point* points,
+            size_t count,
+            bool closed,
+            const Color& color,
+            bool filled = true,
+            float strokeWidth = 1.0f
+        ) override;
+        void DrawGeometryInstances(
+            GeometryHandle handle,
+            const Point* points,
+            size_t count,
+            bool closed,
+            const GeometryInstance* instances,
+            size_t instanceCount,
+            bool filled = true
+        ) override;
+        void FillRectangles(
+            const Rect* rects,
+            size_t count,
+            const Color& color
+        ) override;
+        void FillEllipses(
+            const Rect* bounds,
+            size_t count,
+            const Color& color
+        ) override;
         void DrawGradientRectangle(
             const Rect& rect,
-            const std::vector<D2D1_GRADIENT_STOP>& stops,
+            const GradientStop* stops,
+            size_t stopCount,
             bool horizontal = true
-        );
+        ) override;
         void DrawRadialGradient(
             const Point& center,
             float radius,
-            const std::vector<D2D1_GRADIENT_STOP>& stops
-        );
-
-        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
-        // Text
-        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+            const GradientStop* stops,
+            size_t stopCount
+        ) override;
+        void DrawImage(
+            const RetainedImage& image,
+            const Rect& destination,
+            const Rect& source = Rect()
+        ) override;
+        void DrawLayer(
+            LayerHandle handle,
+            const RenderCommandList& content
+        ) override;
         void DrawText(
-            const std::wstring& text,
+            std::wstring_view text,
             const Point& position,
             const Color& color,
             float fontSize = 12.0f,
-            DWRITE_TEXT_ALIGNMENT alignment = DWRITE_TEXT_ALIGNMENT_LEADING
-        );
+            TextAlignment alignment = TextAlignment::Leading
+        ) override;
+        void SetTransform(const Transform2D& transform) override;
+        void ResetTransform() override;
 
-        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
-        // Transformations
-        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
-        void SetTransform(const D2D1_MATRIX_3X2_F& transform);
-        void ResetTransform();
+        // Convenience for UI code drawing directly, outside a command list
+        void DrawCircle(
+            const Point& center,
+            float radius,
+            const Color& color,
+            bool filled = true,
+            float strokeWidth = 1.0f
+        );
 
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
         // Getters
@@ -108,23 +171,135 @@ namespace Spectrum {
         }
         int GetWidth() const noexcept { return m_width; }
         int GetHeight() const noexcept { return m_height; }
+        // Direct2D draw/fill calls issued during the last completed frame
+        size_t GetDrawCallCount() const noexcept { return m_lastFrameDrawCalls; }
+        const ResourceCacheStats& GetCacheStats() const noexcept { return m_cacheStats; }
+        void ResetCacheStats() noexcept { m_cacheStats = {}; }
 
     private:
+        // Stop collections are device resources, so the brushes built on
+        // them are kept alongside and only repositioned per draw
+        struct GradientCacheEntry {
+            std::vector<GradientStop> stops;
+            wrl::ComPtr<ID2D1GradientStopCollection> collection;
+            wrl::ComPtr<ID2D1LinearGradientBrush> linearBrush;
+            wrl::ComPtr<ID2D1RadialGradientBrush> radialBrush;
+            uint64_t lastUsedFrame = 0;
+        };
+
+        // Path geometry is factory-owned and survives device loss
+        struct GeometryCacheEntry {
+            wrl::ComPtr<ID2D1PathGeometry> geometry;
+            uint32_t revision = 0;
+            bool filled = false;
+            bool closed = false;
+            uint64_t lastUsedFrame = 0;
+        };
+
+        // GPU copy of a RetainedImage; when its revision moves only the
+        // rows written since are copied again
+        struct ImageCacheEntry {
+            wrl::ComPtr<ID2D1Bitmap> bitmap;
+            D2D1_SIZE_U size = {};
+            uint32_t revision = 0;
+            uint64_t lastUsedFrame = 0;
+        };
+
+        // DirectWrite objects are factory-owned and survive device loss
+        struct TextFormatCacheEntry {
+            wrl::ComPtr<IDWriteTextFormat> format;
+            uint64_t lastUsedFrame = 0;
+        };
+
+        struct TextLayoutCacheEntry {
+            std::wstring text;
+            float fontSize = 0.0f;
+            TextAlignment alignment = TextAlignment::Leading;
+            wrl::ComPtr<IDWriteTextLayout> layout;
+            uint64_t lastUsedFrame = 0;
+        };
+
+        // Offscreen target plus the bitmap it renders into, at the pixel
+        // size of the target the layer was last drawn to
+        struct LayerCacheEntry {
+            wrl::ComPtr<ID2D1BitmapRenderTarget> target;
+            wrl::ComPtr<ID2D1Bitmap> bitmap;
+            D2D1_SIZE_U size = {};
+            uint32_t revision = 0;
+            uint64_t lastUsedFrame = 0;
+        };
+
         bool CreateDeviceResources();
         void DiscardDeviceResources();
         ID2D1SolidColorBrush* GetSolidBrush(const Color& color);
+        bool CreateGradientStops(
+            const GradientStop* stops,
+            size_t stopCount,
+            wrl::ComPtr<ID2D1GradientStopCollection>& out
+        );
+        bool CreatePathGeometry(
+            const Point* points,
+            size_t count,
+            bool filled,
+            bool closed,
+            wrl::ComPtr<ID2D1PathGeometry>& out
+        );
+        GradientCacheEntry* GetGradientEntry(const GradientStop* stops, size_t stopCount);
+        ID2D1PathGeometry* GetRetainedGeometry(
+            GeometryHandle handle,
+            const Point* points,
+            size_t count,
+            bool filled,
+            bool closed
+        );
+        IDWriteTextFormat* GetTextFormat(float fontSize, TextAlignment alignment);
+        IDWriteTextLayout* GetTextLayout(
+            std::wstring_view text,
+            float fontSize,
+            TextAlignment alignment
+        );
+        bool RenderLayer(
+            ID2D1RenderTarget* parent,
+            LayerCacheEntry& entry,
+            LayerHandle handle,
+            const RenderCommandList& content
+        );
+        void TrimResourceCaches();
+        bool OpenBatchGeometry(
+            wrl::ComPtr<ID2D1PathGeometry>& geometry,
+            wrl::ComPtr<ID2D1GeometrySink>& sink
+        );
 
         HWND m_hwnd;
         int  m_width;
         int  m_height;
+        bool m_vsync;
 
         wrl::ComPtr<ID2D1Factory>          m_d2dFactory;
         wrl::ComPtr<ID2D1HwndRenderTarget> m_renderTarget;
         wrl::ComPtr<ID2D1SolidColorBrush>  m_solidBrush;
         wrl::ComPtr<IDWriteFactory>        m_writeFactory;
 
-        wrl::ComPtr<ID2D1LinearGradientBrush> m_linearBrush;
-        wrl::ComPtr<ID2D1RadialGradientBrush> m_radialBrush;
+        // Where draw calls land: the window, or a layer being rendered
+        ID2D1RenderTarget* m_drawTarget;
+
+        std::unordered_map<uint64_t, GradientCacheEntry> m_gradientCache;
+        std::unordered_map<uint32_t, GeometryCacheEntry> m_geometryCache;
+        std::unordered_map<uint32_t, LayerCacheEntry> m_layerCache;
+        std::unordered_map<uint32_t, ImageCacheEntry> m_imageCache;
+        std::unordered_map<uint64_t, TextFormatCacheEntry> m_textFormatCache;
+        std::unordered_map<uint64_t, TextLayoutCacheEntry> m_textLayoutCache;
+        wrl::ComPtr<ID2D1PathGeometry> m_transientGeometry;
+        std::vector<D2D1_GRADIENT_STOP> m_stopScratch;
+
+        wrl::ComPtr<ID2D1BitmapRenderTarget> m_sceneTarget;
+        D2D1_SIZE_U m_sceneSize;
+        float m_renderScale;
+
+        uint64_t m_frameIndex;
+        size_t m_drawCallCount;
+        size_t m_lastFrameDrawCalls;
+        ResourceCacheStats m_cacheStats;
     };
 
 }
@@ -0,0 +1,26 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// IAudioCaptureCallback.h: Receives the samples a capture session delivers.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#ifndef SPECTRUM_CPP_IAUDIO_CAPTURE_CALLBACK_H
+#define SPECTRUM_CPP_IAUDIO_CAPTURE_CALLBACK_H
+
+#include "Common.h"
+
+namespace Spectrum {
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Interface for receiving audio data callbacks.
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    class IAudioCaptureCallback {
+    public:
+        virtual ~IAudioCaptureCallback() = default;
+        virtual void OnAudioData(
+            const float* data,
+            size_t samples,
+            int channels
+        ) = 0;
+    };
+
+}
+
+#endif
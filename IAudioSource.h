@@ -8,6 +8,9 @@
 
 namespace Spectrum {
 
+    class SpectrumHistory;
+    class SpectrumView;
+
     class IAudioSource {
     public:
         virtual ~IAudioSource() = default;
@@ -16,6 +19,28 @@ namespace Spectrum {
         virtual void Update(float deltaTime) = 0;
         virtual SpectrumData GetSpectrum() = 0;
 
+        // Changes whenever GetSpectrum() would return different data
+        virtual uint64_t GetSpectrumVersion() const = 0;
+
+        // Bars as of `time`, blended between published spectra when the
+        // source keeps a history. Returns true while the result still
+        // changes as time advances.
+        virtual bool GetInterpolatedSpectrum(
+            std::chrono::steady_clock::time_point time,
+            SpectrumData& out
+        ) {
+            out = GetSpectrum();
+            return false;
+        }
+
+        // Recent spectra in publish order; null when the source keeps none
+        virtual const SpectrumHistory* GetSpectrumHistory() const { return nullptr; }
+
+        // A further bar configuration fed from this source's own analysis,
+        // owned by the source until removed; null when it cannot add one
+        virtual SpectrumView* AddSpectrumView(size_t barCount, SpectrumScale scaleType) { return nullptr; }
+        virtual void RemoveSpectrumView(const SpectrumView* view) {}
+
         virtual void SetAmplification(float amp) {}
         virtual void SetBarCount(size_t count) {}
         virtual void SetFFTWindow(FFTWindowType type) {}
@@ -23,6 +48,9 @@ namespace Spectrum {
 
         virtual void StartCapture() {}
         virtual void StopCapture() {}
+
+        // Invoked from the capture thread when new samples arrive
+        virtual void SetDataListener(std::function<void()> listener) {}
     };
 
 }
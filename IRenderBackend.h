@@ -0,0 +1,164 @@
+// =-=-=-=-=-=-=-=-=-=-=
+// IRenderBackend.h
+// =-=-=-=-=-=-=-=-=-=-=
+
+#ifndef SPECTRUM_CPP_IRENDER_BACKEND_H
+#define SPECTRUM_CPP_IRENDER_BACKEND_H
+
+#include "Common.h"
+
+namespace Spectrum {
+
+    class RenderCommandList;
+    class RetainedImage;
+
+    // Drawing surface a recorded RenderCommandList is replayed into.
+    // Uses only backend-neutral types so renderers never touch D2D directly.
+    class IRenderBackend {
+    public:
+        virtual ~IRenderBackend() = default;
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Drawing Primitives
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        virtual void DrawRectangle(
+            const Rect& rect,
+            const Color& color,
+            bool filled = true,
+            float strokeWidth = 1.0f
+        ) = 0;
+        virtual void DrawRoundedRectangle(
+            const Rect& rect,
+            float radius,
+            const Color& color,
+            bool filled = true,
+            float strokeWidth = 1.0f
+        ) = 0;
+        virtual void DrawEllipse(
+            const Point& center,
+            float radiusX,
+            float radiusY,
+            const Color& color,
+            bool filled = true,
+            float strokeWidth = 1.0f
+        ) = 0;
+        virtual void DrawLine(
+            const Point& start,
+            const Point& end,
+            const Color& color,
+            float strokeWidth = 1.0f
+        ) = 0;
+        virtual void DrawPolyline(
+            const Point* points,
+            size_t count,
+            const Color& color,
+            float strokeWidth = 1.0f
+        ) = 0;
+        virtual void DrawPolygon(
+            const Point* points,
+            size_t count,
+            const Color& color,
+            bool filled = true,
+            float strokeWidth = 1.0f
+        ) = 0;
+        // Points are always supplied; backends that retain geometry only
+        // rebuild it when the handle's revision changes
+        virtual void DrawGeometry(
+            GeometryHandle handle,
+            const Point* points,
+            size_t count,
+            bool closed,
+            const Color& color,
+            bool filled = true,
+            float strokeWidth = 1.0f
+        ) = 0;
+        // Draws one geometry once per instance, in order. Backends that
+        // retain geometry build it at most once for the whole call; strokes
+        // scale with each instance transform as they do under SetTransform.
+        virtual void DrawGeometryInstances(
+            GeometryHandle handle,
+            const Point* points,
+            size_t count,
+            bool closed,
+            const GeometryInstance* instances,
+            size_t instanceCount,
+            bool filled = true
+        ) = 0;
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Batched Fills
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Many solid shapes of one color submitted as a single draw
+        virtual void FillRectangles(
+            const Rect* rects,
+            size_t count,
+            const Color& color
+        ) = 0;
+        // Each ellipse is the one inscribed in its bounding rect
+        virtual void FillEllipses(
+            const Rect* bounds,
+            size_t count,
+            const Color& color
+        ) = 0;
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Gradients
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        virtual void DrawGradientRectangle(
+            const Rect& rect,
+            const GradientStop* stops,
+            size_t stopCount,
+            bool horizontal = true
+        ) = 0;
+        virtual void DrawRadialGradient(
+            const Point& center,
+            float radius,
+            const GradientStop* stops,
+            size_t stopCount
+        ) = 0;
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Images
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // The source texel region (the whole image when empty) is stretched
+        // over destination with nearest sampling. Backends that keep a
+        // texture upload again only when the handle's revision changes, and
+        // then only the rows the image reports dirty since their copy.
+        virtual void DrawImage(
+            const RetainedImage& image,
+            const Rect& destination,
+            const Rect& source = Rect()
+        ) = 0;
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Retained Layers
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Replays content into a target-sized offscreen surface only when
+        // the handle's revision changes, then composites that surface.
+        // Layers are in device space and ignore the current transform.
+        virtual void DrawLayer(
+            LayerHandle handle,
+            const RenderCommandList& content
+        ) = 0;
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Text
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        virtual void DrawText(
+            std::wstring_view text,
+            const Point& position,
+            const Color& color,
+            float fontSize = 12.0f,
+            TextAlignment alignment = TextAlignment::Leading
+        ) = 0;
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Transformations
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        virtual void SetTransform(const Transform2D& transform) = 0;
+        virtual void ResetTransform() = 0;
+    };
+
+}
+
+#endif
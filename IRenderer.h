@@ -6,16 +6,24 @@
 #define SPECTRUM_CPP_IRENDERER_H
 
 #include "Common.h"
-#include "GraphicsContext.h"
+#include "IRenderBackend.h"
 
 namespace Spectrum {
 
+    class FrameArena;
+    class SpectrumHistory;
+
     class IRenderer {
     public:
         virtual ~IRenderer() = default;
 
-        // Main rendering function
-        virtual void Render(GraphicsContext& context, const SpectrumData& spectrum) = 0;
+        // Main rendering function; deltaTime is the wall time since the
+        // previous frame in seconds
+        virtual void Render(
+            IRenderBackend& backend,
+            const SpectrumData& spectrum,
+            float deltaTime
+        ) = 0;
 
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
         // Configuration
@@ -31,6 +39,14 @@ namespace Spectrum {
         virtual std::string_view GetName() const = 0;
         virtual bool SupportsPrimaryColor() const { return true; }
 
+        // True when rendering the same spectrum again would draw the same
+        // frame, so the caller may skip it
+        virtual bool IsSettled() const { return false; }
+
+        // Bar count this style reads best at when it has a window of its
+        // own; 0 draws whatever the main window draws
+        virtual size_t GetPreferredBarCount() const { return 0; }
+
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
         // Lifecycle
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
@@ -39,6 +55,14 @@ namespace Spectrum {
 
         // Called when the renderer is no longer active
         virtual void OnDeactivate() {}
+
+        // Scratch memory for one frame, reset by the owner before each
+        // Render call; must outlive the renderer's use of it
+        virtual void SetFrameArena(FrameArena* arena) {}
+
+        // Spectra published since earlier frames, for renderers that draw
+        // over time; may be null or change between frames
+        virtual void SetSpectrumHistory(const SpectrumHistory* history) {}
     };
 
 }
@@ -24,7 +24,7 @@ namespace Spectrum {
 
     void InputManager::PollKeys() {
         const std::vector<int> keysToPoll = {
-            VK_SPACE, 'A', 'R', 'Q', 'O', 'S',
+            VK_SPACE, 'A', 'R', 'Q', 'O', 'S', 'F', 'G', 'V',
             VK_UP, VK_DOWN, VK_LEFT, VK_RIGHT,
             VK_SUBTRACT, VK_OEM_MINUS,
             VK_ADD, VK_OEM_PLUS,
@@ -84,6 +84,15 @@ namespace Spectrum {
         case 'O':
             m_actionQueue.push_back(InputAction::ToggleOverlay);
             break;
+        case 'F':
+            m_actionQueue.push_back(InputAction::CycleFrameRate);
+            break;
+        case 'G':
+            m_actionQueue.push_back(InputAction::ToggleQualityGovernor);
+            break;
+        case 'V':
+            m_actionQueue.push_back(InputAction::OpenView);
+            break;
         case VK_ESCAPE:
             m_actionQueue.push_back(InputAction::Exit);
             break;
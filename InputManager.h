@@ -6,7 +6,7 @@
 #ifndef SPECTRUM_CPP_INPUT_MANAGER_H
 #define SPECTRUM_CPP_INPUT_MANAGER_H
 
-#include "Common.h"
+#include "Win32Common.h"
 #include <map>
 #include <vector>
 
@@ -37,13 +37,13 @@ namespace Spectrum {
         constexpr float GRADIENT_INTENSITY_BOOST_OVERLAY = 0.95f;
 
         // Base gradient colors and positions for the bars
-        const std::vector<D2D1_GRADIENT_STOP> BAR_GRADIENT_STOPS_BASE = {
-            { 0.00f, D2D1::ColorF(0.f, 240 / 255.f, 120 / 255.f) },
-            { 0.55f, D2D1::ColorF(0.f, 255 / 255.f, 0 / 255.f) },
-            { 0.55f, D2D1::ColorF(255 / 255.f, 235 / 255.f, 0.f) },
-            { 0.80f, D2D1::ColorF(255 / 255.f, 185 / 255.f, 0.f) },
-            { 0.80f, D2D1::ColorF(255 / 255.f, 85 / 255.f, 0.f) },
-            { 1.00f, D2D1::ColorF(255 / 255.f, 35 / 255.f, 0.f) }
+        const std::vector<GradientStop> BAR_GRADIENT_STOPS_BASE = {
+            { 0.00f, Color(0.f, 240 / 255.f, 120 / 255.f) },
+            { 0.55f, Color(0.f, 255 / 255.f, 0 / 255.f) },
+            { 0.55f, Color(255 / 255.f, 235 / 255.f, 0.f) },
+            { 0.80f, Color(255 / 255.f, 185 / 255.f, 0.f) },
+            { 0.80f, Color(255 / 255.f, 85 / 255.f, 0.f) },
+            { 1.00f, Color(255 / 255.f, 35 / 255.f, 0.f) }
         };
 
         const Color PEAK_COLOR = Color::White();
@@ -54,7 +54,10 @@ namespace Spectrum {
     // Class Implementation
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 
-    KenwoodBarsRenderer::KenwoodBarsRenderer() {
+    KenwoodBarsRenderer::KenwoodBarsRenderer()
+        : m_isSettled(false) {
+        // Keeps peak hold and fall identical at any frame rate
+        SetFixedTimestep(FRAME_TIME);
         UpdateSettings();
     }
 
@@ -78,13 +81,18 @@ namespace Spectrum {
         float deltaTime
     ) {
         EnsurePeakArraySize(spectrum.size());
+        m_isSettled = true;
         for (size_t i = 0; i < spectrum.size(); ++i) {
             UpdatePeak(i, spectrum[i], deltaTime);
+            // A peak resting on its bar or the floor no longer moves
+            if (m_peaks[i] > spectrum[i] && m_peaks[i] > 0.0f) {
+                m_isSettled = false;
+            }
         }
     }
 
     void KenwoodBarsRenderer::DoRender(
-        GraphicsContext& context,
+        RenderCommandList& commands,
         const SpectrumData& spectrum
     ) {
         auto layout = RenderUtils::ComputeBarLayout(spectrum.size(), 2.0f, m_width);
@@ -92,14 +100,14 @@ namespace Spectrum {
 
         RenderData data = CalculateRenderData(spectrum, layout);
 
-        RenderMainLayer(context, data, layout);
-        RenderPeakLayer(context, data, layout);
+        RenderMainLayer(commands, data, layout);
+        RenderPeakLayer(commands, data, layout);
 
         if (m_currentSettings.useOutline) {
-            RenderOutlineLayer(context, data, layout);
+            RenderOutlineLayer(commands, data, layout);
         }
         if (m_currentSettings.useEnhancedPeaks) {
-            RenderPeakEnhancementLayer(context, data);
+            RenderPeakEnhancementLayer(commands, data);
         }
     }
 
@@ -107,9 +115,11 @@ namespace Spectrum {
         const SpectrumData& spectrum,
         const RenderUtils::BarLayout& layout
     ) {
-        RenderData data;
-        data.bars.reserve(spectrum.size());
-        data.peaks.reserve(spectrum.size());
+        FrameArena& arena = GetFrameArena();
+        RenderData data{
+            ArenaVector<BarData>(arena, spectrum.size()),
+            ArenaVector<PeakData>(arena, spectrum.size())
+        };
 
         float peakHeight = m_isOverlay ? PEAK_HEIGHT_OVERLAY : PEAK_HEIGHT;
 
@@ -126,7 +136,7 @@ namespace Spectrum {
                     layout.barWidth,
                     barHeight
                 );
-                data.bars.push_back({ barRect, magnitude });
+                data.bars.PushBack({ barRect, magnitude });
             }
 
             float peakValue = GetPeakValue(i);
@@ -138,18 +148,18 @@ namespace Spectrum {
                     layout.barWidth,
                     peakHeight
                 );
-                data.peaks.push_back({ peakRect });
+                data.peaks.PushBack({ peakRect });
             }
         }
         return data;
     }
 
     void KenwoodBarsRenderer::RenderMainLayer(
-        GraphicsContext& context,
+        RenderCommandList& commands,
         const RenderData& data,
         const RenderUtils::BarLayout& layout
     ) {
-        if (data.bars.empty()) return;
+        if (data.bars.IsEmpty()) return;
 
         float cornerRadius = m_currentSettings.useRoundCorners
             ? layout.barWidth * (m_isOverlay ? CORNER_RADIUS_RATIO_OVERLAY : CORNER_RADIUS_RATIO)
@@ -160,19 +170,26 @@ namespace Spectrum {
                 ? GRADIENT_INTENSITY_BOOST_OVERLAY
                 : GRADIENT_INTENSITY_BOOST;
 
-            std::vector<D2D1_GRADIENT_STOP> adjustedStops;
-            adjustedStops.reserve(BAR_GRADIENT_STOPS_BASE.size());
+            ArenaVector<GradientStop> adjustedStops(
+                GetFrameArena(),
+                BAR_GRADIENT_STOPS_BASE.size()
+            );
 
             for (const auto& stop : BAR_GRADIENT_STOPS_BASE) {
-                D2D1_GRADIENT_STOP newStop = stop;
+                GradientStop newStop = stop;
                 newStop.color.r = std::min(1.0f, stop.color.r * intensityBoost);
                 newStop.color.g = std::min(1.0f, stop.color.g * intensityBoost);
                 newStop.color.b = std::min(1.0f, stop.color.b * intensityBoost);
-                adjustedStops.push_back(newStop);
+                adjustedStops.PushBack(newStop);
             }
 
             for (const auto& bar : data.bars) {
-                context.DrawGradientRectangle(bar.rect, adjustedStops, false);
+                commands.DrawGradientRectangle(
+                    bar.rect,
+                    adjustedStops.GetData(),
+                    adjustedStops.GetSize(),
+                    false
+                );
             }
         }
         else {
@@ -180,17 +197,17 @@ namespace Spectrum {
             Color solidColor = Color::FromRGB(0, 240, 120);
             for (const auto& bar : data.bars) {
                 if (cornerRadius > 0) {
-                    context.DrawRoundedRectangle(bar.rect, cornerRadius, solidColor, true);
+                    commands.DrawRoundedRectangle(bar.rect, cornerRadius, solidColor, true);
                 }
                 else {
-                    context.DrawRectangle(bar.rect, solidColor, true);
+                    commands.DrawRectangle(bar.rect, solidColor, true);
                 }
             }
         }
     }
 
     void KenwoodBarsRenderer::RenderOutlineLayer(
-        GraphicsContext& context,
+        RenderCommandList& commands,
         const RenderData& data,
         const RenderUtils::BarLayout& layout
     ) {
@@ -205,20 +222,20 @@ namespace Spectrum {
             Color outlineColor(1.0f, 1.0f, 1.0f, alpha);
 
             if (cornerRadius > 0.0f) {
-                context.DrawRoundedRectangle(bar.rect, cornerRadius, outlineColor, false, outlineWidth);
+                commands.DrawRoundedRectangle(bar.rect, cornerRadius, outlineColor, false, outlineWidth);
             }
             else {
-                context.DrawRectangle(bar.rect, outlineColor, false, outlineWidth);
+                commands.DrawRectangle(bar.rect, outlineColor, false, outlineWidth);
             }
         }
     }
 
     void KenwoodBarsRenderer::RenderPeakLayer(
-        GraphicsContext& context,
+        RenderCommandList& commands,
         const RenderData& data,
         const RenderUtils::BarLayout& layout
     ) {
-        if (data.peaks.empty()) return;
+        if (data.peaks.IsEmpty()) return;
 
         float cornerRadius = m_currentSettings.useRoundCorners
             ? (layout.barWidth * (m_isOverlay ? CORNER_RADIUS_RATIO_OVERLAY : CORNER_RADIUS_RATIO)) * 0.5f
@@ -226,16 +243,16 @@ namespace Spectrum {
 
         for (const auto& peak : data.peaks) {
             if (cornerRadius > 0.0f) {
-                context.DrawRoundedRectangle(peak.rect, cornerRadius, PEAK_COLOR, true);
+                commands.DrawRoundedRectangle(peak.rect, cornerRadius, PEAK_COLOR, true);
             }
             else {
-                context.DrawRectangle(peak.rect, PEAK_COLOR, true);
+                commands.DrawRectangle(peak.rect, PEAK_COLOR, true);
             }
         }
     }
 
     void KenwoodBarsRenderer::RenderPeakEnhancementLayer(
-        GraphicsContext& context,
+        RenderCommandList& commands,
         const RenderData& data
     ) {
         float outlineWidth = (m_isOverlay ? OUTLINE_WIDTH_OVERLAY : OUTLINE_WIDTH) * 0.75f;
@@ -244,13 +261,13 @@ namespace Spectrum {
         outlineColor.a = baseAlpha;
 
         for (const auto& peak : data.peaks) {
-            context.DrawLine(
+            commands.DrawLine(
                 { peak.rect.x, peak.rect.y },
                 { peak.rect.GetRight(), peak.rect.y },
                 outlineColor,
                 outlineWidth
             );
-            context.DrawLine(
+            commands.DrawLine(
                 { peak.rect.x, peak.rect.GetBottom() },
                 { peak.rect.GetRight(), peak.rect.GetBottom() },
                 outlineColor,
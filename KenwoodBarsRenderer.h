@@ -21,6 +21,8 @@ namespace Spectrum {
         RenderStyle GetStyle() const override { return RenderStyle::KenwoodBars; }
         std::string_view GetName() const override { return "Kenwood Bars"; }
         bool SupportsPrimaryColor() const override { return false; }
+        bool IsSettled() const override { return m_isSettled; }
+        size_t GetPreferredBarCount() const override { return 128; }
 
     protected:
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
@@ -34,7 +36,7 @@ namespace Spectrum {
         ) override;
 
         void DoRender(
-            GraphicsContext& context,
+            RenderCommandList& commands,
             const SpectrumData& spectrum
         ) override;
 
@@ -56,9 +58,10 @@ namespace Spectrum {
         struct PeakData {
             Rect rect;
         };
+        // Lives in the frame arena; valid until the next frame
         struct RenderData {
-            std::vector<BarData> bars;
-            std::vector<PeakData> peaks;
+            ArenaVector<BarData> bars;
+            ArenaVector<PeakData> peaks;
         };
 
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
@@ -77,22 +80,22 @@ namespace Spectrum {
         // Drawing Helpers
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
         void RenderMainLayer(
-            GraphicsContext& context,
+            RenderCommandList& commands,
             const RenderData& data,
             const RenderUtils::BarLayout& layout
         );
         void RenderOutlineLayer(
-            GraphicsContext& context,
+            RenderCommandList& commands,
             const RenderData& data,
             const RenderUtils::BarLayout& layout
         );
         void RenderPeakLayer(
-            GraphicsContext& context,
+            RenderCommandList& commands,
             const RenderData& data,
             const RenderUtils::BarLayout& layout
         );
         void RenderPeakEnhancementLayer(
-            GraphicsContext& context,
+            RenderCommandList& commands,
             const RenderData& data
         );
 
@@ -102,6 +105,7 @@ namespace Spectrum {
         QualitySettings m_currentSettings;
         std::vector<float> m_peaks;
         std::vector<float> m_peakTimers;
+        bool m_isSettled;
     };
 
 }
@@ -22,6 +22,7 @@ namespace Spectrum {
         constexpr float PEAK_STROKE_WIDTH = 2.0f;
         constexpr float PEAK_RADIUS_OFFSET = 2.0f;
         constexpr float PEAK_DECAY_RATE = 0.95f;
+        constexpr float SETTLED_EPSILON = 1e-3f;
         constexpr float MIN_VALUE_THRESHOLD = 0.05f;
         constexpr float TOP_LED_BRIGHTNESS_BOOST = 1.2f;
         constexpr float EXTERNAL_COLOR_BLEND = 0.7f;
@@ -29,6 +30,11 @@ namespace Spectrum {
         constexpr int MIN_GRID_SIZE = 10;
         constexpr int MAX_COLUMNS = 64;
 
+        // Lit LEDs snap to this many brightness steps. A row's LEDs then
+        // share a few colors across columns and batch into a few fills,
+        // where a continuous level gave every column a color of its own.
+        constexpr float BRIGHTNESS_LEVELS = 8.0f;
+
         const std::vector<Color> SPECTRUM_GRADIENT = {
             Color::FromRGB(0, 200, 100), Color::FromRGB(0, 255, 0),
             Color::FromRGB(128, 255, 0), Color::FromRGB(255, 255, 0),
@@ -44,10 +50,19 @@ namespace Spectrum {
     // Class Implementation
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 
-    LedPanelRenderer::LedPanelRenderer() {
+    LedPanelRenderer::LedPanelRenderer()
+        : m_isSettled(false) {
+        m_gradientLut.SetStops(SPECTRUM_GRADIENT);
+        // Attack and decay rates are per step
+        SetFixedTimestep(FRAME_TIME);
         UpdateSettings();
     }
 
+    void LedPanelRenderer::SetPrimaryColor(const Color& color) {
+        BaseRenderer::SetPrimaryColor(color);
+        if (m_grid.rows > 0) InitializeColorGradient();
+    }
+
     void LedPanelRenderer::UpdateSettings() {
         if (m_isOverlay) {
             switch (m_quality) {
@@ -70,11 +85,13 @@ namespace Spectrum {
         const SpectrumData& spectrum,
         float deltaTime
     ) {
+        m_isSettled = false;
         if (m_grid.columns == 0) return;
         UpdateValues(spectrum);
         for (int i = 0; i < m_grid.columns; ++i) {
             UpdatePeak(i, deltaTime);
         }
+        m_isSettled = AreValuesSettled(spectrum);
     }
 
     void LedPanelRenderer::UpdateGridIfNeeded(size_t barCount) {
@@ -121,6 +138,7 @@ namespace Spectrum {
         m_grid = { rows, columns, cellSize, startX, startY };
         CacheLedPositions();
         InitializeColorGradient();
+        InvalidateStaticLayer();
     }
 
     void LedPanelRenderer::CacheLedPositions() {
@@ -137,29 +155,23 @@ namespace Spectrum {
         }
     }
 
+    // Bakes the gradient and the primary color blend into one color per
+    // row, so drawing an LED is a table read
     void LedPanelRenderer::InitializeColorGradient() {
+        bool useExternalColor = (m_primaryColor.r != 1.f
+            || m_primaryColor.g != 1.f
+            || m_primaryColor.b != 1.f);
+
         m_rowColors.resize(m_grid.rows);
         for (int i = 0; i < m_grid.rows; ++i) {
             float t = (m_grid.rows > 1)
                 ? static_cast<float>(i) / (m_grid.rows - 1)
                 : 0.0f;
-            m_rowColors[i] = InterpolateGradient(t);
-        }
-    }
-
-    Color LedPanelRenderer::InterpolateGradient(float t) {
-        float scaledT = t * (SPECTRUM_GRADIENT.size() - 1);
-        int index = static_cast<int>(scaledT);
-        float fraction = scaledT - index;
-
-        if (index >= static_cast<int>(SPECTRUM_GRADIENT.size()) - 1) {
-            return SPECTRUM_GRADIENT.back();
+            m_rowColors[i] = m_gradientLut.GetColor(t);
+            if (useExternalColor) {
+                m_rowColors[i] = BlendWithExternalColor(m_rowColors[i], t);
+            }
         }
-        return Utils::InterpolateColor(
-            SPECTRUM_GRADIENT[index],
-            SPECTRUM_GRADIENT[index + 1],
-            fraction
-        );
     }
 
     void LedPanelRenderer::UpdateValues(const SpectrumData& spectrum) {
@@ -180,6 +192,20 @@ namespace Spectrum {
         m_smoothedValues[column] = Utils::Lerp(current, target, rate);
     }
 
+    bool LedPanelRenderer::AreValuesSettled(const SpectrumData& spectrum) const {
+        size_t count = std::min(spectrum.size(), m_smoothedValues.size());
+        for (size_t i = 0; i < count; ++i) {
+            if (std::abs(m_smoothedValues[i] - spectrum[i]) > SETTLED_EPSILON) {
+                return false;
+            }
+            if (m_settings.usePeakHold
+                && m_peakValues[i] - m_smoothedValues[i] > SETTLED_EPSILON) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     void LedPanelRenderer::UpdatePeak(int column, float deltaTime) {
         if (!m_settings.usePeakHold) return;
 
@@ -196,7 +222,7 @@ namespace Spectrum {
     }
 
     void LedPanelRenderer::DoRender(
-        GraphicsContext& context,
+        RenderCommandList& commands,
         const SpectrumData& spectrum
     ) {
         UpdateGridIfNeeded(spectrum.size());
@@ -208,26 +234,35 @@ namespace Spectrum {
             m_peakTimers.assign(m_grid.columns, 0.0f);
         }
 
-        RenderInactiveLeds(context);
-        RenderActiveLeds(context);
+        DrawStaticLayer(commands);
+        RenderActiveLeds(commands);
         if (m_settings.usePeakHold) {
-            RenderPeakLeds(context);
+            RenderPeakLeds(commands);
         }
     }
 
-    void LedPanelRenderer::RenderInactiveLeds(GraphicsContext& context) {
+    // The unlit grid never changes between layout updates
+    void LedPanelRenderer::RenderStaticLayer(RenderCommandList& commands) {
+        RenderInactiveLeds(commands);
+    }
+
+    void LedPanelRenderer::RenderInactiveLeds(RenderCommandList& commands) {
         Color color = INACTIVE_COLOR;
         color.a = INACTIVE_ALPHA;
         if (m_isOverlay) color.a *= OVERLAY_PADDING_FACTOR;
 
+        // Every inactive LED shares one color, so the whole grid is one fill
+        commands.BeginBatch();
         for (int col = 0; col < m_grid.columns; ++col) {
             for (int row = 0; row < m_grid.rows; ++row) {
-                context.DrawCircle(m_ledPositions[col][row], LED_RADIUS, color, true);
+                commands.DrawCircle(m_ledPositions[col][row], LED_RADIUS, color, true);
             }
         }
+        commands.EndBatch();
     }
 
-    void LedPanelRenderer::RenderActiveLeds(GraphicsContext& context) {
+    void LedPanelRenderer::RenderActiveLeds(RenderCommandList& commands) {
+        commands.BeginBatch();
         for (int col = 0; col < m_grid.columns; ++col) {
             float value = m_smoothedValues[col];
             int activeLeds = static_cast<int>(value * m_grid.rows);
@@ -242,19 +277,22 @@ namespace Spectrum {
                     brightness *= TOP_LED_BRIGHTNESS_BOOST;
                 }
 
-                Color ledColor = GetLedColor(row, Utils::Saturate(brightness));
-                context.DrawCircle(m_ledPositions[col][row], LED_RADIUS, ledColor, true);
+                brightness = std::ceil(Utils::Saturate(brightness) * BRIGHTNESS_LEVELS)
+                    / BRIGHTNESS_LEVELS;
+                Color ledColor = GetLedColor(row, brightness);
+                commands.DrawCircle(m_ledPositions[col][row], LED_RADIUS, ledColor, true);
             }
         }
+        commands.EndBatch();
     }
 
-    void LedPanelRenderer::RenderPeakLeds(GraphicsContext& context) {
+    void LedPanelRenderer::RenderPeakLeds(RenderCommandList& commands) {
         for (int col = 0; col < m_grid.columns; ++col) {
             if (m_peakTimers[col] <= 0.0f) continue;
 
             int peakRow = static_cast<int>(m_peakValues[col] * m_grid.rows) - 1;
             if (peakRow >= 0 && peakRow < m_grid.rows) {
-                context.DrawCircle(
+                commands.DrawCircle(
                     m_ledPositions[col][peakRow],
                     LED_RADIUS + PEAK_RADIUS_OFFSET,
                     PEAK_COLOR,
@@ -272,17 +310,6 @@ namespace Spectrum {
             static_cast<int>(m_rowColors.size()) - 1
         );
         Color baseColor = m_rowColors[rowIndex];
-
-        bool useExternalColor = (m_primaryColor.r != 1.f
-            || m_primaryColor.g != 1.f
-            || m_primaryColor.b != 1.f);
-        if (useExternalColor) {
-            float t = (m_rowColors.size() > 1)
-                ? static_cast<float>(row) / (m_rowColors.size() - 1)
-                : 0.0f;
-            baseColor = BlendWithExternalColor(baseColor, t);
-        }
-
         baseColor.a = brightness;
         return baseColor;
     }
@@ -6,6 +6,7 @@
 #define SPECTRUM_CPP_LED_PANEL_RENDERER_H
 
 #include "BaseRenderer.h"
+#include "PaletteLut.h"
 
 namespace Spectrum {
 
@@ -20,6 +21,9 @@ namespace Spectrum {
         RenderStyle GetStyle() const override { return RenderStyle::LedPanel; }
         std::string_view GetName() const override { return "LED Panel"; }
         bool SupportsPrimaryColor() const override { return true; }
+        bool IsSettled() const override { return m_isSettled; }
+        size_t GetPreferredBarCount() const override { return 32; }
+        void SetPrimaryColor(const Color& color) override;
 
     protected:
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
@@ -31,9 +35,10 @@ namespace Spectrum {
             float deltaTime
         ) override;
         void DoRender(
-            GraphicsContext& context,
+            RenderCommandList& commands,
             const SpectrumData& spectrum
         ) override;
+        void RenderStaticLayer(RenderCommandList& commands) override;
 
     private:
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
@@ -69,17 +74,17 @@ namespace Spectrum {
         void UpdateValues(const SpectrumData& spectrum);
         void UpdateSmoothing(int column, float target);
         void UpdatePeak(int column, float deltaTime);
+        bool AreValuesSettled(const SpectrumData& spectrum) const;
 
         Color GetLedColor(int row, float brightness) const;
-        static Color InterpolateGradient(float t);
         Color BlendWithExternalColor(Color baseColor, float t) const;
 
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
         // Drawing Helpers
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
-        void RenderInactiveLeds(GraphicsContext& context);
-        void RenderActiveLeds(GraphicsContext& context);
-        void RenderPeakLeds(GraphicsContext& context);
+        void RenderInactiveLeds(RenderCommandList& commands);
+        void RenderActiveLeds(RenderCommandList& commands);
+        void RenderPeakLeds(RenderCommandList& commands);
 
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
         // Member State
@@ -92,7 +97,11 @@ namespace Spectrum {
         std::vector<float> m_peakTimers;
 
         std::vector<std::vector<Point>> m_ledPositions;
+
+        // Final per-row colors, rebuilt only on layout or color changes
         std::vector<Color> m_rowColors;
+        PaletteLut m_gradientLut;
+        bool m_isSettled;
     };
 }
 
@@ -1,7 +1,7 @@
 #ifndef SPECTRUM_CPP_MAINWINDOW_H
 #define SPECTRUM_CPP_MAINWINDOW_H
 
-#include "Common.h"
+#include "Win32Common.h"
 
 namespace Spectrum {
 
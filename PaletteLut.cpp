@@ -0,0 +1,48 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// PaletteLut.cpp: Implementation of the PaletteLut class.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#include "PaletteLut.h"
+#include "Utils.h"
+
+namespace Spectrum {
+
+    namespace {
+        bool SameColor(const Color& a, const Color& b) {
+            return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+        }
+    }
+
+    PaletteLut::PaletteLut()
+        : m_pixels{}, m_revision(0) {
+    }
+
+    void PaletteLut::SetStops(const Color* stops, size_t count) {
+        if (!stops || count == 0) return;
+
+        if (count == m_stops.size()
+            && std::equal(stops, stops + count, m_stops.begin(), SameColor)) {
+            return;
+        }
+
+        const size_t last = count - 1;
+        Generate([&](float t) {
+            if (last == 0) return stops[0];
+
+            const float scaled = t * last;
+            const size_t i1 = std::min(static_cast<size_t>(scaled), last);
+            const size_t i2 = std::min(i1 + 1, last);
+            return Utils::InterpolateColor(
+                stops[i1],
+                stops[i2],
+                scaled - static_cast<float>(i1)
+            );
+        });
+        m_stops.assign(stops, stops + count);
+    }
+
+    void PaletteLut::Store(size_t index, const Color& color) {
+        m_colors[index] = color;
+        m_pixels[index] = Utils::ColorToPremultipliedARGB(color);
+    }
+
+}
@@ -0,0 +1,61 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// PaletteLut.h: Precomputed intensity-to-color table for palette renderers.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#ifndef SPECTRUM_CPP_PALETTE_LUT_H
+#define SPECTRUM_CPP_PALETTE_LUT_H
+
+#include "Common.h"
+
+namespace Spectrum {
+
+    // Samples a palette at SIZE evenly spaced intensities, both as Color
+    // for command recording and as premultiplied BGRA for pixel writers.
+    // Lookups are a single index; the float blending only runs when the
+    // palette is rebuilt.
+    class PaletteLut {
+    public:
+        static constexpr size_t SIZE = 256;
+
+        PaletteLut();
+
+        // Evenly spaced stops, linearly blended. Does nothing when the
+        // stops match the previous call.
+        void SetStops(const Color* stops, size_t count);
+        void SetStops(const std::vector<Color>& stops) {
+            SetStops(stops.data(), stops.size());
+        }
+
+        // Fills every entry from colorAt(t), t in [0, 1]; always rebuilds
+        template <typename Generator>
+        void Generate(Generator&& colorAt) {
+            m_stops.clear();
+            for (size_t i = 0; i < SIZE; ++i) {
+                Store(i, colorAt(static_cast<float>(i) / (SIZE - 1)));
+            }
+            ++m_revision;
+        }
+
+        static size_t ToIndex(float t) noexcept {
+            t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+            return static_cast<size_t>(t * (SIZE - 1) + 0.5f);
+        }
+
+        const Color& GetColor(float t) const noexcept { return m_colors[ToIndex(t)]; }
+        uint32_t GetPixel(float t) const noexcept { return m_pixels[ToIndex(t)]; }
+        const uint32_t* GetPixels() const noexcept { return m_pixels.data(); }
+
+        // Bumped on every rebuild so dependents can refresh lazily
+        uint32_t GetRevision() const noexcept { return m_revision; }
+
+    private:
+        void Store(size_t index, const Color& color);
+
+        std::array<Color, SIZE> m_colors;
+        std::array<uint32_t, SIZE> m_pixels;
+        std::vector<Color> m_stops;
+        uint32_t m_revision;
+    };
+
+}
+
+#endif
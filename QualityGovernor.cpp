@@ -0,0 +1,118 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// QualityGovernor.cpp: Implementation of the QualityGovernor class.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#include "QualityGovernor.h"
+#include <limits>
+
+namespace Spectrum {
+
+    namespace {
+        // Ladder rungs below Low quality
+        constexpr float RENDER_SCALES[] = { 1.0f, 0.75f, 0.5f };
+
+        constexpr int WINDOW_FRAMES = 20;
+
+        // Mean work above the budget steps down; below this share of it
+        // counts towards stepping up
+        constexpr float UPSHIFT_HEADROOM = 0.6f;
+        constexpr int UPSHIFT_CALM_WINDOWS = 6;
+        constexpr int MAX_UPSHIFT_BACKOFF = 8;
+
+        // Caches and layers rebuild after a change; those frames say
+        // nothing about the new level
+        constexpr int SETTLE_FRAMES = 10;
+
+        constexpr int NO_RECENT_UPSHIFT = std::numeric_limits<int>::max();
+    }
+
+    QualityGovernor::QualityGovernor()
+        : m_enabled(true),
+        m_ceiling(RenderQuality::High),
+        m_level(0),
+        m_windowSumMs(0.0f),
+        m_windowFrames(0),
+        m_settleFrames(0),
+        m_calmWindows(0),
+        m_upshiftBackoff(1),
+        m_windowsSinceUpshift(NO_RECENT_UPSHIFT) {
+    }
+
+    void QualityGovernor::SetEnabled(bool enabled) {
+        if (m_enabled == enabled) return;
+        m_enabled = enabled;
+        m_upshiftBackoff = 1;
+        m_windowsSinceUpshift = NO_RECENT_UPSHIFT;
+        SetLevel(0);
+    }
+
+    void QualityGovernor::SetCeiling(RenderQuality quality) {
+        if (m_ceiling == quality) return;
+        m_ceiling = quality;
+        m_upshiftBackoff = 1;
+        m_windowsSinceUpshift = NO_RECENT_UPSHIFT;
+        SetLevel(0);
+    }
+
+    bool QualityGovernor::AddSample(float workMs, float budgetMs) {
+        if (!m_enabled || budgetMs <= 0.0f) return false;
+
+        if (m_settleFrames > 0) {
+            --m_settleFrames;
+            return false;
+        }
+
+        m_windowSumMs += workMs;
+        if (++m_windowFrames < WINDOW_FRAMES) return false;
+
+        const float meanMs = m_windowSumMs / m_windowFrames;
+        m_windowSumMs = 0.0f;
+        m_windowFrames = 0;
+        if (m_windowsSinceUpshift != NO_RECENT_UPSHIFT) ++m_windowsSinceUpshift;
+
+        if (meanMs > budgetMs) {
+            m_calmWindows = 0;
+            if (m_level >= GetMaxLevel()) return false;
+
+            // Undoing a recent step up: wait longer before the next try
+            if (m_windowsSinceUpshift <= UPSHIFT_CALM_WINDOWS * m_upshiftBackoff) {
+                m_upshiftBackoff = std::min(m_upshiftBackoff * 2, MAX_UPSHIFT_BACKOFF);
+            }
+            SetLevel(m_level + 1);
+            return true;
+        }
+
+        if (meanMs >= budgetMs * UPSHIFT_HEADROOM || m_level == 0) {
+            m_calmWindows = 0;
+            return false;
+        }
+
+        if (++m_calmWindows < UPSHIFT_CALM_WINDOWS * m_upshiftBackoff) return false;
+
+        m_windowsSinceUpshift = 0;
+        SetLevel(m_level - 1);
+        return true;
+    }
+
+    RenderQuality QualityGovernor::GetQuality() const noexcept {
+        const int ceiling = static_cast<int>(m_ceiling);
+        return static_cast<RenderQuality>(ceiling - std::min(m_level, ceiling));
+    }
+
+    float QualityGovernor::GetRenderScale() const noexcept {
+        const int rung = std::max(0, m_level - static_cast<int>(m_ceiling));
+        return RENDER_SCALES[rung];
+    }
+
+    int QualityGovernor::GetMaxLevel() const noexcept {
+        return static_cast<int>(m_ceiling) + static_cast<int>(std::size(RENDER_SCALES)) - 1;
+    }
+
+    void QualityGovernor::SetLevel(int level) {
+        m_level = std::clamp(level, 0, GetMaxLevel());
+        m_windowSumMs = 0.0f;
+        m_windowFrames = 0;
+        m_calmWindows = 0;
+        m_settleFrames = SETTLE_FRAMES;
+    }
+
+}
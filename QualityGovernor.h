@@ -0,0 +1,57 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// QualityGovernor.h: Trades render quality and resolution for frame time.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#ifndef SPECTRUM_CPP_QUALITY_GOVERNOR_H
+#define SPECTRUM_CPP_QUALITY_GOVERNOR_H
+
+#include "Common.h"
+
+namespace Spectrum {
+
+    // Watches how long each frame's rendering work takes against a budget
+    // and steps down a ladder: first RenderQuality from the user's choice
+    // towards Low, then the internal render scale. Stepping down reacts
+    // within a fraction of a second; stepping back up needs a long calm
+    // stretch, and a step up that had to be undone soon after makes the
+    // next attempt wait longer, so the level does not oscillate.
+    class QualityGovernor {
+    public:
+        QualityGovernor();
+
+        void SetEnabled(bool enabled);
+        bool IsEnabled() const noexcept { return m_enabled; }
+
+        // The user's quality; the governor never goes above it. A new
+        // ceiling restarts from the top of the ladder.
+        void SetCeiling(RenderQuality quality);
+
+        // Feeds one presented frame. Returns true when the quality or
+        // render scale changed and should be applied.
+        bool AddSample(float workMs, float budgetMs);
+
+        // Getters
+        RenderQuality GetQuality() const noexcept;
+        float GetRenderScale() const noexcept;
+        int GetLevel() const noexcept { return m_level; }
+
+    private:
+        int GetMaxLevel() const noexcept;
+        void SetLevel(int level);
+
+        bool m_enabled;
+        RenderQuality m_ceiling;
+        int m_level;
+
+        // Current evaluation window
+        float m_windowSumMs;
+        int m_windowFrames;
+
+        int m_settleFrames;      // Samples ignored after a change
+        int m_calmWindows;       // Consecutive windows well under budget
+        int m_upshiftBackoff;    // Multiplies the calm stretch needed
+        int m_windowsSinceUpshift;
+    };
+
+}
+
+#endif
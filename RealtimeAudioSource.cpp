@@ -12,6 +12,7 @@ namespace Spectrum {
         m_analyzer->SetSmoothing(m_config.smoothing);
         m_analyzer->SetFFTWindow(m_config.windowType);
         m_analyzer->SetScaleType(m_config.scaleType);
+        m_analyzer->SetResampling(m_config.resampleInput, m_config.internalSampleRate);
     }
 
     bool RealtimeAudioSource::Initialize() {
@@ -31,6 +32,29 @@ namespace Spectrum {
         return m_analyzer->GetSpectrum();
     }
 
+    uint64_t RealtimeAudioSource::GetSpectrumVersion() const {
+        return m_analyzer->GetSpectrumVersion();
+    }
+
+    bool RealtimeAudioSource::GetInterpolatedSpectrum(
+        std::chrono::steady_clock::time_point time,
+        SpectrumData& out
+    ) {
+        return m_analyzer->GetInterpolatedSpectrum(time, out);
+    }
+
+    const SpectrumHistory* RealtimeAudioSource::GetSpectrumHistory() const {
+        return &m_analyzer->GetHistory();
+    }
+
+    SpectrumView* RealtimeAudioSource::AddSpectrumView(size_t barCount, SpectrumScale scaleType) {
+        return m_analyzer->AddView(barCount, scaleType);
+    }
+
+    void RealtimeAudioSource::RemoveSpectrumView(const SpectrumView* view) {
+        m_analyzer->RemoveView(view);
+    }
+
     void RealtimeAudioSource::StartCapture() {
         if (m_isCapturing) return;
 
@@ -65,6 +89,7 @@ namespace Spectrum {
             LOG_ERROR("Failed to re-initialize audio capture device.");
             return;
         }
+        m_analyzer->SetSampleRate(static_cast<size_t>(m_audioCapture->GetSampleRate()));
         m_audioCapture->SetCallback(m_analyzer.get());
         LOG_INFO("Audio capture device initialized successfully.");
     }
@@ -74,4 +99,8 @@ namespace Spectrum {
     void RealtimeAudioSource::SetFFTWindow(FFTWindowType type) { m_analyzer->SetFFTWindow(type); }
     void RealtimeAudioSource::SetScaleType(SpectrumScale type) { m_analyzer->SetScaleType(type); }
 
+    void RealtimeAudioSource::SetDataListener(std::function<void()> listener) {
+        m_analyzer->SetDataListener(std::move(listener));
+    }
+
 }
\ No newline at end of file
@@ -17,6 +17,14 @@ namespace Spectrum {
         bool Initialize() override;
         void Update(float deltaTime) override;
         SpectrumData GetSpectrum() override;
+        uint64_t GetSpectrumVersion() const override;
+        bool GetInterpolatedSpectrum(
+            std::chrono::steady_clock::time_point time,
+            SpectrumData& out
+        ) override;
+        const SpectrumHistory* GetSpectrumHistory() const override;
+        SpectrumView* AddSpectrumView(size_t barCount, SpectrumScale scaleType) override;
+        void RemoveSpectrumView(const SpectrumView* view) override;
 
         void SetAmplification(float amp) override;
         void SetBarCount(size_t count) override;
@@ -25,12 +33,14 @@ namespace Spectrum {
 
         void StartCapture() override;
         void StopCapture() override;
+        void SetDataListener(std::function<void()> listener) override;
 
     private:
         void ReinitializeCapture();
 
-        std::unique_ptr<AudioCapture> m_audioCapture;
+        // Declared first so it outlives the capture thread that writes into it
         std::unique_ptr<SpectrumAnalyzer> m_analyzer;
+        std::unique_ptr<AudioCapture> m_audioCapture;
         AudioConfig m_config;
         bool m_isCapturing = false;
     };
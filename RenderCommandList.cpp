@@ -0,0 +1,761 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// RenderCommandList.cpp: Recording and replay of backend-neutral draw commands.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#include "RenderCommandList.h"
+#include "RetainedLayer.h"
+#include "Utils.h"
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+namespace Spectrum {
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Command Layout
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    namespace {
+        constexpr size_t COMMAND_ALIGNMENT = 8;
+
+        constexpr size_t AlignUp(size_t value) noexcept {
+            return (value + COMMAND_ALIGNMENT - 1) & ~(COMMAND_ALIGNMENT - 1);
+        }
+
+        // Size covers the command, its payload and padding to the next one
+        struct CommandHeader {
+            RenderCommandType type;
+            uint32_t size;
+        };
+
+        struct RectCommand {
+            CommandHeader header;
+            Rect rect;
+            Color color;
+            float radius;
+            float strokeWidth;
+            bool filled;
+        };
+
+        struct EllipseCommand {
+            CommandHeader header;
+            Point center;
+            float radiusX;
+            float radiusY;
+            Color color;
+            float strokeWidth;
+            bool filled;
+        };
+
+        struct LineCommand {
+            CommandHeader header;
+            Point start;
+            Point end;
+            Color color;
+            float strokeWidth;
+        };
+
+        // Followed by count Points
+        struct PointsCommand {
+            CommandHeader header;
+            Color color;
+            float strokeWidth;
+            uint32_t count;
+            bool filled;
+        };
+
+        // Followed by stopCount GradientStops
+        struct GradientCommand {
+            CommandHeader header;
+            Rect rect;
+            Point center;
+            float radius;
+            uint32_t stopCount;
+            bool horizontal;
+        };
+
+        // Followed by length wchar_t, not null-terminated
+        struct TextCommand {
+            CommandHeader header;
+            Point position;
+            Color color;
+            float fontSize;
+            uint32_t length;
+            TextAlignment alignment;
+        };
+
+        struct TransformCommand {
+            CommandHeader header;
+            Transform2D transform;
+        };
+
+        // Followed by count Points
+        struct GeometryCommand {
+            CommandHeader header;
+            GeometryHandle handle;
+            Color color;
+            float strokeWidth;
+            uint32_t count;
+            bool closed;
+            bool filled;
+        };
+
+        // Followed by count Points, then instanceCount GeometryInstances
+        struct GeometryInstancesCommand {
+            CommandHeader header;
+            GeometryHandle handle;
+            uint32_t count;
+            uint32_t instanceCount;
+            bool closed;
+            bool filled;
+        };
+
+        // The image is referenced, not copied; it lives in its owner
+        struct ImageCommand {
+            CommandHeader header;
+            const RetainedImage* image;
+            Rect destination;
+            Rect source;
+        };
+
+        // Content is referenced, not copied; it lives in the layer owner
+        struct LayerCommand {
+            CommandHeader header;
+            LayerHandle handle;
+            const RenderCommandList* content;
+        };
+
+        // Followed by count Rects
+        struct FillCommand {
+            CommandHeader header;
+            Color color;
+            uint32_t count;
+        };
+
+        constexpr size_t MIN_BUCKET_SLOTS = 64;
+
+        // Buckets are keyed on the color as it will be rasterized
+        uint32_t PackColorKey(const Color& color) noexcept {
+            auto toByte = [](float v) noexcept {
+                return static_cast<uint32_t>(Utils::Saturate(v) * 255.0f + 0.5f);
+            };
+            return (toByte(color.a) << 24) | (toByte(color.r) << 16) |
+                (toByte(color.g) << 8) | toByte(color.b);
+        }
+
+        // Fibonacci hashing; the high bits are the well mixed ones
+        size_t BucketSlotFor(uint32_t key, size_t mask) noexcept {
+            return static_cast<size_t>((key * 0x9E3779B1u) >> 16) & mask;
+        }
+
+        template <typename Command>
+        constexpr size_t PayloadOffset() noexcept {
+            static_assert(std::is_trivially_copyable_v<Command>);
+            static_assert(alignof(Command) <= COMMAND_ALIGNMENT);
+            return AlignUp(sizeof(Command));
+        }
+
+        template <typename Payload, typename Command>
+        const Payload* PayloadOf(const Command& command) noexcept {
+            return reinterpret_cast<const Payload*>(
+                reinterpret_cast<const uint8_t*>(&command) + PayloadOffset<Command>()
+                );
+        }
+
+        template <typename Command>
+        const Command& CommandAt(const uint8_t* data) noexcept {
+            return *reinterpret_cast<const Command*>(data);
+        }
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Class Implementation
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    void RenderCommandList::Clear() noexcept {
+        m_buffer.clear();
+        m_commandCount = 0;
+
+        for (size_t i = 0; i < m_activeBucketCount; ++i) {
+            m_batchBuckets[i].rects.clear();
+            m_batchBuckets[i].ellipses.clear();
+        }
+        ReleaseBuckets();
+        m_batchedShapeCount = 0;
+        m_batchDepth = 0;
+    }
+
+    void RenderCommandList::EndBatch() {
+        if (m_batchDepth == 0) return;
+        if (--m_batchDepth == 0) FlushBatch();
+    }
+
+    template <typename Command>
+    Command* RenderCommandList::Append(
+        RenderCommandType type,
+        const void* payload,
+        size_t payloadBytes,
+        const void* extra,
+        size_t extraBytes
+    ) {
+        const size_t offset = m_buffer.size();
+        const size_t payloadOffset = PayloadOffset<Command>();
+        const size_t totalSize = AlignUp(payloadOffset + payloadBytes + extraBytes);
+
+        m_buffer.resize(offset + totalSize);
+        uint8_t* base = m_buffer.data() + offset;
+
+        auto* command = new (base) Command{};
+        command->header.type = type;
+        command->header.size = static_cast<uint32_t>(totalSize);
+
+        if (payloadBytes > 0) {
+            std::memcpy(base + payloadOffset, payload, payloadBytes);
+        }
+        if (extraBytes > 0) {
+            std::memcpy(base + payloadOffset + payloadBytes, extra, extraBytes);
+        }
+
+        ++m_commandCount;
+        return command;
+    }
+
+    void RenderCommandList::Execute(IRenderBackend& backend) const {
+        const uint8_t* data = m_buffer.data();
+        const uint8_t* end = data + m_buffer.size();
+
+        while (data < end) {
+            const auto& header = CommandAt<CommandHeader>(data);
+
+            switch (header.type) {
+            case RenderCommandType::Rectangle: {
+                const auto& c = CommandAt<RectCommand>(data);
+                backend.DrawRectangle(c.rect, c.color, c.filled, c.strokeWidth);
+                break;
+            }
+            case RenderCommandType::RoundedRectangle: {
+                const auto& c = CommandAt<RectCommand>(data);
+                backend.DrawRoundedRectangle(
+                    c.rect, c.radius, c.color, c.filled, c.strokeWidth
+                );
+                break;
+            }
+            case RenderCommandType::Ellipse: {
+                const auto& c = CommandAt<EllipseCommand>(data);
+                backend.DrawEllipse(
+                    c.center, c.radiusX, c.radiusY, c.color, c.filled, c.strokeWidth
+                );
+                break;
+            }
+            case RenderCommandType::Line: {
+                const auto& c = CommandAt<LineCommand>(data);
+                backend.DrawLine(c.start, c.end, c.color, c.strokeWidth);
+                break;
+            }
+            case RenderCommandType::Polyline: {
+                const auto& c = CommandAt<PointsCommand>(data);
+                backend.DrawPolyline(
+                    PayloadOf<Point>(c), c.count, c.color, c.strokeWidth
+                );
+                break;
+            }
+            case RenderCommandType::Polygon: {
+                const auto& c = CommandAt<PointsCommand>(data);
+                backend.DrawPolygon(
+                    PayloadOf<Point>(c), c.count, c.color, c.filled, c.strokeWidth
+                );
+                break;
+            }
+            case RenderCommandType::GradientRectangle: {
+                const auto& c = CommandAt<GradientCommand>(data);
+                backend.DrawGradientRectangle(
+                    c.rect, PayloadOf<GradientStop>(c), c.stopCount, c.horizontal
+                );
+                break;
+            }
+            case RenderCommandType::RadialGradient: {
+                const auto& c = CommandAt<GradientCommand>(data);
+                backend.DrawRadialGradient(
+                    c.center, c.radius, PayloadOf<GradientStop>(c), c.stopCount
+                );
+                break;
+            }
+            case RenderCommandType::Text: {
+                const auto& c = CommandAt<TextCommand>(data);
+                backend.DrawText(
+                    std::wstring_view(PayloadOf<wchar_t>(c), c.length),
+                    c.position,
+                    c.color,
+                    c.fontSize,
+                    c.alignment
+                );
+                break;
+            }
+            case RenderCommandType::SetTransform:
+                backend.SetTransform(CommandAt<TransformCommand>(data).transform);
+                break;
+            case RenderCommandType::ResetTransform:
+                backend.ResetTransform();
+                break;
+            case RenderCommandType::FillRectangles: {
+                const auto& c = CommandAt<FillCommand>(data);
+                backend.FillRectangles(PayloadOf<Rect>(c), c.count, c.color);
+                break;
+            }
+            case RenderCommandType::FillEllipses: {
+                const auto& c = CommandAt<FillCommand>(data);
+                backend.FillEllipses(PayloadOf<Rect>(c), c.count, c.color);
+                break;
+            }
+            case RenderCommandType::Image: {
+                const auto& c = CommandAt<ImageCommand>(data);
+                backend.DrawImage(*c.image, c.destination, c.source);
+                break;
+            }
+            case RenderCommandType::Layer: {
+                const auto& c = CommandAt<LayerCommand>(data);
+                backend.DrawLayer(c.handle, *c.content);
+                break;
+            }
+            case RenderCommandType::Geometry: {
+                const auto& c = CommandAt<GeometryCommand>(data);
+                backend.DrawGeometry(
+                    c.handle,
+                    PayloadOf<Point>(c),
+                    c.count,
+                    c.closed,
+                    c.color,
+                    c.filled,
+                    c.strokeWidth
+                );
+                break;
+            }
+            case RenderCommandType::GeometryInstances: {
+                const auto& c = CommandAt<GeometryInstancesCommand>(data);
+                const Point* points = PayloadOf<Point>(c);
+                backend.DrawGeometryInstances(
+                    c.handle,
+                    points,
+                    c.count,
+                    c.closed,
+                    reinterpret_cast<const GeometryInstance*>(points + c.count),
+                    c.instanceCount,
+                    c.filled
+                );
+                break;
+            }
+            }
+
+            data += header.size;
+        }
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Recording
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    void RenderCommandList::DrawRectangle(
+        const Rect& rect,
+        const Color& color,
+        bool filled,
+        float strokeWidth
+    ) {
+        if (filled && m_batchDepth > 0) {
+            GetBatchBucket(color).rects.push_back(rect);
+            return;
+        }
+
+        FlushBatch();
+        auto* c = Append<RectCommand>(RenderCommandType::Rectangle);
+        c->rect = rect;
+        c->color = color;
+        c->strokeWidth = strokeWidth;
+        c->filled = filled;
+    }
+
+    void RenderCommandList::DrawRoundedRectangle(
+        const Rect& rect,
+        float radius,
+        const Color& color,
+        bool filled,
+        float strokeWidth
+    ) {
+        FlushBatch();
+        auto* c = Append<RectCommand>(RenderCommandType::RoundedRectangle);
+        c->rect = rect;
+        c->color = color;
+        c->radius = radius;
+        c->strokeWidth = strokeWidth;
+        c->filled = filled;
+    }
+
+    void RenderCommandList::DrawEllipse(
+        const Point& center,
+        float radiusX,
+        float radiusY,
+        const Color& color,
+        bool filled,
+        float strokeWidth
+    ) {
+        if (filled && m_batchDepth > 0) {
+            GetBatchBucket(color).ellipses.push_back({
+                center.x - radiusX, center.y - radiusY,
+                radiusX * 2.0f, radiusY * 2.0f
+            });
+            return;
+        }
+
+        FlushBatch();
+        auto* c = Append<EllipseCommand>(RenderCommandType::Ellipse);
+        c->center = center;
+        c->radiusX = radiusX;
+        c->radiusY = radiusY;
+        c->color = color;
+        c->strokeWidth = strokeWidth;
+        c->filled = filled;
+    }
+
+    void RenderCommandList::DrawLine(
+        const Point& start,
+        const Point& end,
+        const Color& color,
+        float strokeWidth
+    ) {
+        FlushBatch();
+        auto* c = Append<LineCommand>(RenderCommandType::Line);
+        c->start = start;
+        c->end = end;
+        c->color = color;
+        c->strokeWidth = strokeWidth;
+    }
+
+    void RenderCommandList::DrawPolyline(
+        const Point* points,
+        size_t count,
+        const Color& color,
+        float strokeWidth
+    ) {
+        if (!points || count < 2) return;
+
+        FlushBatch();
+        auto* c = Append<PointsCommand>(
+            RenderCommandType::Polyline, points, count * sizeof(Point)
+        );
+        c->color = color;
+        c->strokeWidth = strokeWidth;
+        c->count = static_cast<uint32_t>(count);
+    }
+
+    void RenderCommandList::DrawPolygon(
+        const Point* points,
+        size_t count,
+        const Color& color,
+        bool filled,
+        float strokeWidth
+    ) {
+        if (!points || count < 3) return;
+
+        FlushBatch();
+        auto* c = Append<PointsCommand>(
+            RenderCommandType::Polygon, points, count * sizeof(Point)
+        );
+        c->color = color;
+        c->strokeWidth = strokeWidth;
+        c->count = static_cast<uint32_t>(count);
+        c->filled = filled;
+    }
+
+    void RenderCommandList::DrawGeometry(
+        GeometryHandle handle,
+        const Point* points,
+        size_t count,
+        bool closed,
+        const Color& color,
+        bool filled,
+        float strokeWidth
+    ) {
+        if (!points || count < 2) return;
+
+        FlushBatch();
+        auto* c = Append<GeometryCommand>(
+            RenderCommandType::Geometry, points, count * sizeof(Point)
+        );
+        c->handle = handle;
+        c->color = color;
+        c->strokeWidth = strokeWidth;
+        c->count = static_cast<uint32_t>(count);
+        c->closed = closed;
+        c->filled = filled;
+    }
+
+    void RenderCommandList::DrawGeometryInstances(
+        GeometryHandle handle,
+        const Point* points,
+        size_t count,
+        bool closed,
+        const GeometryInstance* instances,
+        size_t instanceCount,
+        bool filled
+    ) {
+        if (!points || count < 2 || !instances || instanceCount == 0) return;
+
+        static_assert(std::is_trivially_copyable_v<GeometryInstance>);
+        static_assert(alignof(GeometryInstance) <= alignof(Point));
+
+        FlushBatch();
+        const size_t pointBytes = count * sizeof(Point);
+        auto* c = Append<GeometryInstancesCommand>(
+            RenderCommandType::GeometryInstances,
+            points,
+            pointBytes,
+            instances,
+            instanceCount * sizeof(GeometryInstance)
+        );
+        c->handle = handle;
+        c->count = static_cast<uint32_t>(count);
+        c->instanceCount = static_cast<uint32_t>(instanceCount);
+        c->closed = closed;
+        c->filled = filled;
+    }
+
+    void RenderCommandList::DrawGradientRectangle(
+        const Rect& rect,
+        const GradientStop* stops,
+        size_t stopCount,
+        bool horizontal
+    ) {
+        if (!stops || stopCount == 0) return;
+
+        FlushBatch();
+        auto* c = Append<GradientCommand>(
+            RenderCommandType::GradientRectangle,
+            stops,
+            stopCount * sizeof(GradientStop)
+        );
+        c->rect = rect;
+        c->stopCount = static_cast<uint32_t>(stopCount);
+        c->horizontal = horizontal;
+    }
+
+    void RenderCommandList::DrawRadialGradient(
+        const Point& center,
+        float radius,
+        const GradientStop* stops,
+        size_t stopCount
+    ) {
+        if (!stops || stopCount == 0) return;
+
+        FlushBatch();
+        auto* c = Append<GradientCommand>(
+            RenderCommandType::RadialGradient,
+            stops,
+            stopCount * sizeof(GradientStop)
+        );
+        c->center = center;
+        c->radius = radius;
+        c->stopCount = static_cast<uint32_t>(stopCount);
+    }
+
+    void RenderCommandList::DrawImage(
+        const RetainedImage& image,
+        const Rect& destination,
+        const Rect& source
+    ) {
+        if (image.IsEmpty()) return;
+
+        FlushBatch();
+        auto* c = Append<ImageCommand>(RenderCommandType::Image);
+        c->image = &image;
+        c->destination = destination;
+        c->source = source;
+    }
+
+    void RenderCommandList::DrawLayer(
+        LayerHandle handle,
+        const RenderCommandList& content
+    ) {
+        if (&content == this) return;
+
+        FlushBatch();
+        auto* c = Append<LayerCommand>(RenderCommandType::Layer);
+        c->handle = handle;
+        c->content = &content;
+    }
+
+    void RenderCommandList::DrawLayer(const RetainedLayer& layer) {
+        DrawLayer(layer.GetHandle(), layer.GetContent());
+    }
+
+    void RenderCommandList::DrawText(
+        std::wstring_view text,
+        const Point& position,
+        const Color& color,
+        float fontSize,
+        TextAlignment alignment
+    ) {
+        if (text.empty()) return;
+
+        FlushBatch();
+        auto* c = Append<TextCommand>(
+            RenderCommandType::Text,
+            text.data(),
+            text.size() * sizeof(wchar_t)
+        );
+        c->position = position;
+        c->color = color;
+        c->fontSize = fontSize;
+        c->length = static_cast<uint32_t>(text.size());
+        c->alignment = alignment;
+    }
+
+    void RenderCommandList::SetTransform(const Transform2D& transform) {
+        FlushBatch();
+        Append<TransformCommand>(RenderCommandType::SetTransform)->transform = transform;
+    }
+
+    void RenderCommandList::ResetTransform() {
+        FlushBatch();
+        Append<TransformCommand>(RenderCommandType::ResetTransform);
+    }
+
+    void RenderCommandList::FillRectangles(
+        const Rect* rects,
+        size_t count,
+        const Color& color
+    ) {
+        if (!rects || count == 0) return;
+
+        if (m_batchDepth > 0) {
+            auto& bucket = GetBatchBucket(color).rects;
+            bucket.insert(bucket.end(), rects, rects + count);
+            return;
+        }
+
+        FlushBatch();
+        AppendFill(RenderCommandType::FillRectangles, rects, count, color);
+    }
+
+    void RenderCommandList::FillEllipses(
+        const Rect* bounds,
+        size_t count,
+        const Color& color
+    ) {
+        if (!bounds || count == 0) return;
+
+        if (m_batchDepth > 0) {
+            auto& bucket = GetBatchBucket(color).ellipses;
+            bucket.insert(bucket.end(), bounds, bounds + count);
+            return;
+        }
+
+        FlushBatch();
+        AppendFill(RenderCommandType::FillEllipses, bounds, count, color);
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Batching
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    void RenderCommandList::AppendFill(
+        RenderCommandType type,
+        const Rect* rects,
+        size_t count,
+        const Color& color
+    ) {
+        auto* c = Append<FillCommand>(type, rects, count * sizeof(Rect));
+        c->color = color;
+        c->count = static_cast<uint32_t>(count);
+    }
+
+    RenderCommandList::BatchBucket& RenderCommandList::GetBatchBucket(
+        const Color& color
+    ) {
+        const uint32_t key = PackColorKey(color);
+        ++m_batchedShapeCount;
+
+        // Runs of one color are the common case
+        if (m_activeBucketCount > 0 && m_batchBuckets[m_lastBucket].key == key) {
+            return m_batchBuckets[m_lastBucket];
+        }
+
+        // Keep the table at most half full
+        if ((m_activeBucketCount + 1) * 2 > m_bucketSlots.size()) {
+            GrowBucketSlots();
+        }
+
+        const size_t mask = m_bucketSlots.size() - 1;
+        size_t slot = BucketSlotFor(key, mask);
+        while (m_bucketSlots[slot] != 0) {
+            const size_t index = m_bucketSlots[slot] - 1;
+            if (m_batchBuckets[index].key == key) {
+                m_lastBucket = index;
+                return m_batchBuckets[index];
+            }
+            slot = (slot + 1) & mask;
+        }
+
+        if (m_activeBucketCount == m_batchBuckets.size()) {
+            m_batchBuckets.emplace_back();
+        }
+        const size_t index = m_activeBucketCount++;
+        auto& bucket = m_batchBuckets[index];
+        bucket.color = color;
+        bucket.key = key;
+        bucket.slot = static_cast<uint32_t>(slot);
+        m_bucketSlots[slot] = static_cast<uint32_t>(index + 1);
+        m_lastBucket = index;
+        return bucket;
+    }
+
+    // Only while warming up; the table then fits the busiest batch
+    void RenderCommandList::GrowBucketSlots() {
+        const size_t size = std::max(MIN_BUCKET_SLOTS, m_bucketSlots.size() * 2);
+        m_bucketSlots.assign(size, 0);
+
+        const size_t mask = size - 1;
+        for (size_t i = 0; i < m_activeBucketCount; ++i) {
+            auto& bucket = m_batchBuckets[i];
+            size_t slot = BucketSlotFor(bucket.key, mask);
+            while (m_bucketSlots[slot] != 0) slot = (slot + 1) & mask;
+            bucket.slot = static_cast<uint32_t>(slot);
+            m_bucketSlots[slot] = static_cast<uint32_t>(i + 1);
+        }
+    }
+
+    // Every used slot belongs to an active bucket, so clearing those empties
+    // the table without touching the rest of it
+    void RenderCommandList::ReleaseBuckets() noexcept {
+        for (size_t i = 0; i < m_activeBucketCount; ++i) {
+            m_bucketSlots[m_batchBuckets[i].slot] = 0;
+        }
+        m_activeBucketCount = 0;
+        m_lastBucket = 0;
+    }
+
+    // Buckets are emitted in order of first use, rectangles before ellipses
+    void RenderCommandList::FlushBatch() {
+        if (m_activeBucketCount == 0) return;
+
+        for (size_t i = 0; i < m_activeBucketCount; ++i) {
+            auto& bucket = m_batchBuckets[i];
+
+            if (!bucket.rects.empty()) {
+                AppendFill(
+                    RenderCommandType::FillRectangles,
+                    bucket.rects.data(),
+                    bucket.rects.size(),
+                    bucket.color
+                );
+                bucket.rects.clear();
+            }
+            if (!bucket.ellipses.empty()) {
+                AppendFill(
+                    RenderCommandType::FillEllipses,
+                    bucket.ellipses.data(),
+                    bucket.ellipses.size(),
+                    bucket.color
+                );
+                bucket.ellipses.clear();
+            }
+        }
+
+        ReleaseBuckets();
+    }
+
+}
@@ -0,0 +1,300 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// RenderCommandList.h: Linear arena of POD draw commands replayed by a backend.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#ifndef SPECTRUM_CPP_RENDER_COMMAND_LIST_H
+#define SPECTRUM_CPP_RENDER_COMMAND_LIST_H
+
+#include "IRenderBackend.h"
+#include "RetainedGeometry.h"
+#include "RetainedImage.h"
+#include <initializer_list>
+
+namespace Spectrum {
+
+    class RetainedLayer;
+
+    enum class RenderCommandType : uint8_t {
+        Rectangle = 0,
+        RoundedRectangle,
+        Ellipse,
+        Line,
+        Polyline,
+        Polygon,
+        GradientRectangle,
+        RadialGradient,
+        Text,
+        SetTransform,
+        ResetTransform,
+        FillRectangles,
+        FillEllipses,
+        Geometry,
+        Layer,
+        Image,
+        GeometryInstances
+    };
+
+    // Records draw calls instead of issuing them. Commands are trivially
+    // copyable structs packed back to back in one byte buffer; variable
+    // payloads (points, stops, text) follow their command inline. Clear()
+    // keeps the capacity, so steady-state recording does not allocate.
+    //
+    // Between BeginBatch() and EndBatch(), solid filled rectangles and
+    // ellipses are gathered into per-color buckets and recorded as one
+    // FillRectangles / FillEllipses command per color. Any other command
+    // flushes the pending buckets first, so painter's order is preserved
+    // against everything outside the batch. Inside it, shapes of different
+    // colors may be reordered, so batch only shapes that do not overlap.
+    class RenderCommandList final : public IRenderBackend {
+    public:
+        RenderCommandList() = default;
+
+        void Clear() noexcept;
+        void Execute(IRenderBackend& backend) const;
+
+        bool IsEmpty() const noexcept { return m_commandCount == 0; }
+        size_t GetCommandCount() const noexcept { return m_commandCount; }
+        size_t GetByteSize() const noexcept { return m_buffer.size(); }
+
+        // Scopes nest; buckets are flushed when the outermost one ends
+        void BeginBatch() noexcept { ++m_batchDepth; }
+        void EndBatch();
+
+        // Shapes folded into batched commands since the last Clear()
+        size_t GetBatchedShapeCount() const noexcept { return m_batchedShapeCount; }
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // IRenderBackend Implementation
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        void DrawRectangle(
+            const Rect& rect,
+            const Color& color,
+            bool filled = true,
+            float strokeWidth = 1.0f
+        ) override;
+        void DrawRoundedRectangle(
+            const Rect& rect,
+            float radius,
+            const Color& color,
+            bool filled = true,
+            float strokeWidth = 1.0f
+        ) override;
+        void DrawEllipse(
+            const Point& center,
+            float radiusX,
+            float radiusY,
+            const Color& color,
+            bool filled = true,
+            float strokeWidth = 1.0f
+        ) override;
+        void DrawLine(
+            const Point& start,
+            const Point& end,
+            const Color& color,
+            float strokeWidth = 1.0f
+        ) override;
+        void DrawPolyline(
+            const Point* points,
+            size_t count,
+            const Color& color,
+            float strokeWidth = 1.0f
+        ) override;
+        void DrawPolygon(
+            const Point* points,
+            size_t count,
+            const Color& color,
+            bool filled = true,
+            float strokeWidth = 1.0f
+        ) override;
+        void DrawGeometry(
+            GeometryHandle handle,
+            const Point* points,
+            size_t count,
+            bool closed,
+            const Color& color,
+            bool filled = true,
+            float strokeWidth = 1.0f
+        ) override;
+        void DrawGeometryInstances(
+            GeometryHandle handle,
+            const Point* points,
+            size_t count,
+            bool closed,
+            const GeometryInstance* instances,
+            size_t instanceCount,
+            bool filled = true
+        ) override;
+        void FillRectangles(
+            const Rect* rects,
+            size_t count,
+            const Color& color
+        ) override;
+        void FillEllipses(
+            const Rect* bounds,
+            size_t count,
+            const Color& color
+        ) override;
+        void DrawGradientRectangle(
+            const Rect& rect,
+            const GradientStop* stops,
+            size_t stopCount,
+            bool horizontal = true
+        ) override;
+        void DrawRadialGradient(
+            const Point& center,
+            float radius,
+            const GradientStop* stops,
+            size_t stopCount
+        ) override;
+        // The image must outlive Execute(); only a reference is recorded
+        void DrawImage(
+            const RetainedImage& image,
+            const Rect& destination,
+            const Rect& source = Rect()
+        ) override;
+        void DrawLayer(
+            LayerHandle handle,
+            const RenderCommandList& content
+        ) override;
+        void DrawText(
+            std::wstring_view text,
+            const Point& position,
+            const Color& color,
+            float fontSize = 12.0f,
+            TextAlignment alignment = TextAlignment::Leading
+        ) override;
+        void SetTransform(const Transform2D& transform) override;
+        void ResetTransform() override;
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Convenience Overloads
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        void DrawCircle(
+            const Point& center,
+            float radius,
+            const Color& color,
+            bool filled = true,
+            float strokeWidth = 1.0f
+        ) {
+            DrawEllipse(center, radius, radius, color, filled, strokeWidth);
+        }
+        void DrawPolyline(
+            const std::vector<Point>& points,
+            const Color& color,
+            float strokeWidth = 1.0f
+        ) {
+            DrawPolyline(points.data(), points.size(), color, strokeWidth);
+        }
+        void DrawPolygon(
+            const std::vector<Point>& points,
+            const Color& color,
+            bool filled = true,
+            float strokeWidth = 1.0f
+        ) {
+            DrawPolygon(points.data(), points.size(), color, filled, strokeWidth);
+        }
+        void DrawPolygon(
+            std::initializer_list<Point> points,
+            const Color& color,
+            bool filled = true,
+            float strokeWidth = 1.0f
+        ) {
+            DrawPolygon(points.begin(), points.size(), color, filled, strokeWidth);
+        }
+        void DrawGeometry(
+            const RetainedGeometry& geometry,
+            const Color& color,
+            bool filled = true,
+            float strokeWidth = 1.0f
+        ) {
+            DrawGeometry(
+                geometry.GetHandle(),
+                geometry.GetPoints(),
+                geometry.GetPointCount(),
+                geometry.IsClosed(),
+                color,
+                filled,
+                strokeWidth
+            );
+        }
+        void DrawGeometryInstances(
+            const RetainedGeometry& geometry,
+            const GeometryInstance* instances,
+            size_t instanceCount,
+            bool filled = true
+        ) {
+            DrawGeometryInstances(
+                geometry.GetHandle(),
+                geometry.GetPoints(),
+                geometry.GetPointCount(),
+                geometry.IsClosed(),
+                instances,
+                instanceCount,
+                filled
+            );
+        }
+        // The layer must outlive Execute(); only a reference is recorded
+        void DrawLayer(const RetainedLayer& layer);
+        void DrawGradientRectangle(
+            const Rect& rect,
+            const std::vector<GradientStop>& stops,
+            bool horizontal = true
+        ) {
+            DrawGradientRectangle(rect, stops.data(), stops.size(), horizontal);
+        }
+        void DrawRadialGradient(
+            const Point& center,
+            float radius,
+            const std::vector<GradientStop>& stops
+        ) {
+            DrawRadialGradient(center, radius, stops.data(), stops.size());
+        }
+
+    private:
+        struct BatchBucket {
+            Color color;
+            uint32_t key = 0;
+            uint32_t slot = 0;      // Its entry in m_bucketSlots
+            std::vector<Rect> rects;
+            std::vector<Rect> ellipses;
+        };
+
+        // Reserves a command plus its payload at the end of the arena;
+        // the extra bytes, if any, are packed right after the payload
+        template <typename Command>
+        Command* Append(
+            RenderCommandType type,
+            const void* payload = nullptr,
+            size_t payloadBytes = 0,
+            const void* extra = nullptr,
+            size_t extraBytes = 0
+        );
+        void AppendFill(
+            RenderCommandType type,
+            const Rect* rects,
+            size_t count,
+            const Color& color
+        );
+
+        BatchBucket& GetBatchBucket(const Color& color);
+        void GrowBucketSlots();
+        void ReleaseBuckets() noexcept;
+        void FlushBatch();
+
+        std::vector<uint8_t> m_buffer;
+        size_t m_commandCount = 0;
+
+        // Buckets stay allocated across frames; only the first
+        // m_activeBucketCount are in use. m_bucketSlots is an open-addressed
+        // table from color key to bucket index + 1 (0 marks a free slot),
+        // also kept across frames, so finding a bucket never allocates.
+        std::vector<BatchBucket> m_batchBuckets;
+        std::vector<uint32_t> m_bucketSlots;
+        size_t m_activeBucketCount = 0;
+        size_t m_lastBucket = 0;
+        size_t m_batchedShapeCount = 0;
+        int m_batchDepth = 0;
+    };
+
+}
+
+#endif
@@ -0,0 +1,142 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// RenderView.cpp: Implementation of the RenderView class.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#include "RenderView.h"
+#include "MainWindow.h"
+#include "GraphicsContext.h"
+#include "SpectrumView.h"
+#include "Utils.h"
+#include "WindowHelper.h"
+
+namespace Spectrum {
+
+    RenderView::RenderView(HINSTANCE hInstance, std::unique_ptr<IRenderer> renderer)
+        : m_hInstance(hInstance),
+        m_renderer(std::move(renderer)),
+        m_spectrumView(nullptr),
+        m_renderedVersion(0),
+        m_usesOwnSpectrum(false),
+        m_isSpectrumBlending(false),
+        m_isDeviceLost(false),
+        m_isClosed(false) {
+        m_renderer->SetFrameArena(&m_frameArena);
+    }
+
+    RenderView::~RenderView() = default;
+
+    bool RenderView::Initialize(int width, int height, void* userPtr) {
+        const std::wstring title = L"Spectrum View - "
+            + WindowUtils::StringToWString(std::string(m_renderer->GetName()));
+
+        m_window = std::make_unique<MainWindow>(m_hInstance);
+        if (!m_window->Initialize(title, width, height, false, userPtr)) {
+            return false;
+        }
+        if (!CreateGraphics()) return false;
+
+        m_window->Show();
+        return true;
+    }
+
+    bool RenderView::CreateGraphics() {
+        m_graphics.reset();
+        m_graphics = std::make_unique<GraphicsContext>(m_window->GetHwnd());
+        if (!m_graphics->Initialize()) return false;
+
+        m_renderer->OnActivate(m_graphics->GetWidth(), m_graphics->GetHeight());
+        return true;
+    }
+
+    void RenderView::Render(const SpectrumData& sharedSpectrum, float deltaTime) {
+        m_frameArena.Reset();
+        const SpectrumData& spectrum = m_usesOwnSpectrum ? m_spectrum : sharedSpectrum;
+
+        m_graphics->BeginDraw();
+        m_graphics->Clear(Color::FromRGB(13, 13, 26));
+        m_graphics->BeginScene();
+        m_renderer->Render(*m_graphics, spectrum, deltaTime);
+        m_graphics->EndScene();
+
+        // Recreating touches the window, so it waits for the window thread
+        if (m_graphics->EndDraw() == D2DERR_RECREATE_TARGET) {
+            m_isDeviceLost = true;
+        }
+    }
+
+    bool RenderView::RecoverLostDevice() {
+        if (!m_isDeviceLost) return false;
+        m_isDeviceLost = false;
+
+        if (!CreateGraphics()) {
+            LOG_ERROR("Failed to recreate graphics for a view window");
+            Close();
+        }
+        return true;
+    }
+
+    void RenderView::OnResize(int width, int height) {
+        if (m_graphics) m_graphics->Resize(width, height);
+        m_renderer->OnActivate(width, height);
+    }
+
+    void RenderView::SetQuality(RenderQuality quality) {
+        m_renderer->SetQuality(quality);
+    }
+
+    void RenderView::SetVSync(bool enabled) {
+        if (m_graphics) m_graphics->SetVSync(enabled);
+    }
+
+    // Runs on the window thread, so the view's history is handed over
+    // before any worker reads it
+    void RenderView::PrepareSpectrum(
+        bool useOwnBars,
+        std::chrono::steady_clock::time_point time,
+        const SpectrumHistory* sharedHistory
+    ) {
+        m_usesOwnSpectrum = useOwnBars && m_spectrumView;
+        if (!m_usesOwnSpectrum) {
+            m_isSpectrumBlending = false;
+            m_renderer->SetSpectrumHistory(sharedHistory);
+            return;
+        }
+
+        // Read before the data so a concurrent bump is caught next frame
+        m_renderedVersion = m_spectrumView->GetSpectrumVersion();
+        m_isSpectrumBlending = m_spectrumView->GetInterpolatedSpectrum(time, m_spectrum);
+        m_renderer->SetSpectrumHistory(&m_spectrumView->GetHistory());
+    }
+
+    // The shared spectrum is watched by the owner; own bars are watched here
+    bool RenderView::IsSettled() const {
+        if (m_usesOwnSpectrum) {
+            if (m_isSpectrumBlending) return false;
+            if (m_spectrumView->GetSpectrumVersion() != m_renderedVersion) return false;
+        }
+        return m_renderer->IsSettled();
+    }
+
+    bool RenderView::IsVisible() const {
+        if (m_isClosed || !m_graphics) return false;
+
+        HWND hwnd = GetHwnd();
+        if (!IsWindow(hwnd) || !IsWindowVisible(hwnd) || IsIconic(hwnd)) return false;
+
+        if (auto* rt = m_graphics->GetRenderTarget()) {
+            if (rt->CheckWindowState() & D2D1_WINDOW_STATE_OCCLUDED) return false;
+        }
+        return true;
+    }
+
+    HWND RenderView::GetHwnd() const {
+        return m_window ? m_window->GetHwnd() : nullptr;
+    }
+
+    // Hidden right away; the window itself goes when the owner drops the view
+    void RenderView::Close() {
+        if (m_isClosed) return;
+        m_isClosed = true;
+        if (m_window) m_window->Hide();
+    }
+
+}
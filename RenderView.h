@@ -0,0 +1,92 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// RenderView.h: An extra window drawing the spectrum with its own renderer.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#ifndef SPECTRUM_CPP_RENDER_VIEW_H
+#define SPECTRUM_CPP_RENDER_VIEW_H
+
+#include "Win32Common.h"
+#include "FrameArena.h"
+#include "IRenderer.h"
+
+namespace Spectrum {
+
+    class MainWindow;
+    class GraphicsContext;
+    class SpectrumView;
+
+    // Owns everything one frame of this window touches: the window, its
+    // graphics context, a renderer instance and the renderer's scratch
+    // arena. Nothing is shared with other views, so Render() may run on a
+    // worker thread next to other views and the main window. Everything
+    // else is called from the window thread while no Render() is running.
+    class RenderView {
+    public:
+        RenderView(HINSTANCE hInstance, std::unique_ptr<IRenderer> renderer);
+        ~RenderView();
+
+        RenderView(const RenderView&) = delete;
+        RenderView& operator=(const RenderView&) = delete;
+
+        // userPtr is handed to the window procedure like the main window's
+        bool Initialize(int width, int height, void* userPtr);
+
+        // Draws and presents one frame. The shared spectrum is only read,
+        // and only when PrepareSpectrum() did not pick the view's own bars.
+        void Render(const SpectrumData& sharedSpectrum, float deltaTime);
+
+        // Recreates the graphics context after Render() saw the device go
+        // away; returns true when it did
+        bool RecoverLostDevice();
+
+        void OnResize(int width, int height);
+        void SetQuality(RenderQuality quality);
+        void SetVSync(bool enabled);
+
+        // Bars at the renderer's preferred count, owned by the audio side;
+        // null draws the shared spectrum. The owner removes it from the
+        // analyzer once the view is closed.
+        void SetSpectrumView(SpectrumView* view) { m_spectrumView = view; }
+        SpectrumView* GetSpectrumView() const { return m_spectrumView; }
+        size_t GetPreferredBarCount() const { return m_renderer->GetPreferredBarCount(); }
+
+        // Picks this frame's bars: the bound view's as of `time` while
+        // useOwnBars is set, else the shared spectrum and sharedHistory
+        void PrepareSpectrum(
+            bool useOwnBars,
+            std::chrono::steady_clock::time_point time,
+            const SpectrumHistory* sharedHistory
+        );
+
+        // Shown, not minimized and not covered
+        bool IsVisible() const;
+        bool IsSettled() const;
+        RenderStyle GetStyle() const { return m_renderer->GetStyle(); }
+        std::string_view GetName() const { return m_renderer->GetName(); }
+        HWND GetHwnd() const;
+
+        // Set once the user asked to close it; the owner destroys it later
+        bool IsClosed() const { return m_isClosed; }
+        void Close();
+
+    private:
+        bool CreateGraphics();
+
+        HINSTANCE m_hInstance;
+        std::unique_ptr<MainWindow> m_window;
+        std::unique_ptr<GraphicsContext> m_graphics;
+        std::unique_ptr<IRenderer> m_renderer;
+        FrameArena m_frameArena;
+
+        SpectrumView* m_spectrumView;
+        SpectrumData m_spectrum;
+        uint64_t m_renderedVersion;
+        bool m_usesOwnSpectrum;
+        bool m_isSpectrumBlending;
+
+        bool m_isDeviceLost;
+        bool m_isClosed;
+    };
+
+}
+
+#endif
@@ -10,6 +10,7 @@
 #include "LedPanelRenderer.h"
 #include "GaugeRenderer.h"
 #include "KenwoodBarsRenderer.h"
+#include "WaterfallRenderer.h"
 
 
 #include "Utils.h"
@@ -19,8 +20,13 @@
 namespace Spectrum {
 
     // RendererManager holds window manager to get graphics context for activation
-    RendererManager::RendererManager(EventBus* bus, WindowManager* windowManager)
+    RendererManager::RendererManager(
+        EventBus* bus,
+        WindowManager* windowManager,
+        TaskScheduler* scheduler
+    )
         : m_windowManager(windowManager)
+        , m_scheduler(scheduler)
     {
         bus->Subscribe(InputAction::SwitchRenderer, [this]() {
             if (m_windowManager) {
@@ -35,14 +41,13 @@ namespace Spectrum {
     RendererManager::~RendererManager() {}
 
     bool RendererManager::Initialize() {
-        m_renderers[RenderStyle::Bars] = std::make_unique<BarsRenderer>();
-        m_renderers[RenderStyle::Wave] = std::make_unique<WaveRenderer>();
-        m_renderers[RenderStyle::CircularWave] = std::make_unique<CircularWaveRenderer>();
-        m_renderers[RenderStyle::Cubes] = std::make_unique<CubesRenderer>();
-        m_renderers[RenderStyle::Fire] = std::make_unique<FireRenderer>();
-        m_renderers[RenderStyle::LedPanel] = std::make_unique<LedPanelRenderer>();
-        m_renderers[RenderStyle::Gauge] = std::make_unique<GaugeRenderer>();
-        m_renderers[RenderStyle::KenwoodBars] = std::make_unique<KenwoodBarsRenderer>();
+        for (int i = 0; i < static_cast<int>(RenderStyle::Count); ++i) {
+            const auto style = static_cast<RenderStyle>(i);
+            auto renderer = CreateRenderer(style);
+            renderer->SetFrameArena(&m_frameArena);
+            renderer->SetSpectrumHistory(m_spectrumHistory);
+            m_renderers[style] = std::move(renderer);
+        }
 
         m_currentStyle = RenderStyle::Bars;
         m_currentRenderer = m_renderers[m_currentStyle].get();
@@ -50,11 +55,35 @@ namespace Spectrum {
         return true;
     }
 
+    std::unique_ptr<IRenderer> RendererManager::CreateRenderer(RenderStyle style) const {
+        switch (style) {
+        case RenderStyle::Bars:         return std::make_unique<BarsRenderer>();
+        case RenderStyle::Wave:         return std::make_unique<WaveRenderer>();
+        case RenderStyle::CircularWave: return std::make_unique<CircularWaveRenderer>();
+        case RenderStyle::Cubes:        return std::make_unique<CubesRenderer>();
+        case RenderStyle::Fire:         return std::make_unique<FireRenderer>(m_scheduler);
+        case RenderStyle::LedPanel:     return std::make_unique<LedPanelRenderer>();
+        case RenderStyle::Gauge:        return std::make_unique<GaugeRenderer>();
+        case RenderStyle::KenwoodBars:  return std::make_unique<KenwoodBarsRenderer>();
+        case RenderStyle::Waterfall:    return std::make_unique<WaterfallRenderer>();
+        default:                        return std::make_unique<BarsRenderer>();
+        }
+    }
+
+    void RendererManager::SetSpectrumHistory(const SpectrumHistory* history) {
+        if (m_spectrumHistory == history) return;
+        m_spectrumHistory = history;
+        for (auto& [style, renderer] : m_renderers) {
+            renderer->SetSpectrumHistory(history);
+        }
+    }
+
     void RendererManager::RenderScene(
         GraphicsContext& graphics,
         const SpectrumData& spectrum,
         ColorPicker* colorPicker,
-        bool isOverlay
+        bool isOverlay,
+        float deltaTime
     ) {
         if (auto rt = graphics.GetRenderTarget()) {
             if (rt->CheckWindowState() & D2D1_WINDOW_STATE_OCCLUDED) {
@@ -63,15 +92,18 @@ namespace Spectrum {
         }
 
         graphics.BeginDraw();
+        BeginFrame();
 
         const Color clearColor = isOverlay
             ? Color::Transparent()
             : Color::FromRGB(13, 13, 26);
         graphics.Clear(clearColor);
 
+        graphics.BeginScene();
         if (m_currentRenderer) {
-            m_currentRenderer->Render(graphics, spectrum);
+            m_currentRenderer->Render(graphics, spectrum, deltaTime);
         }
+        graphics.EndScene();
 
         if (colorPicker && colorPicker->IsVisible() && !isOverlay) {
             colorPicker->Draw(graphics);
@@ -106,20 +138,24 @@ namespace Spectrum {
 
     void RendererManager::SetQuality(RenderQuality quality) {
         m_currentQuality = quality;
+        ApplyQuality();
+        LOG_INFO("Render quality set to " << Utils::ToString(quality));
+    }
+
+    void RendererManager::SetQualityCap(RenderQuality cap) {
+        if (m_qualityCap == cap) return;
+        m_qualityCap = cap;
+        ApplyQuality();
+    }
+
+    // Renderers ignore a quality they already have
+    void RendererManager::ApplyQuality() {
+        const RenderQuality quality = GetEffectiveQuality();
         for (auto& [style, renderer] : m_renderers) {
             if (renderer) {
                 renderer->SetQuality(quality);
             }
         }
-
-        const char* qualityName = "Unknown";
-        switch (quality) {
-        case RenderQuality::Low:    qualityName = "Low"; break;
-        case RenderQuality::Medium: qualityName = "Medium"; break;
-        case RenderQuality::High:   qualityName = "High"; break;
-        default: break;
-        }
-        LOG_INFO("Render quality set to " << qualityName);
     }
 
     void RendererManager::CycleQuality() {
@@ -5,6 +5,7 @@
 #define SPECTRUM_CPP_RENDERER_MANAGER_H
 
 #include "Common.h"
+#include "FrameArena.h"
 #include "IRenderer.h"
 #include "GraphicsContext.h"
 #include "ColorPicker.h"
@@ -15,19 +16,34 @@ namespace Spectrum {
 
     class EventBus;
     class WindowManager;
+    class TaskScheduler;
 
     class RendererManager {
     public:
-        explicit RendererManager(EventBus* bus, WindowManager* windowManager);
+        RendererManager(
+            EventBus* bus,
+            WindowManager* windowManager,
+            TaskScheduler* scheduler = nullptr
+        );
         ~RendererManager();
 
         bool Initialize();
 
+        // A fresh renderer owned by the caller, e.g. for another window
+        std::unique_ptr<IRenderer> CreateRenderer(RenderStyle style) const;
+
+        // Releases the previous frame's renderer scratch memory
+        void BeginFrame() { m_frameArena.Reset(); }
+
+        // Handed to every renderer; the audio source owns it
+        void SetSpectrumHistory(const SpectrumHistory* history);
+
         void RenderScene(
             GraphicsContext& graphics,
             const SpectrumData& spectrum,
             ColorPicker* colorPicker,
-            bool isOverlay
+            bool isOverlay,
+            float deltaTime
         );
 
         void OnResize(int width, int height);
@@ -40,14 +56,26 @@ namespace Spectrum {
         RenderStyle GetCurrentStyle() const { return m_currentStyle; }
         RenderQuality GetQuality() const { return m_currentQuality; }
 
+        // Upper bound below the user's choice, set by the quality governor
+        void SetQualityCap(RenderQuality cap);
+        RenderQuality GetEffectiveQuality() const {
+            return std::min(m_currentQuality, m_qualityCap);
+        }
+
     private:
         void SetQuality(RenderQuality quality);
+        void ApplyQuality();
 
+        // Shared by all renderers; only the current one draws per frame
+        FrameArena m_frameArena;
         std::map<RenderStyle, std::unique_ptr<IRenderer>> m_renderers;
         IRenderer* m_currentRenderer = nullptr;
         RenderStyle m_currentStyle = RenderStyle::Bars;
         RenderQuality m_currentQuality = RenderQuality::Medium;
+        RenderQuality m_qualityCap = RenderQuality::High;
+        const SpectrumHistory* m_spectrumHistory = nullptr;
         WindowManager* m_windowManager = nullptr;
+        TaskScheduler* m_scheduler = nullptr;
     };
 
 }
@@ -0,0 +1,33 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// RetainedGeometry.cpp: Implementation of the RetainedGeometry class.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#include "RetainedGeometry.h"
+#include <atomic>
+#include <cstring>
+
+namespace Spectrum {
+
+    namespace {
+        // Zero is reserved for "not retained"
+        std::atomic<uint32_t> g_nextGeometryId{ 1 };
+    }
+
+    RetainedGeometry::RetainedGeometry()
+        : m_closed(false) {
+        m_handle.id = g_nextGeometryId.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void RetainedGeometry::SetPoints(const Point* points, size_t count, bool closed) {
+        if (!points) count = 0;
+
+        const bool unchanged = closed == m_closed
+            && count == m_points.size()
+            && (count == 0 || std::memcmp(points, m_points.data(), count * sizeof(Point)) == 0);
+        if (unchanged) return;
+
+        m_points.assign(points, points + count);
+        m_closed = closed;
+        ++m_handle.revision;
+    }
+
+}
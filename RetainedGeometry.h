@@ -0,0 +1,39 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// RetainedGeometry.h: Renderer-owned path that backends can keep built across frames.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#ifndef SPECTRUM_CPP_RETAINED_GEOMETRY_H
+#define SPECTRUM_CPP_RETAINED_GEOMETRY_H
+
+#include "Common.h"
+
+namespace Spectrum {
+
+    // Holds a polyline or polygon together with a process-unique handle.
+    // SetPoints() only bumps the revision when the shape actually changes,
+    // so a renderer can call it every frame and the backend still reuses
+    // its built path until the points differ.
+    class RetainedGeometry {
+    public:
+        RetainedGeometry();
+
+        void SetPoints(const Point* points, size_t count, bool closed);
+        void SetPoints(const std::vector<Point>& points, bool closed) {
+            SetPoints(points.data(), points.size(), closed);
+        }
+        void Invalidate() noexcept { ++m_handle.revision; }
+
+        GeometryHandle GetHandle() const noexcept { return m_handle; }
+        const Point* GetPoints() const noexcept { return m_points.data(); }
+        size_t GetPointCount() const noexcept { return m_points.size(); }
+        bool IsClosed() const noexcept { return m_closed; }
+        bool IsEmpty() const noexcept { return m_points.size() < 2; }
+
+    private:
+        std::vector<Point> m_points;
+        bool m_closed;
+        GeometryHandle m_handle;
+    };
+
+}
+
+#endif
@@ -0,0 +1,61 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// RetainedImage.cpp: Implementation of the RetainedImage class.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#include "RetainedImage.h"
+#include <atomic>
+
+namespace Spectrum {
+
+    namespace {
+        // Zero is reserved for "not retained"
+        std::atomic<uint32_t> g_nextImageId{ 1 };
+    }
+
+    RetainedImage::RetainedImage()
+        : m_width(0), m_height(0) {
+        m_handle.id = g_nextImageId.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void RetainedImage::Resize(int width, int height) {
+        width = std::max(0, width);
+        height = std::max(0, height);
+        if (width == m_width && height == m_height) return;
+
+        m_width = width;
+        m_height = height;
+        m_pixels.assign(static_cast<size_t>(width) * height, 0u);
+        MarkDirty();
+    }
+
+    void RetainedImage::MarkRowsDirty(int first, int count) noexcept {
+        first = std::clamp(first, 0, m_height);
+        count = std::clamp(count, 0, m_height - first);
+
+        const uint32_t revision = ++m_handle.revision;
+        m_dirtyLog[revision % DIRTY_LOG_SIZE] = { revision, first, count };
+    }
+
+    bool RetainedImage::GetRowsDirtySince(
+        uint32_t revision,
+        int& first,
+        int& count
+    ) const noexcept {
+        const uint32_t behind = m_handle.revision - revision;
+        if (behind > DIRTY_LOG_SIZE) return false;
+
+        int begin = m_height;
+        int end = 0;
+        for (uint32_t r = revision + 1; r != m_handle.revision + 1; ++r) {
+            const DirtyRows& rows = m_dirtyLog[r % DIRTY_LOG_SIZE];
+            if (rows.revision != r) return false;
+            if (rows.count == 0) continue;
+            begin = std::min(begin, rows.first);
+            end = std::max(end, rows.first + rows.count);
+        }
+
+        first = begin < end ? begin : 0;
+        count = begin < end ? end - begin : 0;
+        return true;
+    }
+
+}
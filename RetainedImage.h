@@ -0,0 +1,55 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// RetainedImage.h: Renderer-owned pixel buffer that backends keep as a texture.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#ifndef SPECTRUM_CPP_RETAINED_IMAGE_H
+#define SPECTRUM_CPP_RETAINED_IMAGE_H
+
+#include "Common.h"
+
+namespace Spectrum {
+
+    // Premultiplied BGRA pixels plus a handle. Writers call MarkDirty()
+    // or MarkRowsDirty() after changing pixels so backends upload the new
+    // contents; the buffer is only referenced by recorded commands, never
+    // copied. The rows behind the last few revisions are logged, so a
+    // backend can upload just those instead of the whole image.
+    class RetainedImage {
+    public:
+        RetainedImage();
+
+        // Reallocates only when the size changes; contents become zero
+        void Resize(int width, int height);
+        void MarkDirty() noexcept { MarkRowsDirty(0, m_height); }
+        void MarkRowsDirty(int first, int count) noexcept;
+
+        // Span covering every row written after `revision`; empty when it
+        // is current. False when the log no longer reaches back that far,
+        // in which case the whole image has to be uploaded.
+        bool GetRowsDirtySince(uint32_t revision, int& first, int& count) const noexcept;
+
+        uint32_t* GetPixels() noexcept { return m_pixels.data(); }
+        const uint32_t* GetPixels() const noexcept { return m_pixels.data(); }
+        int GetWidth() const noexcept { return m_width; }
+        int GetHeight() const noexcept { return m_height; }
+        ImageHandle GetHandle() const noexcept { return m_handle; }
+        bool IsEmpty() const noexcept { return m_pixels.empty(); }
+
+    private:
+        struct DirtyRows {
+            uint32_t revision = 0;
+            int first = 0;
+            int count = 0;
+        };
+
+        static constexpr size_t DIRTY_LOG_SIZE = 8;
+
+        std::vector<uint32_t> m_pixels;
+        int m_width;
+        int m_height;
+        ImageHandle m_handle;
+        std::array<DirtyRows, DIRTY_LOG_SIZE> m_dirtyLog;
+    };
+
+}
+
+#endif
@@ -0,0 +1,26 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// RetainedLayer.cpp: Implementation of the RetainedLayer class.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#include "RetainedLayer.h"
+#include <atomic>
+
+namespace Spectrum {
+
+    namespace {
+        // Zero is reserved for "not retained"
+        std::atomic<uint32_t> g_nextLayerId{ 1 };
+    }
+
+    RetainedLayer::RetainedLayer()
+        : m_isRecorded(false) {
+        m_handle.id = g_nextLayerId.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    RenderCommandList& RetainedLayer::BeginRecording() {
+        m_content.Clear();
+        ++m_handle.revision;
+        m_isRecorded = true;
+        return m_content;
+    }
+
+}
@@ -0,0 +1,34 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// RetainedLayer.h: Static renderer content a backend rasterizes once and reuses.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#ifndef SPECTRUM_CPP_RETAINED_LAYER_H
+#define SPECTRUM_CPP_RETAINED_LAYER_H
+
+#include "Common.h"
+#include "RenderCommandList.h"
+
+namespace Spectrum {
+
+    // Owns the recorded content of one static layer. Invalidate() only
+    // marks it stale; the owner re-records through BeginRecording(), which
+    // bumps the revision so backends drop their rasterized copy.
+    class RetainedLayer {
+    public:
+        RetainedLayer();
+
+        RenderCommandList& BeginRecording();
+        void Invalidate() noexcept { m_isRecorded = false; }
+
+        bool IsRecorded() const noexcept { return m_isRecorded; }
+        LayerHandle GetHandle() const noexcept { return m_handle; }
+        const RenderCommandList& GetContent() const noexcept { return m_content; }
+
+    private:
+        RenderCommandList m_content;
+        LayerHandle m_handle;
+        bool m_isRecorded;
+    };
+
+}
+
+#endif
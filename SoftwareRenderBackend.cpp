@@ -0,0 +1,1288 @@
+// =-=-=-=-=-=-=-=-=-=-=
+// SoftwareRenderBackend.cpp
+// =-=-=-=-=-=-=-=-=-=-=
+
+#include "SoftwareRenderBackend.h"
+#include "RenderCommandList.h"
+#include "RetainedImage.h"
+#include "TaskScheduler.h"
+#include "Utils.h"
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SPECTRUM_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace Spectrum {
+
+    namespace {
+        constexpr int TILE_SIZE = 64;
+        constexpr int SUBSAMPLES = 4;
+        constexpr float SUBSAMPLE_WEIGHT = 1.0f / SUBSAMPLES;
+        constexpr float FULL_COVERAGE = 0.999f;
+        constexpr float MIN_COVERAGE = 1.0f / 512.0f;
+        constexpr int GRADIENT_LUT_SIZE = 256;
+
+        // Curve flattening used when a transform rotates or skews
+        constexpr float CURVE_SEGMENT_LENGTH = 4.0f;
+        constexpr int MIN_CURVE_SEGMENTS = 16;
+        constexpr int MAX_CURVE_SEGMENTS = 256;
+        constexpr int CORNER_SEGMENTS = 8;
+
+        // Text runs untouched for this many frames are released
+        constexpr uint64_t TEXT_RUN_TTL_FRAMES = 120;
+
+        struct Edge {
+            float x0, y0, x1, y1;
+            float dxdy;
+            int direction;
+        };
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Pixel Helpers
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        inline uint32_t ToByte(float value) {
+            return static_cast<uint32_t>(Utils::Saturate(value) * 255.0f + 0.5f);
+        }
+
+        inline uint32_t PackPremultiplied(const Color& c) {
+            const float a = Utils::Saturate(c.a);
+            return (ToByte(a) << 24)
+                | (ToByte(c.r * a) << 16)
+                | (ToByte(c.g * a) << 8)
+                | ToByte(c.b * a);
+        }
+
+        // Scales all four channels by scale / 255 with rounding
+        inline uint32_t ScalePixel(uint32_t pixel, uint32_t scale) {
+            uint32_t rb = (pixel & 0x00FF00FFu) * scale + 0x00800080u;
+            rb = ((rb + ((rb >> 8) & 0x00FF00FFu)) >> 8) & 0x00FF00FFu;
+            uint32_t ag = ((pixel >> 8) & 0x00FF00FFu) * scale + 0x00800080u;
+            ag = (ag + ((ag >> 8) & 0x00FF00FFu)) & 0xFF00FF00u;
+            return rb | ag;
+        }
+
+        // Premultiplied source-over
+        inline uint32_t BlendPixel(uint32_t dst, uint32_t src) {
+            return src + ScalePixel(dst, 255u - (src >> 24));
+        }
+
+        void FillSpan(uint32_t* dst, int count, uint32_t color) {
+            const uint32_t alpha = color >> 24;
+            if (alpha == 0 || count <= 0) return;
+
+            int i = 0;
+            if (alpha == 255) {
+#ifdef SPECTRUM_USE_SSE2
+                const __m128i src = _mm_set1_epi32(static_cast<int>(color));
+                for (; i + 4 <= count; i += 4) {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), src);
+                }
+#endif
+                for (; i < count; ++i) dst[i] = color;
+                return;
+            }
+
+#ifdef SPECTRUM_USE_SSE2
+            const __m128i src = _mm_set1_epi32(static_cast<int>(color));
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i inverse = _mm_set1_epi16(static_cast<short>(255 - alpha));
+            const __m128i half = _mm_set1_epi16(128);
+            for (; i + 4 <= count; i += 4) {
+                __m128i* p = reinterpret_cast<__m128i*>(dst + i);
+                const __m128i d = _mm_loadu_si128(p);
+
+                __m128i lo = _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), inverse);
+                __m128i hi = _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), inverse);
+                lo = _mm_add_epi16(lo, half);
+                hi = _mm_add_epi16(hi, half);
+                lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+                hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+
+                _mm_storeu_si128(p, _mm_add_epi8(_mm_packus_epi16(lo, hi), src));
+            }
+#endif
+            for (; i < count; ++i) dst[i] = BlendPixel(dst[i], color);
+        }
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Coverage Helpers
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        inline float Overlap(float a0, float a1, float b0, float b1) {
+            return std::max(0.0f, std::min(a1, b1) - std::max(a0, b0));
+        }
+
+        // Thin strokes fade instead of thinning below one pixel
+        inline float StrokeCoverage(float distance, float halfWidth) {
+            return Utils::Saturate(halfWidth + 0.5f - distance)
+                * std::min(1.0f, 2.0f * halfWidth);
+        }
+
+        inline float BoxDistance(const Point& p, const Point& halfSize, float radius) {
+            const float qx = std::abs(p.x) - (halfSize.x - radius);
+            const float qy = std::abs(p.y) - (halfSize.y - radius);
+            const float ox = std::max(qx, 0.0f);
+            const float oy = std::max(qy, 0.0f);
+            return std::sqrt(ox * ox + oy * oy)
+                + std::min(std::max(qx, qy), 0.0f)
+                - radius;
+        }
+
+        // Exact for circles, a first-order approximation for ellipses
+        inline float EllipseDistance(const Point& p, const Point& radii) {
+            if (radii.x == radii.y) {
+                return std::sqrt(p.x * p.x + p.y * p.y) - radii.x;
+            }
+            const float nx = p.x / radii.x;
+            const float ny = p.y / radii.y;
+            const float k0 = std::sqrt(nx * nx + ny * ny);
+            const float gx = nx / radii.x;
+            const float gy = ny / radii.y;
+            const float k1 = std::sqrt(gx * gx + gy * gy);
+            if (k1 <= 0.0f) return -std::min(radii.x, radii.y);
+            return k0 * (k0 - 1.0f) / k1;
+        }
+
+        inline float SegmentDistance(const Point& p, const Point& a, const Point& b) {
+            const float abx = b.x - a.x;
+            const float aby = b.y - a.y;
+            const float apx = p.x - a.x;
+            const float apy = p.y - a.y;
+            const float lengthSq = abx * abx + aby * aby;
+            const float t = lengthSq > 0.0f
+                ? Utils::Saturate((apx * abx + apy * aby) / lengthSq)
+                : 0.0f;
+            const float dx = apx - abx * t;
+            const float dy = apy - aby * t;
+            return std::sqrt(dx * dx + dy * dy);
+        }
+
+        // Adds weighted coverage of [xa, xb) to a row starting at x0
+        void AccumulateSpan(
+            float* coverage, int x0, int count, float xa, float xb, float weight
+        ) {
+            xa = std::max(xa, static_cast<float>(x0));
+            xb = std::min(xb, static_cast<float>(x0 + count));
+            if (xa >= xb) return;
+
+            const int ia = static_cast<int>(std::floor(xa));
+            const int ib = static_cast<int>(std::floor(xb));
+            if (ia == ib) {
+                coverage[ia - x0] += (xb - xa) * weight;
+                return;
+            }
+
+            coverage[ia - x0] += (static_cast<float>(ia + 1) - xa) * weight;
+            for (int i = ia + 1; i < ib; ++i) coverage[i - x0] += weight;
+            if (ib < x0 + count) {
+                coverage[ib - x0] += (xb - static_cast<float>(ib)) * weight;
+            }
+        }
+
+        // Clamps before converting so off-screen coordinates cannot overflow
+        inline int PixelClamp(float value, int limit) {
+            return static_cast<int>(std::clamp(value, 0.0f, static_cast<float>(limit)));
+        }
+
+        inline int CurveSegmentCount(float radiusX, float radiusY) {
+            const float perimeter = PI * (radiusX + radiusY);
+            const int segments = static_cast<int>(perimeter / CURVE_SEGMENT_LENGTH);
+            return std::clamp(segments, MIN_CURVE_SEGMENTS, MAX_CURVE_SEGMENTS);
+        }
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Class Implementation
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    SoftwareRenderBackend::SoftwareRenderBackend(TaskScheduler* scheduler)
+        : m_scheduler(scheduler),
+        m_width(0),
+        m_height(0),
+        m_tilesX(0),
+        m_tilesY(0),
+        m_transform(Transform2D::Identity()),
+        m_frameIndex(0),
+        m_textRunHits(0),
+        m_textRunMisses(0) {
+    }
+
+    void SoftwareRenderBackend::Resize(int width, int height) {
+        Flush();
+
+        m_width = std::max(0, width);
+        m_height = std::max(0, height);
+        m_pixels.assign(static_cast<size_t>(m_width) * m_height, 0u);
+
+        m_tilesX = (m_width + TILE_SIZE - 1) / TILE_SIZE;
+        m_tilesY = (m_height + TILE_SIZE - 1) / TILE_SIZE;
+        m_tiles.resize(static_cast<size_t>(m_tilesX) * m_tilesY);
+
+        for (int ty = 0; ty < m_tilesY; ++ty) {
+            for (int tx = 0; tx < m_tilesX; ++tx) {
+                Tile& tile = m_tiles[static_cast<size_t>(ty) * m_tilesX + tx];
+                tile.x0 = tx * TILE_SIZE;
+                tile.y0 = ty * TILE_SIZE;
+                tile.x1 = std::min(tile.x0 + TILE_SIZE, m_width);
+                tile.y1 = std::min(tile.y0 + TILE_SIZE, m_height);
+                tile.primitives.clear();
+            }
+        }
+    }
+
+    void SoftwareRenderBackend::BeginDraw() {
+        ++m_frameIndex;
+        m_transform = Transform2D::Identity();
+    }
+
+    void SoftwareRenderBackend::EndDraw() {
+        Flush();
+        TrimTextRuns();
+    }
+
+    void SoftwareRenderBackend::Clear(const Color& color) {
+        // Anything queued before the clear would be overwritten anyway
+        m_primitives.clear();
+        m_vertices.clear();
+        m_segments.clear();
+        m_gradientLuts.clear();
+
+        std::fill(m_pixels.begin(), m_pixels.end(), PackPremultiplied(color));
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Drawing Primitives
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    void SoftwareRenderBackend::DrawRectangle(
+        const Rect& rect,
+        const Color& color,
+        bool filled,
+        float strokeWidth
+    ) {
+        AddBox(ShapeType::Rect, rect, 0.0f, MakeSolidPaint(color), filled, strokeWidth);
+    }
+
+    void SoftwareRenderBackend::DrawRoundedRectangle(
+        const Rect& rect,
+        float radius,
+        const Color& color,
+        bool filled,
+        float strokeWidth
+    ) {
+        AddBox(
+            ShapeType::RoundedRect, rect, radius, MakeSolidPaint(color), filled, strokeWidth
+        );
+    }
+
+    void SoftwareRenderBackend::DrawEllipse(
+        const Point& center,
+        float radiusX,
+        float radiusY,
+        const Color& color,
+        bool filled,
+        float strokeWidth
+    ) {
+        AddEllipse(center, radiusX, radiusY, MakeSolidPaint(color), filled, strokeWidth);
+    }
+
+    void SoftwareRenderBackend::DrawLine(
+        const Point& start,
+        const Point& end,
+        const Color& color,
+        float strokeWidth
+    ) {
+        const Point points[2] = { start, end };
+        AddStrokes(points, 2, false, MakeSolidPaint(color), strokeWidth);
+    }
+
+    void SoftwareRenderBackend::DrawPolyline(
+        const Point* points,
+        size_t count,
+        const Color& color,
+        float strokeWidth
+    ) {
+        if (!points || count < 2) return;
+        AddStrokes(points, count, false, MakeSolidPaint(color), strokeWidth);
+    }
+
+    void SoftwareRenderBackend::DrawPolygon(
+        const Point* points,
+        size_t count,
+        const Color& color,
+        bool filled,
+        float strokeWidth
+    ) {
+        if (!points || count < 3) return;
+
+        if (filled) {
+            AddPolygon(points, count, MakeSolidPaint(color));
+        }
+        else {
+            AddStrokes(points, count, true, MakeSolidPaint(color), strokeWidth);
+        }
+    }
+
+    // Rasterization already works from the raw points, so there is nothing
+    // worth retaining between frames here
+    void SoftwareRenderBackend::DrawGeometry(
+        GeometryHandle /*handle*/,
+        const Point* points,
+        size_t count,
+        bool closed,
+        const Color& color,
+        bool filled,
+        float strokeWidth
+    ) {
+        if (!points || count < 2) return;
+
+        if (filled && count >= 3) {
+            AddPolygon(points, count, MakeSolidPaint(color));
+        }
+        else if (!filled) {
+            AddStrokes(points, count, closed, MakeSolidPaint(color), strokeWidth);
+        }
+    }
+
+    void SoftwareRenderBackend::DrawGeometryInstances(
+        GeometryHandle handle,
+        const Point* points,
+        size_t count,
+        bool closed,
+        const GeometryInstance* instances,
+        size_t instanceCount,
+        bool filled
+    ) {
+        if (!instances) return;
+
+        const Transform2D base = m_transform;
+        for (size_t i = 0; i < instanceCount; ++i) {
+            const GeometryInstance& instance = instances[i];
+            m_transform = instance.transform * base;
+            DrawGeometry(
+                handle,
+                points,
+                count,
+                closed,
+                instance.color,
+                filled,
+                instance.strokeWidth
+            );
+        }
+        m_transform = base;
+    }
+
+    // Coverage is resolved per primitive anyway, so a batch only saves the
+    // paint setup; the shapes still bin individually
+    void SoftwareRenderBackend::FillRectangles(
+        const Rect* rects,
+        size_t count,
+        const Color& color
+    ) {
+        if (!rects) return;
+
+        const Paint paint = MakeSolidPaint(color);
+        for (size_t i = 0; i < count; ++i) {
+            AddBox(ShapeType::Rect, rects[i], 0.0f, paint, true, 0.0f);
+        }
+    }
+
+    void SoftwareRenderBackend::FillEllipses(
+        const Rect* bounds,
+        size_t count,
+        const Color& color
+    ) {
+        if (!bounds) return;
+
+        const Paint paint = MakeSolidPaint(color);
+        for (size_t i = 0; i < count; ++i) {
+            const Rect& r = bounds[i];
+            const float radiusX = r.width * 0.5f;
+            const float radiusY = r.height * 0.5f;
+            AddEllipse(
+                { r.x + radiusX, r.y + radiusY }, radiusX, radiusY, paint, true, 0.0f
+            );
+        }
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Images
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Samples straight from the image's buffer at rasterization time, so
+    // the handle and dirty rows are not needed. Under rotation the image
+    // fills the bounds of the transformed destination.
+    void SoftwareRenderBackend::DrawImage(
+        const RetainedImage& image,
+        const Rect& destination,
+        const Rect& source
+    ) {
+        if (image.IsEmpty()) return;
+
+        const uint32_t* pixels = image.GetPixels();
+        const int width = image.GetWidth();
+        const int height = image.GetHeight();
+
+        // Sampling is by whole texels, so the region snaps to them
+        int x0 = 0, y0 = 0, x1 = width, y1 = height;
+        if (source.width > 0.0f && source.height > 0.0f) {
+            x0 = std::clamp(static_cast<int>(std::lround(source.x)), 0, width);
+            y0 = std::clamp(static_cast<int>(std::lround(source.y)), 0, height);
+            x1 = std::clamp(static_cast<int>(std::lround(source.GetRight())), x0, width);
+            y1 = std::clamp(static_cast<int>(std::lround(source.GetBottom())), y0, height);
+            if (x1 == x0 || y1 == y0) return;
+        }
+
+        const Point corners[4] = {
+            m_transform.TransformPoint({ destination.x, destination.y }),
+            m_transform.TransformPoint({ destination.GetRight(), destination.y }),
+            m_transform.TransformPoint({ destination.GetRight(), destination.GetBottom() }),
+            m_transform.TransformPoint({ destination.x, destination.GetBottom() })
+        };
+
+        float left = corners[0].x, right = corners[0].x;
+        float top = corners[0].y, bottom = corners[0].y;
+        for (const Point& c : corners) {
+            left = std::min(left, c.x);
+            right = std::max(right, c.x);
+            top = std::min(top, c.y);
+            bottom = std::max(bottom, c.y);
+        }
+
+        AddImage(
+            Rect(left, top, right - left, bottom - top),
+            pixels + static_cast<size_t>(y0) * width + x0,
+            x1 - x0,
+            y1 - y0,
+            width
+        );
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Retained Layers
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    void SoftwareRenderBackend::DrawLayer(
+        LayerHandle handle,
+        const RenderCommandList& content
+    ) {
+        if (m_width <= 0 || m_height <= 0) return;
+
+        Layer& layer = m_layers[handle.id];
+        SoftwareRenderBackend* surface = layer.surface.get();
+
+        const bool stale = !surface
+            || layer.revision != handle.revision
+            || surface->GetWidth() != m_width
+            || surface->GetHeight() != m_height;
+        if (stale) {
+            if (!surface) {
+                layer.surface = std::make_unique<SoftwareRenderBackend>(m_scheduler);
+                surface = layer.surface.get();
+            }
+            if (surface->GetWidth() != m_width || surface->GetHeight() != m_height) {
+                surface->Resize(m_width, m_height);
+            }
+
+            surface->BeginDraw();
+            surface->Clear(Color(0.0f, 0.0f, 0.0f, 0.0f));
+            content.Execute(*surface);
+            surface->EndDraw();
+            layer.revision = handle.revision;
+        }
+
+        // Layers composite in device space, whatever the current transform
+        AddImage(
+            Rect(0.0f, 0.0f, static_cast<float>(m_width), static_cast<float>(m_height)),
+            surface->GetPixels(),
+            m_width,
+            m_height,
+            m_width
+        );
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Gradients
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    void SoftwareRenderBackend::DrawGradientRectangle(
+        const Rect& rect,
+        const GradientStop* stops,
+        size_t stopCount,
+        bool horizontal
+    ) {
+        if (!stops || stopCount == 0) return;
+
+        const Point start = m_transform.TransformPoint({ rect.x, rect.y });
+        const Point end = m_transform.TransformPoint(horizontal
+            ? Point(rect.GetRight(), rect.y)
+            : Point(rect.x, rect.GetBottom()));
+        const float dx = end.x - start.x;
+        const float dy = end.y - start.y;
+        const float lengthSq = dx * dx + dy * dy;
+
+        Paint paint;
+        paint.type = PaintType::Linear;
+        paint.lutOffset = BuildGradientLut(stops, stopCount);
+        paint.origin = start;
+        paint.axis = lengthSq > 0.0f
+            ? Point(dx / lengthSq, dy / lengthSq)
+            : Point();
+
+        AddBox(ShapeType::Rect, rect, 0.0f, paint, true, 0.0f);
+    }
+
+    void SoftwareRenderBackend::DrawRadialGradient(
+        const Point& center,
+        float radius,
+        const GradientStop* stops,
+        size_t stopCount
+    ) {
+        if (!stops || stopCount == 0 || radius <= 0.0f) return;
+
+        float radiusX = radius * GetTransformScale();
+        float radiusY = radiusX;
+        if (IsAxisAligned()) {
+            radiusX = radius * std::abs(m_transform.m11);
+            radiusY = radius * std::abs(m_transform.m22);
+        }
+        if (radiusX <= 0.0f || radiusY <= 0.0f) return;
+
+        Paint paint;
+        paint.type = PaintType::Radial;
+        paint.lutOffset = BuildGradientLut(stops, stopCount);
+        paint.origin = m_transform.TransformPoint(center);
+        paint.axis = Point(1.0f / radiusX, 1.0f / radiusY);
+
+        AddEllipse(center, radius, radius, paint, true, 0.0f);
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Text
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    void SoftwareRenderBackend::DrawText(
+        std::wstring_view text,
+        const Point& position,
+        const Color& color,
+        float fontSize,
+        TextAlignment alignment
+    ) {
+        if (text.empty() || m_width <= 0 || m_height <= 0) return;
+
+        const uint32_t packed = PackPremultiplied(color);
+        if ((packed >> 24) == 0) return;
+
+        // Text scales with the transform but is never rotated
+        const int pixelSize = static_cast<int>(std::lround(fontSize * GetTransformScale()));
+        if (pixelSize < GlyphAtlas::MIN_PIXEL_SIZE) return;
+
+        const TextRun& run = GetTextRun(text, pixelSize, packed);
+        if (run.pixels.empty()) return;
+
+        // Same anchoring as the Direct2D path: the run is centred
+        // vertically on the position, horizontally per alignment
+        const Point anchor = m_transform.TransformPoint(position);
+        float left = anchor.x;
+        if (alignment == TextAlignment::Center) {
+            left -= run.width * 0.5f;
+        }
+        else if (alignment == TextAlignment::Trailing) {
+            left -= static_cast<float>(run.width);
+        }
+        const float top = anchor.y - run.height * 0.5f;
+
+        // Whole pixels keep the sampling one texel per pixel
+        AddImage(
+            Rect(
+                std::round(left),
+                std::round(top),
+                static_cast<float>(run.width),
+                static_cast<float>(run.height)
+            ),
+            run.pixels.data(),
+            run.width,
+            run.height,
+            run.width
+        );
+    }
+
+    SoftwareRenderBackend::TextCacheStats SoftwareRenderBackend::GetTextCacheStats() const noexcept {
+        TextCacheStats stats;
+        stats.runHits = m_textRunHits;
+        stats.runMisses = m_textRunMisses;
+        stats.cachedRuns = m_textRuns.size();
+        stats.glyphPages = m_glyphAtlas.GetPageCount();
+        return stats;
+    }
+
+    size_t SoftwareRenderBackend::TextRunKeyHash::operator()(const TextRunKey& key) const noexcept {
+        // FNV-1a over the characters, then the size and color
+        uint64_t hash = 14695981039346656037ull;
+        auto mix = [&hash](uint32_t value) {
+            hash ^= value;
+            hash *= 1099511628211ull;
+        };
+        for (wchar_t c : key.text) mix(static_cast<uint32_t>(c));
+        mix(static_cast<uint32_t>(key.pixelSize));
+        mix(key.color);
+        return static_cast<size_t>(hash);
+    }
+
+    // Copies the glyph coverage out of the atlas, tinted by the color
+    const SoftwareRenderBackend::TextRun& SoftwareRenderBackend::GetTextRun(
+        std::wstring_view text,
+        int pixelSize,
+        uint32_t color
+    ) {
+        // The lookup key is reused so cache hits do not allocate
+        m_textRunLookup.text.assign(text.data(), text.size());
+        m_textRunLookup.pixelSize = pixelSize;
+        m_textRunLookup.color = color;
+
+        auto it = m_textRuns.find(m_textRunLookup);
+        if (it != m_textRuns.end()) {
+            ++m_textRunHits;
+            it->second.lastUsedFrame = m_frameIndex;
+            return it->second;
+        }
+
+        ++m_textRunMisses;
+        TextRun& run = m_textRuns[m_textRunLookup];
+        run.lastUsedFrame = m_frameIndex;
+
+        const GlyphAtlas::Page& page = m_glyphAtlas.GetPage(pixelSize);
+        run.width = static_cast<int>(text.size()) * page.cellWidth;
+        run.height = page.cellHeight;
+        run.pixels.assign(static_cast<size_t>(run.width) * run.height, 0);
+
+        for (size_t i = 0; i < text.size(); ++i) {
+            const uint8_t* glyph = page.GetGlyph(text[i]);
+            for (int y = 0; y < run.height; ++y) {
+                const uint8_t* src = glyph + static_cast<size_t>(y) * page.GetStride();
+                uint32_t* dst = run.pixels.data()
+                    + static_cast<size_t>(y) * run.width
+                    + i * page.cellWidth;
+                for (int x = 0; x < page.cellWidth; ++x) {
+                    if (src[x]) dst[x] = ScalePixel(color, src[x]);
+                }
+            }
+        }
+        return run;
+    }
+
+    void SoftwareRenderBackend::TrimTextRuns() {
+        for (auto it = m_textRuns.begin(); it != m_textRuns.end();) {
+            if (m_frameIndex - it->second.lastUsedFrame > TEXT_RUN_TTL_FRAMES) {
+                it = m_textRuns.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Transformations
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    void SoftwareRenderBackend::SetTransform(const Transform2D& transform) {
+        m_transform = transform;
+    }
+
+    void SoftwareRenderBackend::ResetTransform() {
+        m_transform = Transform2D::Identity();
+    }
+
+    bool SoftwareRenderBackend::IsAxisAligned() const noexcept {
+        return m_transform.m12 == 0.0f && m_transform.m21 == 0.0f;
+    }
+
+    float SoftwareRenderBackend::GetTransformScale() const noexcept {
+        const float det = m_transform.m11 * m_transform.m22
+            - m_transform.m12 * m_transform.m21;
+        return std::sqrt(std::abs(det));
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Recording Helpers
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    SoftwareRenderBackend::Paint SoftwareRenderBackend::MakeSolidPaint(
+        const Color& color
+    ) const {
+        Paint paint;
+        paint.color = PackPremultiplied(color);
+        return paint;
+    }
+
+    // Stops are expected in ascending order, as Direct2D requires
+    uint32_t SoftwareRenderBackend::BuildGradientLut(
+        const GradientStop* stops,
+        size_t stopCount
+    ) {
+        const uint32_t offset = static_cast<uint32_t>(m_gradientLuts.size());
+        m_gradientLuts.resize(offset + GRADIENT_LUT_SIZE);
+        uint32_t* lut = m_gradientLuts.data() + offset;
+
+        size_t next = 0;
+        for (int i = 0; i < GRADIENT_LUT_SIZE; ++i) {
+            const float t = static_cast<float>(i) / (GRADIENT_LUT_SIZE - 1);
+            while (next < stopCount && stops[next].position <= t) ++next;
+
+            Color color;
+            if (next == 0) {
+                color = stops[0].color;
+            }
+            else if (next == stopCount) {
+                color = stops[stopCount - 1].color;
+            }
+            else {
+                const GradientStop& a = stops[next - 1];
+                const GradientStop& b = stops[next];
+                const float span = b.position - a.position;
+                const float f = span > 0.0f ? (t - a.position) / span : 1.0f;
+                color = Color(
+                    Utils::Lerp(a.color.r, b.color.r, f),
+                    Utils::Lerp(a.color.g, b.color.g, f),
+                    Utils::Lerp(a.color.b, b.color.b, f),
+                    Utils::Lerp(a.color.a, b.color.a, f)
+                );
+            }
+            lut[i] = PackPremultiplied(color);
+        }
+        return offset;
+    }
+
+    void SoftwareRenderBackend::AddBox(
+        ShapeType shape,
+        const Rect& rect,
+        float radius,
+        const Paint& paint,
+        bool filled,
+        float strokeWidth
+    ) {
+        if (rect.width <= 0.0f || rect.height <= 0.0f) return;
+        radius = std::clamp(radius, 0.0f, std::min(rect.width, rect.height) * 0.5f);
+
+        if (!IsAxisAligned()) {
+            if (shape == ShapeType::RoundedRect && radius > 0.0f) {
+                TessellateRoundedRect(rect, radius);
+            }
+            else {
+                m_pathScratch = {
+                    { rect.x, rect.y },
+                    { rect.GetRight(), rect.y },
+                    { rect.GetRight(), rect.GetBottom() },
+                    { rect.x, rect.GetBottom() }
+                };
+            }
+            if (filled) {
+                AddPolygon(m_pathScratch.data(), m_pathScratch.size(), paint);
+            }
+            else {
+                AddStrokes(
+                    m_pathScratch.data(), m_pathScratch.size(), true, paint, strokeWidth
+                );
+            }
+            return;
+        }
+
+        const Point a = m_transform.TransformPoint({ rect.x, rect.y });
+        const Point b = m_transform.TransformPoint({ rect.GetRight(), rect.GetBottom() });
+        const float scaleX = std::abs(m_transform.m11);
+        const float scaleY = std::abs(m_transform.m22);
+
+        Primitive p{};
+        p.shape = (filled && radius == 0.0f) ? ShapeType::Rect : ShapeType::RoundedRect;
+        p.stroke = !filled;
+        p.paint = paint;
+        p.center = Point((a.x + b.x) * 0.5f, (a.y + b.y) * 0.5f);
+        p.halfSize = Point(std::abs(b.x - a.x) * 0.5f, std::abs(b.y - a.y) * 0.5f);
+        p.radius = radius * std::min(scaleX, scaleY);
+        p.halfWidth = filled ? 0.0f : strokeWidth * GetTransformScale() * 0.5f;
+
+        const float margin = p.halfWidth + 1.0f;
+        p.left = p.center.x - p.halfSize.x - margin;
+        p.right = p.center.x + p.halfSize.x + margin;
+        p.top = p.center.y - p.halfSize.y - margin;
+        p.bottom = p.center.y + p.halfSize.y + margin;
+        AddPrimitive(p);
+    }
+
+    void SoftwareRenderBackend::AddEllipse(
+        const Point& center,
+        float radiusX,
+        float radiusY,
+        const Paint& paint,
+        bool filled,
+        float strokeWidth
+    ) {
+        if (radiusX <= 0.0f || radiusY <= 0.0f) return;
+
+        if (!IsAxisAligned()) {
+            TessellateEllipse(center, radiusX, radiusY);
+            if (filled) {
+                AddPolygon(m_pathScratch.data(), m_pathScratch.size(), paint);
+            }
+            else {
+                AddStrokes(
+                    m_pathScratch.data(), m_pathScratch.size(), true, paint, strokeWidth
+                );
+            }
+            return;
+        }
+
+        Primitive p{};
+        p.shape = ShapeType::Ellipse;
+        p.stroke = !filled;
+        p.paint = paint;
+        p.center = m_transform.TransformPoint(center);
+        p.halfSize = Point(
+            radiusX * std::abs(m_transform.m11),
+            radiusY * std::abs(m_transform.m22)
+        );
+        p.halfWidth = filled ? 0.0f : strokeWidth * GetTransformScale() * 0.5f;
+
+        const float margin = p.halfWidth + 1.0f;
+        p.left = p.center.x - p.halfSize.x - margin;
+        p.right = p.center.x + p.halfSize.x + margin;
+        p.top = p.center.y - p.halfSize.y - margin;
+        p.bottom = p.center.y + p.halfSize.y + margin;
+        AddPrimitive(p);
+    }
+
+    void SoftwareRenderBackend::AddPolygon(
+        const Point* points,
+        size_t count,
+        const Paint& paint
+    ) {
+        if (count < 3) return;
+
+        Primitive p{};
+        p.shape = ShapeType::Polygon;
+        p.paint = paint;
+        p.first = static_cast<uint32_t>(m_vertices.size());
+        p.count = static_cast<uint32_t>(count);
+        p.left = p.top = std::numeric_limits<float>::max();
+        p.right = p.bottom = std::numeric_limits<float>::lowest();
+
+        for (size_t i = 0; i < count; ++i) {
+            const Point v = m_transform.TransformPoint(points[i]);
+            m_vertices.push_back(v);
+            p.left = std::min(p.left, v.x);
+            p.right = std::max(p.right, v.x);
+            p.top = std::min(p.top, v.y);
+            p.bottom = std::max(p.bottom, v.y);
+        }
+        p.right += 1.0f;
+        p.bottom += 1.0f;
+        AddPrimitive(p);
+    }
+
+    // Strokes are a union of capsules, so joins are round and overlapping
+    // segments of one polyline never blend twice
+    void SoftwareRenderBackend::AddStrokes(
+        const Point* points,
+        size_t count,
+        bool closed,
+        const Paint& paint,
+        float strokeWidth
+    ) {
+        if (count < 2 || strokeWidth <= 0.0f) return;
+
+        Primitive p{};
+        p.shape = ShapeType::Strokes;
+        p.stroke = true;
+        p.paint = paint;
+        p.halfWidth = strokeWidth * GetTransformScale() * 0.5f;
+        p.first = static_cast<uint32_t>(m_segments.size());
+        p.left = p.top = std::numeric_limits<float>::max();
+        p.right = p.bottom = std::numeric_limits<float>::lowest();
+
+        Point previous = m_transform.TransformPoint(points[0]);
+        const Point first = previous;
+        const size_t segmentCount = closed ? count : count - 1;
+        for (size_t i = 1; i <= segmentCount; ++i) {
+            const Point current = (i == count)
+                ? first
+                : m_transform.TransformPoint(points[i]);
+            m_segments.push_back({ previous, current });
+
+            p.left = std::min({ p.left, previous.x, current.x });
+            p.right = std::max({ p.right, previous.x, current.x });
+            p.top = std::min({ p.top, previous.y, current.y });
+            p.bottom = std::max({ p.bottom, previous.y, current.y });
+            previous = current;
+        }
+        p.count = static_cast<uint32_t>(segmentCount);
+
+        const float margin = p.halfWidth + 1.0f;
+        p.left -= margin;
+        p.right += margin;
+        p.top -= margin;
+        p.bottom += margin;
+        AddPrimitive(p);
+    }
+
+    void SoftwareRenderBackend::AddImage(
+        const Rect& deviceRect,
+        const uint32_t* pixels,
+        int width,
+        int height,
+        int stride
+    ) {
+        if (deviceRect.width <= 0.0f || deviceRect.height <= 0.0f) return;
+
+        Paint paint;
+        paint.type = PaintType::Image;
+        paint.image = pixels;
+        paint.imageWidth = width;
+        paint.imageHeight = height;
+        paint.imageStride = stride;
+        paint.origin = { deviceRect.x, deviceRect.y };
+        paint.axis = { width / deviceRect.width, height / deviceRect.height };
+
+        const Transform2D saved = m_transform;
+        m_transform = Transform2D::Identity();
+        AddBox(ShapeType::Rect, deviceRect, 0.0f, paint, true, 0.0f);
+        m_transform = saved;
+    }
+
+    void SoftwareRenderBackend::AddPrimitive(const Primitive& primitive) {
+        if (primitive.right <= 0.0f || primitive.bottom <= 0.0f) return;
+        if (primitive.left >= m_width || primitive.top >= m_height) return;
+        if (primitive.paint.type == PaintType::Solid
+            && (primitive.paint.color >> 24) == 0) return;
+
+        m_primitives.push_back(primitive);
+    }
+
+    void SoftwareRenderBackend::TessellateRoundedRect(const Rect& rect, float radius) {
+        m_pathScratch.clear();
+        const Point corners[4] = {
+            { rect.GetRight() - radius, rect.y + radius },
+            { rect.GetRight() - radius, rect.GetBottom() - radius },
+            { rect.x + radius, rect.GetBottom() - radius },
+            { rect.x + radius, rect.y + radius }
+        };
+        for (int c = 0; c < 4; ++c) {
+            const float startAngle = -HALF_PI + c * HALF_PI;
+            for (int i = 0; i <= CORNER_SEGMENTS; ++i) {
+                const float angle = startAngle + HALF_PI * i / CORNER_SEGMENTS;
+                m_pathScratch.push_back({
+                    corners[c].x + radius * std::cos(angle),
+                    corners[c].y + radius * std::sin(angle)
+                    });
+            }
+        }
+    }
+
+    void SoftwareRenderBackend::TessellateEllipse(
+        const Point& center,
+        float radiusX,
+        float radiusY
+    ) {
+        const float scale = GetTransformScale();
+        const int segments = CurveSegmentCount(radiusX * scale, radiusY * scale);
+
+        m_pathScratch.resize(segments);
+        for (int i = 0; i < segments; ++i) {
+            const float angle = TWO_PI * i / segments;
+            m_pathScratch[i] = {
+                center.x + radiusX * std::cos(angle),
+                center.y + radiusY * std::sin(angle)
+            };
+        }
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Rasterization
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    void SoftwareRenderBackend::Flush() {
+        if (m_primitives.empty() || m_tiles.empty()) {
+            m_primitives.clear();
+            return;
+        }
+
+        BinPrimitives();
+
+        const auto rasterize = [this](size_t index) {
+            const Tile& tile = m_tiles[index];
+            if (!tile.primitives.empty()) RasterizeTile(tile);
+        };
+        if (m_scheduler) {
+            m_scheduler->ParallelFor(m_tiles.size(), rasterize);
+        }
+        else {
+            for (size_t i = 0; i < m_tiles.size(); ++i) rasterize(i);
+        }
+
+        m_primitives.clear();
+        m_vertices.clear();
+        m_segments.clear();
+        m_gradientLuts.clear();
+    }
+
+    void SoftwareRenderBackend::BinPrimitives() {
+        for (auto& tile : m_tiles) tile.primitives.clear();
+
+        for (size_t i = 0; i < m_primitives.size(); ++i) {
+            const Primitive& p = m_primitives[i];
+            const int tx0 = PixelClamp(p.left, m_width) / TILE_SIZE;
+            const int ty0 = PixelClamp(p.top, m_height) / TILE_SIZE;
+            const int tx1 = std::min(m_tilesX - 1, PixelClamp(p.right, m_width) / TILE_SIZE);
+            const int ty1 = std::min(m_tilesY - 1, PixelClamp(p.bottom, m_height) / TILE_SIZE);
+
+            for (int ty = ty0; ty <= ty1; ++ty) {
+                for (int tx = tx0; tx <= tx1; ++tx) {
+                    m_tiles[static_cast<size_t>(ty) * m_tilesX + tx]
+                        .primitives.push_back(static_cast<uint32_t>(i));
+                }
+            }
+        }
+    }
+
+    void SoftwareRenderBackend::RasterizeTile(const Tile& tile) {
+        for (uint32_t index : tile.primitives) {
+            RasterizePrimitive(m_primitives[index], tile);
+        }
+    }
+
+    void SoftwareRenderBackend::RasterizePrimitive(
+        const Primitive& p,
+        const Tile& tile
+    ) {
+        const int x0 = std::max(tile.x0, PixelClamp(std::floor(p.left), m_width));
+        const int x1 = std::min(tile.x1, PixelClamp(std::ceil(p.right), m_width));
+        const int y0 = std::max(tile.y0, PixelClamp(std::floor(p.top), m_height));
+        const int y1 = std::min(tile.y1, PixelClamp(std::ceil(p.bottom), m_height));
+        if (x0 >= x1 || y0 >= y1) return;
+
+        const int width = x1 - x0;
+        float coverage[TILE_SIZE];
+
+        // Per-thread scratch for the edge and segment subsets of this tile
+        static thread_local std::vector<Edge> edges;
+        static thread_local std::vector<const Segment*> segments;
+        static thread_local std::vector<std::pair<float, int>> crossings;
+
+        if (p.shape == ShapeType::Polygon) {
+            edges.clear();
+            for (uint32_t i = 0; i < p.count; ++i) {
+                const Point& a = m_vertices[p.first + i];
+                const Point& b = m_vertices[p.first + (i + 1) % p.count];
+                if (a.y == b.y) continue;
+
+                Edge e{};
+                e.direction = (a.y < b.y) ? 1 : -1;
+                const Point& top = (a.y < b.y) ? a : b;
+                const Point& bottom = (a.y < b.y) ? b : a;
+                if (bottom.y <= y0 || top.y >= y1) continue;
+                // Edges right of the tile never change its winding
+                if (std::min(a.x, b.x) >= x1) continue;
+
+                e.x0 = top.x;
+                e.y0 = top.y;
+                e.x1 = bottom.x;
+                e.y1 = bottom.y;
+                e.dxdy = (bottom.x - top.x) / (bottom.y - top.y);
+                edges.push_back(e);
+            }
+            if (edges.empty()) return;
+        }
+        else if (p.shape == ShapeType::Strokes) {
+            segments.clear();
+            const float reach = p.halfWidth + 1.0f;
+            for (uint32_t i = 0; i < p.count; ++i) {
+                const Segment& s = m_segments[p.first + i];
+                if (std::max(s.a.x, s.b.x) + reach < x0) continue;
+                if (std::min(s.a.x, s.b.x) - reach > x1) continue;
+                if (std::max(s.a.y, s.b.y) + reach < y0) continue;
+                if (std::min(s.a.y, s.b.y) - reach > y1) continue;
+                segments.push_back(&s);
+            }
+            if (segments.empty()) return;
+        }
+
+        for (int y = y0; y < y1; ++y) {
+            const float py = y + 0.5f;
+            std::fill(coverage, coverage + width, 0.0f);
+
+            switch (p.shape) {
+            case ShapeType::Rect: {
+                const float top = p.center.y - p.halfSize.y;
+                const float bottom = p.center.y + p.halfSize.y;
+                const float left = p.center.x - p.halfSize.x;
+                const float right = p.center.x + p.halfSize.x;
+                const float rowCoverage = Overlap(
+                    static_cast<float>(y), static_cast<float>(y + 1), top, bottom
+                );
+                if (rowCoverage <= 0.0f) continue;
+                for (int i = 0; i < width; ++i) {
+                    const float x = static_cast<float>(x0 + i);
+                    coverage[i] = rowCoverage * Overlap(x, x + 1.0f, left, right);
+                }
+                break;
+            }
+            case ShapeType::RoundedRect: {
+                for (int i = 0; i < width; ++i) {
+                    const Point local(x0 + i + 0.5f - p.center.x, py - p.center.y);
+                    const float d = BoxDistance(local, p.halfSize, p.radius);
+                    coverage[i] = p.stroke
+                        ? StrokeCoverage(std::abs(d), p.halfWidth)
+                        : Utils::Saturate(0.5f - d);
+                }
+                break;
+            }
+            case ShapeType::Ellipse: {
+                for (int i = 0; i < width; ++i) {
+                    const Point local(x0 + i + 0.5f - p.center.x, py - p.center.y);
+                    const float d = EllipseDistance(local, p.halfSize);
+                    coverage[i] = p.stroke
+                        ? StrokeCoverage(std::abs(d), p.halfWidth)
+                        : Utils::Saturate(0.5f - d);
+                }
+                break;
+            }
+            case ShapeType::Polygon: {
+                for (int s = 0; s < SUBSAMPLES; ++s) {
+                    const float sy = y + (s + 0.5f) * SUBSAMPLE_WEIGHT;
+
+                    crossings.clear();
+                    int winding = 0;
+                    for (const Edge& e : edges) {
+                        if (sy < e.y0 || sy >= e.y1) continue;
+                        const float x = e.x0 + (sy - e.y0) * e.dxdy;
+                        if (x < x0) {
+                            winding += e.direction;
+                        }
+                        else {
+                            crossings.emplace_back(x, e.direction);
+                        }
+                    }
+                    std::sort(crossings.begin(), crossings.end());
+
+                    // Non-zero fill rule, walking left to right
+                    float spanStart = static_cast<float>(x0);
+                    for (const auto& [x, direction] : crossings) {
+                        const int next = winding + direction;
+                        if (winding == 0 && next != 0) {
+                            spanStart = x;
+                        }
+                        else if (winding != 0 && next == 0) {
+                            AccumulateSpan(coverage, x0, width, spanStart, x, SUBSAMPLE_WEIGHT);
+                        }
+                        winding = next;
+                    }
+                    if (winding != 0) {
+                        AccumulateSpan(
+                            coverage, x0, width, spanStart,
+                            static_cast<float>(x1), SUBSAMPLE_WEIGHT
+                        );
+                    }
+                }
+                break;
+            }
+            case ShapeType::Strokes: {
+                const float reach = p.halfWidth + 1.0f;
+                for (const Segment* s : segments) {
+                    if (std::max(s->a.y, s->b.y) + reach < y) continue;
+                    if (std::min(s->a.y, s->b.y) - reach > y + 1) continue;
+
+                    const int sx0 = std::max(
+                        x0, static_cast<int>(std::floor(std::min(s->a.x, s->b.x) - reach))
+                    );
+                    const int sx1 = std::min(
+                        x1, static_cast<int>(std::ceil(std::max(s->a.x, s->b.x) + reach))
+                    );
+                    for (int x = sx0; x < sx1; ++x) {
+                        const float d = SegmentDistance({ x + 0.5f, py }, s->a, s->b);
+                        float& c = coverage[x - x0];
+                        c = std::max(c, StrokeCoverage(d, p.halfWidth));
+                    }
+                }
+                break;
+            }
+            }
+
+            CompositeRow(p.paint, coverage, x0, y, width);
+        }
+    }
+
+    void SoftwareRenderBackend::CompositeRow(
+        const Paint& paint,
+        const float* coverage,
+        int x,
+        int y,
+        int count
+    ) {
+        uint32_t* dst = m_pixels.data() + static_cast<size_t>(y) * m_width + x;
+
+        if (paint.type == PaintType::Solid) {
+            int i = 0;
+            while (i < count) {
+                if (coverage[i] >= FULL_COVERAGE) {
+                    int end = i + 1;
+                    while (end < count && coverage[end] >= FULL_COVERAGE) ++end;
+                    FillSpan(dst + i, end - i, paint.color);
+                    i = end;
+                    continue;
+                }
+                if (coverage[i] > MIN_COVERAGE) {
+                    dst[i] = BlendPixel(dst[i], ScalePixel(paint.color, ToByte(coverage[i])));
+                }
+                ++i;
+            }
+            return;
+        }
+
+        if (paint.type == PaintType::Image) {
+            const int sy = std::clamp(
+                static_cast<int>((y + 0.5f - paint.origin.y) * paint.axis.y),
+                0, paint.imageHeight - 1
+            );
+            const uint32_t* row = paint.image + static_cast<size_t>(sy) * paint.imageStride;
+            const float u0 = (x + 0.5f - paint.origin.x) * paint.axis.x;
+
+            for (int i = 0; i < count; ++i) {
+                if (coverage[i] <= MIN_COVERAGE) continue;
+
+                const int sx = std::clamp(
+                    static_cast<int>(u0 + i * paint.axis.x), 0, paint.imageWidth - 1
+                );
+                uint32_t color = row[sx];
+                if ((color >> 24) == 0) continue;
+
+                if (coverage[i] < FULL_COVERAGE) {
+                    color = ScalePixel(color, ToByte(coverage[i]));
+                }
+                dst[i] = BlendPixel(dst[i], color);
+            }
+            return;
+        }
+
+        const uint32_t* lut = m_gradientLuts.data() + paint.lutOffset;
+        const float py = y + 0.5f;
+        for (int i = 0; i < count; ++i) {
+            if (coverage[i] <= MIN_COVERAGE) continue;
+
+            const float dx = x + i + 0.5f - paint.origin.x;
+            const float dy = py - paint.origin.y;
+            float t;
+            if (paint.type == PaintType::Linear) {
+                t = dx * paint.axis.x + dy * paint.axis.y;
+            }
+            else {
+                const float nx = dx * paint.axis.x;
+                const float ny = dy * paint.axis.y;
+                t = std::sqrt(nx * nx + ny * ny);
+            }
+
+            const int index = std::clamp(
+                static_cast<int>(t * (GRADIENT_LUT_SIZE - 1) + 0.5f),
+                0, GRADIENT_LUT_SIZE - 1
+            );
+            uint32_t color = lut[index];
+            if (coverage[i] < FULL_COVERAGE) {
+                color = ScalePixel(color, ToByte(coverage[i]));
+            }
+            dst[i] = BlendPixel(dst[i], color);
+        }
+    }
+
+}
@@ -0,0 +1,316 @@
+// =-=-=-=-=-=-=-=-=-=-=
+// SoftwareRenderBackend.h
+// =-=-=-=-=-=-=-=-=-=-=
+
+#ifndef SPECTRUM_CPP_SOFTWARE_RENDER_BACKEND_H
+#define SPECTRUM_CPP_SOFTWARE_RENDER_BACKEND_H
+
+#include "Common.h"
+#include "GlyphAtlas.h"
+#include "IRenderBackend.h"
+
+namespace Spectrum {
+
+    class TaskScheduler;
+
+    // CPU rasterizer drawing into a premultiplied BGRA framebuffer.
+    // Draw calls become device-space primitives; EndDraw bins them into
+    // tiles and rasterizes the tiles in parallel. Each tile replays its
+    // primitives in submission order, so blending matches a GPU target.
+    class SoftwareRenderBackend final : public IRenderBackend {
+    public:
+        struct TextCacheStats {
+            size_t runHits = 0;
+            size_t runMisses = 0;
+            size_t cachedRuns = 0;
+            size_t glyphPages = 0;
+        };
+
+        explicit SoftwareRenderBackend(TaskScheduler* scheduler = nullptr);
+        ~SoftwareRenderBackend() override = default;
+
+        void Resize(int width, int height);
+        void BeginDraw();
+        void EndDraw();
+        void Clear(const Color& color);
+
+        // One uint32_t per pixel (A in the high byte), rows tightly packed
+        const uint32_t* GetPixels() const noexcept { return m_pixels.data(); }
+        int GetWidth() const noexcept { return m_width; }
+        int GetHeight() const noexcept { return m_height; }
+
+        TextCacheStats GetTextCacheStats() const noexcept;
+        void ResetTextCacheStats() noexcept { m_textRunHits = m_textRunMisses = 0; }
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // IRenderBackend Implementation
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        void DrawRectangle(
+            const Rect& rect,
+            const Color& color,
+            bool filled = true,
+            float strokeWidth = 1.0f
+        ) override;
+        void DrawRoundedRectangle(
+            const Rect& rect,
+            float radius,
+            const Color& color,
+            bool filled = true,
+            float strokeWidth = 1.0f
+        ) override;
+        void DrawEllipse(
+            const Point& center,
+            float radiusX,
+            float radiusY,
+            const Color& color,
+            bool filled = true,
+            float strokeWidth = 1.0f
+        ) override;
+        void DrawLine(
+            const Point& start,
+            const Point& end,
+            const Color& color,
+            float strokeWidth = 1.0f
+        ) override;
+        void DrawPolyline(
+            const Point* points,
+            size_t count,
+            const Color& color,
+            float strokeWidth = 1.0f
+        ) override;
+        void DrawPolygon(
+            const Point* points,
+            size_t count,
+            const Color& color,
+            bool filled = true,
+            float strokeWidth = 1.0f
+        ) override;
+        void DrawGeometry(
+            GeometryHandle handle,
+            const Point* points,
+            size_t count,
+            bool closed,
+            const Color& color,
+            bool filled = true,
+            float strokeWidth = 1.0f
+        ) override;
+        void DrawGeometryInstances(
+            GeometryHandle handle,
+            const Point* points,
+            size_t count,
+            bool closed,
+            const GeometryInstance* instances,
+            size_t instanceCount,
+            bool filled = true
+        ) override;
+        void FillRectangles(
+            const Rect* rects,
+            size_t count,
+            const Color& color
+        ) override;
+        void FillEllipses(
+            const Rect* bounds,
+            size_t count,
+            const Color& color
+        ) override;
+        void DrawGradientRectangle(
+            const Rect& rect,
+            const GradientStop* stops,
+            size_t stopCount,
+            bool horizontal = true
+        ) override;
+        void DrawRadialGradient(
+            const Point& center,
+            float radius,
+            const GradientStop* stops,
+            size_t stopCount
+        ) override;
+        void DrawImage(
+            const RetainedImage& image,
+            const Rect& destination,
+            const Rect& source = Rect()
+        ) override;
+        void DrawLayer(
+            LayerHandle handle,
+            const RenderCommandList& content
+        ) override;
+        void DrawText(
+            std::wstring_view text,
+            const Point& position,
+            const Color& color,
+            float fontSize = 12.0f,
+            TextAlignment alignment = TextAlignment::Leading
+        ) override;
+        void SetTransform(const Transform2D& transform) override;
+        void ResetTransform() override;
+
+    private:
+        enum class ShapeType : uint8_t {
+            Rect, RoundedRect, Ellipse, Polygon, Strokes
+        };
+        enum class PaintType : uint8_t {
+            Solid, Linear, Radial, Image
+        };
+
+        struct Paint {
+            PaintType type = PaintType::Solid;
+            uint32_t color = 0;       // Premultiplied, solid paints only
+            uint32_t lutOffset = 0;   // Gradient ramp in m_gradientLuts
+            Point origin;             // Linear start or radial centre
+            Point axis;               // Linear: dir / |dir|^2, radial: 1 / radii
+            const uint32_t* image = nullptr; // Image: origin + axis map pixels to texels
+            int imageWidth = 0;
+            int imageHeight = 0;
+            int imageStride = 0;      // Texels from one image row to the next
+        };
+
+        // All coordinates are in device pixels
+        struct Primitive {
+            ShapeType shape;
+            bool stroke;
+            Paint paint;
+            float left, top, right, bottom;
+            Point center;             // Rect, RoundedRect, Ellipse
+            Point halfSize;           // Half extents or ellipse radii
+            float radius;             // RoundedRect corner
+            float halfWidth;          // Stroke half width
+            uint32_t first;           // Polygon vertex or stroke segment
+            uint32_t count;
+        };
+
+        struct Segment {
+            Point a;
+            Point b;
+        };
+
+        struct Tile {
+            int x0, y0, x1, y1;
+            std::vector<uint32_t> primitives;
+        };
+
+        // A string rasterized at one size and color, drawn as an image.
+        // Entries are only trimmed after a flush, so queued primitives
+        // never point at freed pixels.
+        struct TextRunKey {
+            std::wstring text;
+            int pixelSize = 0;
+            uint32_t color = 0;
+
+            bool operator==(const TextRunKey& other) const noexcept {
+                return pixelSize == other.pixelSize
+                    && color == other.color
+                    && text == other.text;
+            }
+        };
+
+        struct TextRunKeyHash {
+            size_t operator()(const TextRunKey& key) const noexcept;
+        };
+
+        struct TextRun {
+            int width = 0;
+            int height = 0;
+            std::vector<uint32_t> pixels;
+            uint64_t lastUsedFrame = 0;
+        };
+
+        // A nested backend renders the layer; its pixels become a paint
+        struct Layer {
+            std::unique_ptr<SoftwareRenderBackend> surface;
+            uint32_t revision = 0;
+        };
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Recording Helpers
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        Paint MakeSolidPaint(const Color& color) const;
+        uint32_t BuildGradientLut(const GradientStop* stops, size_t stopCount);
+
+        void AddBox(
+            ShapeType shape,
+            const Rect& rect,
+            float radius,
+            const Paint& paint,
+            bool filled,
+            float strokeWidth
+        );
+        void AddEllipse(
+            const Point& center,
+            float radiusX,
+            float radiusY,
+            const Paint& paint,
+            bool filled,
+            float strokeWidth
+        );
+        void AddPolygon(const Point* points, size_t count, const Paint& paint);
+        void AddStrokes(
+            const Point* points,
+            size_t count,
+            bool closed,
+            const Paint& paint,
+            float strokeWidth
+        );
+        void AddImage(
+            const Rect& deviceRect,
+            const uint32_t* pixels,
+            int width,
+            int height,
+            int stride
+        );
+        void AddPrimitive(const Primitive& primitive);
+
+        const TextRun& GetTextRun(std::wstring_view text, int pixelSize, uint32_t color);
+        void TrimTextRuns();
+
+        void TessellateRoundedRect(const Rect& rect, float radius);
+        void TessellateEllipse(const Point& center, float radiusX, float radiusY);
+
+        bool IsAxisAligned() const noexcept;
+        float GetTransformScale() const noexcept;
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Rasterization
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        void Flush();
+        void BinPrimitives();
+        void RasterizeTile(const Tile& tile);
+        void RasterizePrimitive(const Primitive& primitive, const Tile& tile);
+        void CompositeRow(
+            const Paint& paint,
+            const float* coverage,
+            int x,
+            int y,
+            int count
+        );
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Member State
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        TaskScheduler* m_scheduler;
+        int m_width;
+        int m_height;
+        std::vector<uint32_t> m_pixels;
+
+        int m_tilesX;
+        int m_tilesY;
+        std::vector<Tile> m_tiles;
+
+        Transform2D m_transform;
+        std::vector<Primitive> m_primitives;
+        std::vector<Point> m_vertices;
+        std::vector<Segment> m_segments;
+        std::vector<uint32_t> m_gradientLuts;
+        std::vector<Point> m_pathScratch;
+        std::unordered_map<uint32_t, Layer> m_layers;
+
+        GlyphAtlas m_glyphAtlas;
+        std::unordered_map<TextRunKey, TextRun, TextRunKeyHash> m_textRuns;
+        TextRunKey m_textRunLookup;
+        uint64_t m_frameIndex;
+        size_t m_textRunHits;
+        size_t m_textRunMisses;
+    };
+
+}
+
+#endif
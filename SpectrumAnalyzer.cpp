@@ -6,116 +6,273 @@
 
 namespace Spectrum {
 
-    void SpectrumAnalyzer::AudioBufferManager::Add(
-        const float* data,
-        size_t frames,
-        int channels
-    ) {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_buffer.reserve(m_buffer.size() + frames);
-        const float invChannels = 1.0f / static_cast<float>(channels);
-
-        for (size_t frame = 0; frame < frames; ++frame) {
-            const float* frameData = data + frame * static_cast<size_t>(channels);
-            float monoSample = 0.0f;
-            for (int ch = 0; ch < channels; ++ch) {
-                monoSample += frameData[ch];
-            }
-            m_buffer.push_back(monoSample * invChannels);
-        }
-    }
+    namespace {
+        // ~1.3 s of 48 kHz stereo; sized so the capture thread never waits
+        constexpr size_t RING_BUFFER_CAPACITY = 1u << 17;
 
-    bool SpectrumAnalyzer::AudioBufferManager::HasEnoughData(
-        size_t required
-    ) const {
-        std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(m_mutex));
-        return m_buffer.size() >= required;
-    }
-
-    void SpectrumAnalyzer::AudioBufferManager::CopyTo(
-        AudioBuffer& dest,
-        size_t size
-    ) {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        if (m_buffer.size() >= size) {
-            std::copy_n(m_buffer.begin(), size, dest.begin());
-        }
-    }
+        constexpr size_t MIN_FFT_SIZE = 256;
+        constexpr size_t MAX_FFT_SIZE = 16384;
 
-    void SpectrumAnalyzer::AudioBufferManager::Consume(size_t size) {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        if (m_buffer.size() >= size) {
-            m_buffer.erase(m_buffer.begin(), m_buffer.begin() + size);
+        SpectrumHistory::Clock::duration ToClockDuration(double seconds) {
+            return std::chrono::duration_cast<SpectrumHistory::Clock::duration>(
+                std::chrono::duration<double>(seconds)
+            );
         }
     }
 
     SpectrumAnalyzer::SpectrumAnalyzer(size_t barCount, size_t fftSize)
-        : m_barCount(barCount),
-        m_scaleType(SpectrumScale::Logarithmic),
-        m_sampleRate(DEFAULT_SAMPLE_RATE),
+        : m_sampleRate(DEFAULT_SAMPLE_RATE),
+        m_baseFFTSize(fftSize),
+        m_captureSampleRate(DEFAULT_SAMPLE_RATE),
+        m_internalSampleRate(DEFAULT_SAMPLE_RATE),
+        m_resampleInput(false),
         m_fftProcessor(fftSize),
-        m_frequencyMapper(barCount, DEFAULT_SAMPLE_RATE),
-        m_postProcessor(barCount) {
-        m_processBuffer.resize(fftSize);
+        m_primaryView(barCount, SpectrumScale::Logarithmic, DEFAULT_SAMPLE_RATE, fftSize),
+        m_ringBuffer(std::max(RING_BUFFER_CAPACITY, fftSize * 8)),
+        m_sourceChannels(0),
+        m_channels(0),
+        m_processFill(0) {
+        ResizeWorkBuffers();
     }
 
+    // Runs on the capture thread: one copy into the ring, no locks, no allocations.
     void SpectrumAnalyzer::OnAudioData(
         const float* data,
         size_t samples,
         int channels
     ) {
         if (!data || samples == 0 || channels <= 0) return;
-        const size_t frames = samples / static_cast<size_t>(channels);
-        if (frames == 0) return;
 
-        m_bufferManager.Add(data, frames, channels);
+        m_sourceChannels.store(channels, std::memory_order_relaxed);
+        m_ringBuffer.Write(data, samples - samples % static_cast<size_t>(channels));
+
+        if (m_dataListener) m_dataListener();
+    }
+
+    void SpectrumAnalyzer::SetDataListener(std::function<void()> listener) {
+        m_dataListener = std::move(listener);
     }
 
     void SpectrumAnalyzer::Update() {
+        if (!SyncChannelLayout()) return;
+
         const size_t fftSize = m_fftProcessor.GetFFTSize();
         const size_t hopSize = fftSize / 2;
 
-        while (m_bufferManager.HasEnoughData(fftSize)) {
-            ProcessSingleFFTChunk();
-            m_bufferManager.Consume(hopSize);
+        // A window ends at the newest frame drained so far; the frames
+        // still queued behind it were captured after it
+        const auto now = SpectrumHistory::Clock::now();
+        const double framePeriod = 1.0 / static_cast<double>(m_captureSampleRate);
+        size_t queuedFrames = m_ringBuffer.GetAvailable() / static_cast<size_t>(m_channels);
+
+        while (const size_t frames = DrainFrames()) {
+            queuedFrames -= std::min(frames, queuedFrames);
+            const auto windowEnd = now - ToClockDuration(queuedFrames * framePeriod);
+
+            while (m_processFill >= fftSize) {
+                ProcessSingleFFTChunk(windowEnd);
+
+                // Keep the overlapping half (plus any resampler overshoot)
+                std::copy(
+                    m_processBuffer.begin() + hopSize,
+                    m_processBuffer.begin() + m_processFill,
+                    m_processBuffer.begin()
+                );
+                m_processFill -= hopSize;
+            }
         }
     }
 
-    void SpectrumAnalyzer::ProcessSingleFFTChunk() {
-        m_bufferManager.CopyTo(m_processBuffer, m_fftProcessor.GetFFTSize());
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Format Configuration
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    void SpectrumAnalyzer::SetSampleRate(size_t captureSampleRate) {
+        if (captureSampleRate == 0 || captureSampleRate == m_captureSampleRate) return;
+
+        // Samples already in the ring were captured at the old rate and
+        // would be resampled with the wrong step, so start over
+        m_captureSampleRate = captureSampleRate;
+        m_ringBuffer.Clear();
+        Reconfigure();
+    }
+
+    void SpectrumAnalyzer::SetResampling(bool enabled, size_t internalSampleRate) {
+        if (internalSampleRate == 0) return;
+        if (enabled == m_resampleInput && internalSampleRate == m_internalSampleRate) return;
+
+        m_resampleInput = enabled;
+        m_internalSampleRate = internalSampleRate;
+        Reconfigure();
+    }
+
+    void SpectrumAnalyzer::Reconfigure() {
+        const size_t analysisRate = m_resampleInput ? m_internalSampleRate : m_captureSampleRate;
+        const size_t fftSize = ChooseFFTSize(analysisRate);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_sampleRate = analysisRate;
+        m_fftProcessor.SetFFTSize(fftSize);
+        m_primaryView.Configure(analysisRate, fftSize);
+        for (auto& view : m_extraViews) {
+            view->Configure(analysisRate, fftSize);
+        }
+        m_resampler.Configure(m_captureSampleRate, analysisRate);
+        ResizeWorkBuffers();
+
+        LOG_INFO(
+            "Analyzer configured: capture " << m_captureSampleRate << " Hz, analysis "
+            << analysisRate << " Hz, FFT size " << fftSize
+        );
+    }
+
+    // Keeps the bin width the configured FFT size gives at DEFAULT_SAMPLE_RATE
+    size_t SpectrumAnalyzer::ChooseFFTSize(size_t analysisRate) const {
+        const double idealSize = static_cast<double>(m_baseFFTSize)
+            * static_cast<double>(analysisRate)
+            / static_cast<double>(DEFAULT_SAMPLE_RATE);
+
+        size_t fftSize = MIN_FFT_SIZE;
+        while (fftSize < MAX_FFT_SIZE &&
+            std::abs(std::log2(static_cast<double>(fftSize * 2) / idealSize)) <
+            std::abs(std::log2(static_cast<double>(fftSize) / idealSize))) {
+            fftSize *= 2;
+        }
+        return fftSize;
+    }
+
+    void SpectrumAnalyzer::ResizeWorkBuffers() {
+        const size_t fftSize = m_fftProcessor.GetFFTSize();
+
+        m_processBuffer.assign(fftSize + m_resampler.GetOutputSlack(), 0.0f);
+        m_monoBuffer.resize(m_resampler.GetInputFramesFor(fftSize));
+        m_interleavedBuffer.resize(
+            m_monoBuffer.size() * static_cast<size_t>(std::max(m_channels, 1))
+        );
+        m_processFill = 0;
+        m_resampler.Reset();
+    }
+
+    bool SpectrumAnalyzer::SyncChannelLayout() {
+        const int channels = m_sourceChannels.load(std::memory_order_relaxed);
+        if (channels <= 0) return false;
+        if (channels == m_channels) return true;
+
+        // Layout changed (device re-init): samples already in the ring
+        // can't be de-interleaved reliably, so start over
+        m_channels = channels;
+        m_ringBuffer.Clear();
+        ResizeWorkBuffers();
+        return true;
+    }
+
+    // Returns the number of input frames consumed from the ring.
+    size_t SpectrumAnalyzer::DrainFrames() {
+        const size_t channels = static_cast<size_t>(m_channels);
+        const size_t wanted = m_fftProcessor.GetFFTSize() - m_processFill;
+        const size_t frames = std::min({
+            m_resampler.GetInputFramesFor(wanted),
+            m_monoBuffer.size(),
+            m_ringBuffer.GetAvailable() / channels
+        });
+        if (frames == 0) return 0;
+
+        m_ringBuffer.Read(m_interleavedBuffer.data(), frames * channels);
+
+        // Downmix straight into the FFT window unless resampling follows
+        const bool resample = !m_resampler.IsPassthrough();
+        float* dest = resample ? m_monoBuffer.data() : m_processBuffer.data() + m_processFill;
+        const float* src = m_interleavedBuffer.data();
+
+        if (channels == 1) {
+            std::copy_n(src, frames, dest);
+        }
+        else {
+            const float invChannels = 1.0f / static_cast<float>(channels);
+            for (size_t frame = 0; frame < frames; ++frame) {
+                float monoSample = 0.0f;
+                for (size_t ch = 0; ch < channels; ++ch) {
+                    monoSample += src[ch];
+                }
+                dest[frame] = monoSample * invChannels;
+                src += channels;
+            }
+        }
+
+        if (resample) {
+            m_processFill += m_resampler.Process(
+                m_monoBuffer.data(),
+                frames,
+                m_processBuffer.data() + m_processFill,
+                m_processBuffer.size() - m_processFill
+            );
+        }
+        else {
+            m_processFill += frames;
+        }
+        return frames;
+    }
+
+    void SpectrumAnalyzer::ProcessSingleFFTChunk(SpectrumHistory::TimePoint windowEnd) {
         m_fftProcessor.Process(m_processBuffer);
 
-        SpectrumData currentBars(m_barCount, 0.0f);
-        m_frequencyMapper.MapFFTToBars(
-            m_fftProcessor.GetMagnitudes(),
-            currentBars,
-            m_scaleType
+        // The one FFT per hop, whatever the number of views
+        const SpectrumData& magnitudes = m_fftProcessor.GetMagnitudes();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_primaryView.Process(magnitudes, windowEnd);
+        for (auto& view : m_extraViews) {
+            view->Process(magnitudes, windowEnd);
+        }
+    }
+
+    SpectrumView* SpectrumAnalyzer::AddView(size_t barCount, SpectrumScale scaleType) {
+        if (barCount == 0) return nullptr;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto view = std::make_unique<SpectrumView>(
+            barCount, scaleType, m_sampleRate, m_fftProcessor.GetFFTSize()
         );
+        view->SetAmplification(m_primaryView.GetAmplification());
+        view->SetSmoothing(m_primaryView.GetSmoothing());
+        m_extraViews.push_back(std::move(view));
+        return m_extraViews.back().get();
+    }
 
+    void SpectrumAnalyzer::RemoveView(const SpectrumView* view) {
         std::lock_guard<std::mutex> lock(m_mutex);
-        m_postProcessor.Process(currentBars);
+        m_extraViews.erase(
+            std::remove_if(m_extraViews.begin(), m_extraViews.end(),
+                [view](const std::unique_ptr<SpectrumView>& owned) { return owned.get() == view; }),
+            m_extraViews.end()
+        );
+    }
+
+    bool SpectrumAnalyzer::GetInterpolatedSpectrum(
+        SpectrumHistory::TimePoint renderTime,
+        SpectrumData& out
+    ) {
+        return m_primaryView.GetInterpolatedSpectrum(renderTime, out);
     }
 
     SpectrumData SpectrumAnalyzer::GetSpectrum() {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        return m_postProcessor.GetSmoothedBars();
+        return m_primaryView.GetSpectrum();
     }
 
     void SpectrumAnalyzer::SetBarCount(size_t newBarCount) {
-        if (newBarCount == 0 || newBarCount == m_barCount) return;
-
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_barCount = newBarCount;
-        m_frequencyMapper.SetBarCount(newBarCount);
-        m_postProcessor.SetBarCount(newBarCount);
+        m_primaryView.SetBarCount(newBarCount);
     }
 
+    // Views share every setting but their bar count with the analyzer
     void SpectrumAnalyzer::SetAmplification(float newAmplification) {
-        m_postProcessor.SetAmplification(newAmplification);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_primaryView.SetAmplification(newAmplification);
+        for (auto& view : m_extraViews) view->SetAmplification(newAmplification);
     }
 
     void SpectrumAnalyzer::SetSmoothing(float newSmoothing) {
-        m_postProcessor.SetSmoothing(newSmoothing);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_primaryView.SetSmoothing(newSmoothing);
+        for (auto& view : m_extraViews) view->SetSmoothing(newSmoothing);
     }
 
     void SpectrumAnalyzer::SetFFTWindow(FFTWindowType windowType) {
@@ -123,19 +280,24 @@ namespace Spectrum {
     }
 
     void SpectrumAnalyzer::SetScaleType(SpectrumScale scaleType) {
-        m_scaleType = scaleType;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_primaryView.SetScaleType(scaleType);
+        for (auto& view : m_extraViews) view->SetScaleType(scaleType);
     }
 
     const SpectrumData& SpectrumAnalyzer::GetPeakValues() const {
-        return m_postProcessor.GetPeakValues();
+        return m_primaryView.GetPeakValues();
     }
-    size_t SpectrumAnalyzer::GetBarCount() const { return m_barCount; }
+    size_t SpectrumAnalyzer::GetBarCount() const { return m_primaryView.GetBarCount(); }
     float SpectrumAnalyzer::GetAmplification() const {
-        return m_postProcessor.GetAmplification();
+        return m_primaryView.GetAmplification();
     }
     float SpectrumAnalyzer::GetSmoothing() const {
-        return m_postProcessor.GetSmoothing();
+        return m_primaryView.GetSmoothing();
+    }
+    SpectrumScale SpectrumAnalyzer::GetScaleType() const { return m_primaryView.GetScaleType(); }
+    uint64_t SpectrumAnalyzer::GetOverrunCount() const noexcept {
+        return m_ringBuffer.GetOverrunCount();
     }
-    SpectrumScale SpectrumAnalyzer::GetScaleType() const { return m_scaleType; }
 
 }
\ No newline at end of file
@@ -6,26 +6,18 @@
 
 #include "Common.h"
 #include "FFTProcessor.h"
-#include "FrequencyMapper.h"
-#include "SpectrumPostProcessor.h"
-#include "AudioCapture.h"
+#include "SpectrumHistory.h"
+#include "SpectrumView.h"
+#include "IAudioCaptureCallback.h"
+#include "AudioRingBuffer.h"
+#include "AudioResampler.h"
 
 namespace Spectrum {
 
+    // Runs one FFT per hop and hands the magnitudes to every view. The
+    // primary view backs the bar getters and setters below; extra views
+    // add bar configurations without another FFT.
     class SpectrumAnalyzer : public IAudioCaptureCallback {
-    private:
-        class AudioBufferManager {
-        public:
-            void Add(const float* data, size_t frames, int channels);
-            bool HasEnoughData(size_t required) const;
-            void CopyTo(AudioBuffer& dest, size_t size);
-            void Consume(size_t size);
-
-        private:
-            AudioBuffer m_buffer;
-            std::mutex m_mutex;
-        };
-
     public:
         SpectrumAnalyzer(size_t barCount = DEFAULT_BAR_COUNT, size_t fftSize = DEFAULT_FFT_SIZE);
 
@@ -38,27 +30,84 @@ namespace Spectrum {
         void SetFFTWindow(FFTWindowType windowType);
         void SetScaleType(SpectrumScale scaleType);
 
+        // Format configuration; reallocates, so not for the per-frame path
+        void SetSampleRate(size_t captureSampleRate);
+        void SetResampling(bool enabled, size_t internalSampleRate = DEFAULT_SAMPLE_RATE);
+
+        // Extra bar configurations sharing this analyzer's FFT. A view
+        // keeps its own bar count; amplification, smoothing and scale follow
+        // the setters above. It lives until RemoveView() or the analyzer
+        // goes away.
+        SpectrumView* AddView(size_t barCount, SpectrumScale scaleType);
+        void RemoveView(const SpectrumView* view);
+        SpectrumView& GetPrimaryView() noexcept { return m_primaryView; }
+
         SpectrumData GetSpectrum();
+
+        // Bars as of renderTime, blended between published hops a hop
+        // behind it; refills out without allocating. Returns true while
+        // the result still changes as time advances.
+        bool GetInterpolatedSpectrum(
+            SpectrumHistory::TimePoint renderTime,
+            SpectrumData& out
+        );
         const SpectrumData& GetPeakValues() const;
         size_t GetBarCount() const;
         float GetAmplification() const;
         float GetSmoothing() const;
         SpectrumScale GetScaleType() const;
+        size_t GetSampleRate() const noexcept { return m_sampleRate; }
+        size_t GetFFTSize() const noexcept { return m_fftProcessor.GetFFTSize(); }
+        uint64_t GetOverrunCount() const noexcept;
+
+        // Bumped whenever GetSpectrum() would return visibly different bars
+        uint64_t GetSpectrumVersion() const noexcept {
+            return m_primaryView.GetSpectrumVersion();
+        }
+
+        // Every analysis hop's bars, in order, whether or not they changed,
+        // stamped with when the hop's last sample was captured
+        const SpectrumHistory& GetHistory() const noexcept { return m_primaryView.GetHistory(); }
+
+        // Called on the capture thread after each packet; set it before
+        // capture starts and keep it cheap
+        void SetDataListener(std::function<void()> listener);
 
     private:
-        void ProcessSingleFFTChunk();
+        void Reconfigure();
+        size_t ChooseFFTSize(size_t analysisRate) const;
+        void ResizeWorkBuffers();
+        bool SyncChannelLayout();
+        size_t DrainFrames();
+        void ProcessSingleFFTChunk(SpectrumHistory::TimePoint windowEnd);
 
-        size_t m_barCount;
-        SpectrumScale m_scaleType;
         size_t m_sampleRate;
 
+        // Format: m_sampleRate is the analysis rate the mapper works in
+        size_t m_baseFFTSize;
+        size_t m_captureSampleRate;
+        size_t m_internalSampleRate;
+        bool m_resampleInput;
+
         FFTProcessor m_fftProcessor;
-        FrequencyMapper m_frequencyMapper;
-        SpectrumPostProcessor m_postProcessor;
-        AudioBufferManager m_bufferManager;
+        SpectrumView m_primaryView;
+        std::vector<std::unique_ptr<SpectrumView>> m_extraViews;
 
+        // Capture thread -> analyzer handoff (raw interleaved samples)
+        AudioRingBuffer m_ringBuffer;
+        std::atomic<int> m_sourceChannels;
+
+        // Consumer-side state, touched only by Update()
+        int m_channels;
+        LinearResampler m_resampler;
+        AudioBuffer m_interleavedBuffer;
+        AudioBuffer m_monoBuffer;
         AudioBuffer m_processBuffer;
+        size_t m_processFill;
+
+        // Guards the format and the view list against Update()
         std::mutex m_mutex;
+        std::function<void()> m_dataListener;
     };
 
 }
@@ -0,0 +1,155 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// SpectrumHistory.cpp: Implementation of the SpectrumHistory class.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#include "SpectrumHistory.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SPECTRUM_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace Spectrum {
+
+    namespace {
+        constexpr size_t CACHE_LINE_FLOATS = SpectrumHistory::CACHE_LINE_SIZE / sizeof(float);
+
+        // Rows closer than this blend to the same picture at any time
+        constexpr float MIN_VISIBLE_DELTA = 1e-4f;
+
+        // out[i] = saturate(a[i] + (b[i] - a[i]) * t); a and b start on a
+        // cache line, out may not. Returns the largest |b[i] - a[i]|.
+        float LerpRow(const float* a, const float* b, float t, float* out, size_t count) {
+            size_t i = 0;
+            float maxDelta = 0.0f;
+#ifdef SPECTRUM_USE_SSE2
+            const __m128 vt = _mm_set1_ps(t);
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 one = _mm_set1_ps(1.0f);
+            const __m128 signMask = _mm_set1_ps(-0.0f);
+            __m128 maxDeltas = zero;
+            for (; i + 4 <= count; i += 4) {
+                const __m128 va = _mm_load_ps(a + i);
+                const __m128 delta = _mm_sub_ps(_mm_load_ps(b + i), va);
+                const __m128 blended = _mm_add_ps(va, _mm_mul_ps(delta, vt));
+                _mm_storeu_ps(out + i, _mm_min_ps(_mm_max_ps(blended, zero), one));
+                maxDeltas = _mm_max_ps(maxDeltas, _mm_andnot_ps(signMask, delta));
+            }
+            alignas(16) float lanes[4];
+            _mm_store_ps(lanes, maxDeltas);
+            maxDelta = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+#endif
+            for (; i < count; ++i) {
+                const float delta = b[i] - a[i];
+                const float blended = a[i] + delta * t;
+                out[i] = blended < 0.0f ? 0.0f : (blended > 1.0f ? 1.0f : blended);
+                maxDelta = std::max(maxDelta, std::abs(delta));
+            }
+            return maxDelta;
+        }
+    }
+
+    SpectrumHistory::Reader::Reader(const SpectrumHistory& history)
+        : m_history(history),
+        m_lock(history.m_mutex),
+        m_latest(history.m_latest.load(std::memory_order_relaxed)) {
+        const uint64_t overwritten =
+            m_latest > history.m_capacity ? m_latest - history.m_capacity : 0;
+        m_count = static_cast<size_t>(
+            m_latest - std::max(overwritten, history.m_firstRetained)
+        );
+    }
+
+    SpectrumHistory::SpectrumHistory(size_t capacity)
+        : m_capacity(std::max<size_t>(capacity, 1)),
+        m_barCount(0),
+        m_rowStride(0),
+        m_rows(nullptr),
+        m_timestamps(m_capacity),
+        m_firstRetained(0),
+        m_latest(0) {
+    }
+
+    void SpectrumHistory::Push(const float* bars, size_t count, TimePoint timestamp) {
+        if (!bars || count == 0) return;
+
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        const uint64_t latest = m_latest.load(std::memory_order_relaxed);
+
+        // Rows of different widths cannot share the ring
+        if (count != m_barCount) {
+            m_barCount = count;
+            m_rowStride = (count + CACHE_LINE_FLOATS - 1) / CACHE_LINE_FLOATS * CACHE_LINE_FLOATS;
+            m_storage.assign(m_capacity * m_rowStride + CACHE_LINE_FLOATS, 0.0f);
+
+            const uintptr_t base = reinterpret_cast<uintptr_t>(m_storage.data());
+            const uintptr_t aligned = (base + CACHE_LINE_SIZE - 1) & ~(uintptr_t(CACHE_LINE_SIZE) - 1);
+            m_rows = reinterpret_cast<float*>(aligned);
+            m_firstRetained = latest;
+        }
+
+        const size_t slot = static_cast<size_t>(latest % m_capacity);
+        std::copy(bars, bars + count, m_rows + slot * m_rowStride);
+        m_timestamps[slot] = timestamp;
+        m_latest.store(latest + 1, std::memory_order_release);
+    }
+
+    // Sequences keep counting, so readers never see an old number again
+    void SpectrumHistory::Clear() {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        m_firstRetained = m_latest.load(std::memory_order_relaxed);
+    }
+
+    bool SpectrumHistory::Interpolate(
+        TimePoint time,
+        Clock::duration maxExtrapolation,
+        SpectrumData& out
+    ) const {
+        const Reader reader(*this);
+        if (reader.GetCount() == 0) {
+            out.clear();
+            return false;
+        }
+        out.resize(m_barCount);
+
+        // Render times trail the newest row by about a hop, so the pair
+        // is almost always the newest two
+        size_t age = 0;
+        while (age + 2 < reader.GetCount() && reader.GetFrame(age + 1).timestamp > time) {
+            ++age;
+        }
+
+        const Frame newer = reader.GetFrame(age);
+        if (reader.GetCount() == 1) {
+            std::copy(newer.bars, newer.bars + m_barCount, out.begin());
+            return false;
+        }
+
+        const Frame older = reader.GetFrame(age + 1);
+        const double span = std::chrono::duration<double>(newer.timestamp - older.timestamp).count();
+        if (span <= 0.0) {
+            std::copy(newer.bars, newer.bars + m_barCount, out.begin());
+            return false;
+        }
+
+        const double elapsed = std::chrono::duration<double>(time - older.timestamp).count();
+        const double limit = 1.0 + std::chrono::duration<double>(maxExtrapolation).count() / span;
+        const double t = std::clamp(elapsed / span, 0.0, limit);
+
+        const float maxDelta = LerpRow(
+            older.bars, newer.bars, static_cast<float>(t), out.data(), m_barCount
+        );
+        return t < limit && maxDelta > MIN_VISIBLE_DELTA;
+    }
+
+    SpectrumHistory::Frame SpectrumHistory::GetFrame(uint64_t sequence) const noexcept {
+        const size_t slot = static_cast<size_t>((sequence - 1) % m_capacity);
+
+        Frame frame;
+        frame.bars = m_rows + slot * m_rowStride;
+        frame.barCount = m_barCount;
+        frame.sequence = sequence;
+        frame.timestamp = m_timestamps[slot];
+        return frame;
+    }
+
+}
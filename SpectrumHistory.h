@@ -0,0 +1,126 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// SpectrumHistory.h: Ring of the most recently published spectra.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#ifndef SPECTRUM_CPP_SPECTRUM_HISTORY_H
+#define SPECTRUM_CPP_SPECTRUM_HISTORY_H
+
+#include "Common.h"
+#include <shared_mutex>
+
+namespace Spectrum {
+
+    // Producers push one row of bars per analysis hop with the time it
+    // describes; readers look at any retained row, or walk the ones they
+    // have not seen yet by sequence number. Rows live in one preallocated
+    // block, each starting on its own cache line, and are overwritten
+    // oldest first. Readers get pointers into that block, never copies.
+    class SpectrumHistory {
+    public:
+        using Clock = std::chrono::steady_clock;
+        using TimePoint = Clock::time_point;
+
+        static constexpr size_t DEFAULT_CAPACITY = 256;
+        static constexpr size_t CACHE_LINE_SIZE = 64;
+
+        // One published spectrum; bars point into the history's storage
+        struct Frame {
+            const float* bars = nullptr;
+            size_t barCount = 0;
+            uint64_t sequence = 0;
+            TimePoint timestamp;
+        };
+
+        // Read-only view of the retained rows. Readers on different threads
+        // share the history and never wait for each other; producers wait
+        // while any is alive, so every Frame it returns stays valid until
+        // it goes away. Keep it for the span of one renderer update, and
+        // hold at most one per thread: a second Read() or Interpolate() on
+        // the same thread can deadlock behind a waiting producer.
+        class Reader {
+        public:
+            size_t GetCount() const noexcept { return m_count; }
+            size_t GetBarCount() const noexcept { return m_history.m_barCount; }
+            uint64_t GetLatestSequence() const noexcept { return m_latest; }
+
+            // Age 0 is the newest row; age must be below GetCount()
+            Frame GetFrame(size_t age) const noexcept {
+                return m_history.GetFrame(m_latest - age);
+            }
+
+            // Calls visit(frame) for each retained row newer than `after`,
+            // oldest first, and returns the newest sequence
+            template <typename Visitor>
+            uint64_t ForEachSince(uint64_t after, Visitor&& visit) const {
+                const uint64_t oldest = m_latest - m_count;
+                for (uint64_t sequence = std::max(after, oldest) + 1;
+                    sequence <= m_latest; ++sequence) {
+                    visit(m_history.GetFrame(sequence));
+                }
+                return m_latest;
+            }
+
+        private:
+            friend class SpectrumHistory;
+            explicit Reader(const SpectrumHistory& history);
+
+            const SpectrumHistory& m_history;
+            std::shared_lock<std::shared_mutex> m_lock;
+            uint64_t m_latest;
+            size_t m_count;
+        };
+
+        explicit SpectrumHistory(size_t capacity = DEFAULT_CAPACITY);
+
+        SpectrumHistory(const SpectrumHistory&) = delete;
+        SpectrumHistory& operator=(const SpectrumHistory&) = delete;
+
+        // A different bar count drops the retained rows; allocates only then
+        void Push(const float* bars, size_t count, TimePoint timestamp);
+        void Push(const SpectrumData& bars, TimePoint timestamp) {
+            Push(bars.data(), bars.size(), timestamp);
+        }
+        void Clear();
+
+        Reader Read() const { return Reader(*this); }
+
+        // Bars at `time`, blended between the two rows around it. Past the
+        // newest row the last two are extrapolated for at most
+        // maxExtrapolation, then held. Leaves out empty when no row is
+        // retained and resizes it only when the bar count changes. Returns
+        // true while a later time would still give different bars. Opens
+        // its own Reader, so the calling thread must not hold one.
+        bool Interpolate(
+            TimePoint time,
+            Clock::duration maxExtrapolation,
+            SpectrumData& out
+        ) const;
+
+        // Sequence of the newest row; 0 until the first push
+        uint64_t GetLatestSequence() const noexcept {
+            return m_latest.load(std::memory_order_acquire);
+        }
+        size_t GetCapacity() const noexcept { return m_capacity; }
+
+    private:
+        // Caller holds m_mutex and passes a retained sequence
+        Frame GetFrame(uint64_t sequence) const noexcept;
+
+        // Shared by readers, exclusive for Push() and Clear()
+        mutable std::shared_mutex m_mutex;
+        size_t m_capacity;
+        size_t m_barCount;
+        size_t m_rowStride;   // Floats per row, a whole number of cache lines
+
+        // Over-allocated by one cache line; m_rows is the aligned start
+        std::vector<float> m_storage;
+        float* m_rows;
+        std::vector<TimePoint> m_timestamps;
+
+        // Rows up to this sequence were dropped by Clear() or a resize
+        uint64_t m_firstRetained;
+        std::atomic<uint64_t> m_latest;
+    };
+
+}
+
+#endif
@@ -0,0 +1,126 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// SpectrumView.cpp: Implementation of the SpectrumView class.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#include "SpectrumView.h"
+
+namespace Spectrum {
+
+    namespace {
+        // Smaller moves are below a pixel at any window height
+        constexpr float VERSION_EPSILON = 1e-4f;
+
+        // How far past the newest hop a late frame may extrapolate
+        constexpr double MAX_EXTRAPOLATION_HOPS = 0.5;
+
+        SpectrumHistory::Clock::duration ToClockDuration(double seconds) {
+            return std::chrono::duration_cast<SpectrumHistory::Clock::duration>(
+                std::chrono::duration<double>(seconds)
+            );
+        }
+    }
+
+    SpectrumView::SpectrumView(
+        size_t barCount,
+        SpectrumScale scaleType,
+        size_t sampleRate,
+        size_t fftSize
+    ) : m_barCount(barCount),
+        m_scaleType(scaleType),
+        m_fftSize(fftSize),
+        m_hopSeconds(static_cast<double>(fftSize / 2) / static_cast<double>(sampleRate)),
+        m_frequencyMapper(barCount, sampleRate),
+        m_postProcessor(barCount),
+        m_spectrumVersion(0) {
+        m_currentBars.resize(barCount);
+    }
+
+    void SpectrumView::Process(
+        const SpectrumData& magnitudes,
+        SpectrumHistory::TimePoint windowEnd
+    ) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_frequencyMapper.MapFFTToBars(magnitudes, m_currentBars, m_scaleType);
+        m_postProcessor.Process(m_currentBars);
+        m_history.Push(m_postProcessor.GetSmoothedBars(), windowEnd);
+        PublishIfChanged();
+    }
+
+    void SpectrumView::Configure(size_t sampleRate, size_t fftSize) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_fftSize = fftSize;
+        m_hopSeconds = static_cast<double>(fftSize / 2) / static_cast<double>(sampleRate);
+        m_frequencyMapper.SetSampleRate(sampleRate);
+        m_frequencyMapper.Prepare(fftSize, m_scaleType);
+    }
+
+    // Caller holds m_mutex
+    void SpectrumView::PublishIfChanged() {
+        const SpectrumData& bars = m_postProcessor.GetSmoothedBars();
+        bool changed = bars.size() != m_publishedBars.size();
+        for (size_t i = 0; !changed && i < bars.size(); ++i) {
+            changed = std::abs(bars[i] - m_publishedBars[i]) > VERSION_EPSILON;
+        }
+        if (!changed) return;
+
+        m_publishedBars.assign(bars.begin(), bars.end());
+        m_spectrumVersion.fetch_add(1, std::memory_order_release);
+    }
+
+    // One hop behind the render time the two newest hops bracket it, so
+    // the blend only extrapolates when the analyzer falls behind
+    bool SpectrumView::GetInterpolatedSpectrum(
+        SpectrumHistory::TimePoint renderTime,
+        SpectrumData& out
+    ) {
+        double hopSeconds;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            hopSeconds = m_hopSeconds;
+        }
+        const bool blending = m_history.Interpolate(
+            renderTime - ToClockDuration(hopSeconds),
+            ToClockDuration(hopSeconds * MAX_EXTRAPOLATION_HOPS),
+            out
+        );
+
+        // Nothing analyzed yet at this bar count
+        if (out.empty()) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            const SpectrumData& bars = m_postProcessor.GetSmoothedBars();
+            out.assign(bars.begin(), bars.end());
+        }
+        return blending;
+    }
+
+    SpectrumData SpectrumView::GetSpectrum() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_postProcessor.GetSmoothedBars();
+    }
+
+    void SpectrumView::SetBarCount(size_t newBarCount) {
+        if (newBarCount == 0 || newBarCount == m_barCount) return;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_barCount = newBarCount;
+        m_currentBars.assign(newBarCount, 0.0f);
+        m_frequencyMapper.SetBarCount(newBarCount);
+        m_postProcessor.SetBarCount(newBarCount);
+        m_history.Clear();
+        PublishIfChanged();
+    }
+
+    void SpectrumView::SetAmplification(float newAmplification) {
+        m_postProcessor.SetAmplification(newAmplification);
+    }
+
+    void SpectrumView::SetSmoothing(float newSmoothing) {
+        m_postProcessor.SetSmoothing(newSmoothing);
+    }
+
+    void SpectrumView::SetScaleType(SpectrumScale scaleType) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_scaleType = scaleType;
+        m_frequencyMapper.Prepare(m_fftSize, scaleType);
+    }
+
+}
@@ -0,0 +1,79 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// SpectrumView.h: One bar configuration fed from the analyzer's shared FFT.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#ifndef SPECTRUM_CPP_SPECTRUM_VIEW_H
+#define SPECTRUM_CPP_SPECTRUM_VIEW_H
+
+#include "Common.h"
+#include "FrequencyMapper.h"
+#include "SpectrumHistory.h"
+#include "SpectrumPostProcessor.h"
+
+namespace Spectrum {
+
+    // Turns each hop's FFT magnitudes into bars with its own bar count,
+    // scale, smoothing and amplification, and publishes them like the
+    // analyzer used to: a version bump on visible change plus a history
+    // row per hop. Process() runs on the analyzer's thread; the getters
+    // may be called from any thread.
+    class SpectrumView {
+    public:
+        SpectrumView(size_t barCount, SpectrumScale scaleType, size_t sampleRate, size_t fftSize);
+
+        SpectrumView(const SpectrumView&) = delete;
+        SpectrumView& operator=(const SpectrumView&) = delete;
+
+        // Maps and post-processes one hop, stamped with its window end
+        void Process(const SpectrumData& magnitudes, SpectrumHistory::TimePoint windowEnd);
+
+        // Analysis format changed; rebuilds the bin table
+        void Configure(size_t sampleRate, size_t fftSize);
+
+        void SetBarCount(size_t newBarCount);
+        void SetAmplification(float newAmplification);
+        void SetSmoothing(float newSmoothing);
+        void SetScaleType(SpectrumScale scaleType);
+
+        SpectrumData GetSpectrum();
+
+        // Bars as of renderTime, blended between published hops a hop
+        // behind it; refills out without allocating. Returns true while
+        // the result still changes as time advances.
+        bool GetInterpolatedSpectrum(
+            SpectrumHistory::TimePoint renderTime,
+            SpectrumData& out
+        );
+        const SpectrumData& GetPeakValues() const { return m_postProcessor.GetPeakValues(); }
+        size_t GetBarCount() const { return m_barCount; }
+        float GetAmplification() const { return m_postProcessor.GetAmplification(); }
+        float GetSmoothing() const { return m_postProcessor.GetSmoothing(); }
+        SpectrumScale GetScaleType() const { return m_scaleType; }
+
+        // Bumped whenever GetSpectrum() would return visibly different bars
+        uint64_t GetSpectrumVersion() const noexcept {
+            return m_spectrumVersion.load(std::memory_order_acquire);
+        }
+        const SpectrumHistory& GetHistory() const noexcept { return m_history; }
+
+    private:
+        void PublishIfChanged();
+
+        size_t m_barCount;
+        SpectrumScale m_scaleType;
+        size_t m_fftSize;
+        double m_hopSeconds;
+
+        FrequencyMapper m_frequencyMapper;
+        SpectrumPostProcessor m_postProcessor;
+        SpectrumData m_currentBars;
+        std::mutex m_mutex;
+
+        // Bars as of the last version bump
+        SpectrumData m_publishedBars;
+        std::atomic<uint64_t> m_spectrumVersion;
+        SpectrumHistory m_history;
+    };
+
+}
+
+#endif
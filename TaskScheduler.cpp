@@ -0,0 +1,243 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// TaskScheduler.cpp: Implementation of the work-stealing task pool.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#include "TaskScheduler.h"
+
+namespace Spectrum {
+
+    namespace {
+        // Identifies which scheduler/queue the current thread works for
+        thread_local const TaskScheduler* t_owner = nullptr;
+        thread_local size_t t_queueIndex = 0;
+    }
+
+    TaskScheduler::TaskScheduler(size_t workerCount) {
+        if (workerCount == 0) {
+            const size_t hardware = std::thread::hardware_concurrency();
+            workerCount = hardware > 1 ? hardware - 1 : 1;
+        }
+
+        for (size_t i = 0; i < workerCount + 1; ++i) {
+            m_queues.push_back(std::make_unique<WorkerQueue>());
+        }
+
+        m_workers.reserve(workerCount);
+        for (size_t i = 0; i < workerCount; ++i) {
+            m_workers.emplace_back(&TaskScheduler::WorkerLoop, this, i);
+        }
+    }
+
+    TaskScheduler::~TaskScheduler() {
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+            m_stopping = true;
+        }
+        m_sleepCondition.notify_all();
+
+        for (auto& worker : m_workers) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Public API
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    TaskScheduler::TaskHandle TaskScheduler::Submit(
+        Task task,
+        const std::vector<TaskHandle>& dependencies
+    ) {
+        auto node = std::make_shared<TaskNode>();
+        node->function = std::move(task);
+
+        // pendingDependencies starts at 1 so the node can't be released
+        // while dependencies are still being registered
+        for (const auto& dependency : dependencies) {
+            if (!dependency) continue;
+
+            std::lock_guard<std::mutex> lock(dependency->mutex);
+            if (!dependency->isFinished) {
+                node->pendingDependencies.fetch_add(1, std::memory_order_relaxed);
+                dependency->dependents.push_back(node);
+            }
+        }
+
+        if (node->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            Enqueue(node);
+        }
+        return node;
+    }
+
+    void TaskScheduler::Wait(const TaskHandle& handle) {
+        if (!handle) return;
+
+        const size_t queueIndex = GetCurrentQueueIndex();
+        while (!handle->isDone.load(std::memory_order_acquire)) {
+            if (TryRunOne(queueIndex)) continue;
+
+            // Nothing to help with: sleep until the task finishes or more
+            // work is queued, rather than spinning a core on it
+            m_blockedWaiters.fetch_add(1);
+            {
+                std::unique_lock<std::mutex> lock(m_sleepMutex);
+                m_sleepCondition.wait(lock, [this, &handle]() {
+                    return handle->isDone.load()
+                        || m_queuedCount.load(std::memory_order_acquire) > 0;
+                });
+            }
+            m_blockedWaiters.fetch_sub(1);
+        }
+    }
+
+    void TaskScheduler::WaitAll(const std::vector<TaskHandle>& handles) {
+        for (const auto& handle : handles) {
+            Wait(handle);
+        }
+    }
+
+    void TaskScheduler::ParallelFor(
+        size_t count,
+        const std::function<void(size_t)>& body
+    ) {
+        if (count == 0) return;
+        if (count == 1 || m_workers.empty()) {
+            for (size_t i = 0; i < count; ++i) body(i);
+            return;
+        }
+
+        // Helpers reference this frame, so all of them are waited on below
+        std::atomic<size_t> nextIndex{ 0 };
+        auto runIndices = [&]() {
+            size_t index;
+            while ((index = nextIndex.fetch_add(1)) < count) {
+                body(index);
+            }
+        };
+
+        const size_t helperCount = std::min(m_workers.size(), count - 1);
+        std::vector<TaskHandle> helpers;
+        helpers.reserve(helperCount);
+        for (size_t i = 0; i < helperCount; ++i) {
+            helpers.push_back(Submit(runIndices));
+        }
+
+        runIndices();
+        WaitAll(helpers);
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Scheduling
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    void TaskScheduler::Enqueue(const TaskHandle& node) {
+        // Workers keep their own spawns local; outside threads spread
+        // submissions round-robin so idle workers find them without stealing
+        size_t queueIndex = GetCurrentQueueIndex();
+        if (queueIndex == m_workers.size() && !m_workers.empty()) {
+            queueIndex = m_nextInjection.fetch_add(1, std::memory_order_relaxed) % m_workers.size();
+        }
+
+        // Counted before the push so a fast thief can never underflow it
+        m_queuedCount.fetch_add(1, std::memory_order_release);
+        {
+            WorkerQueue& queue = *m_queues[queueIndex];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(node);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+        }
+        m_sleepCondition.notify_one();
+    }
+
+    void TaskScheduler::Execute(const TaskHandle& node) {
+        if (node->function) {
+            node->function();
+        }
+
+        std::vector<TaskHandle> dependents;
+        {
+            std::lock_guard<std::mutex> lock(node->mutex);
+            node->isFinished = true;
+            dependents.swap(node->dependents);
+        }
+        node->isDone.store(true);
+
+        // Ordered after the store above, so a waiter either sees the task
+        // done or is counted here before it sleeps
+        if (m_blockedWaiters.load() > 0) {
+            {
+                std::lock_guard<std::mutex> lock(m_sleepMutex);
+            }
+            m_sleepCondition.notify_all();
+        }
+
+        for (const auto& dependent : dependents) {
+            if (dependent->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                Enqueue(dependent);
+            }
+        }
+    }
+
+    bool TaskScheduler::TryRunOne(size_t preferredQueue) {
+        TaskHandle node = PopLocal(preferredQueue);
+        if (!node) {
+            node = Steal(preferredQueue);
+        }
+        if (!node) return false;
+
+        m_queuedCount.fetch_sub(1, std::memory_order_acq_rel);
+        Execute(node);
+        return true;
+    }
+
+    TaskScheduler::TaskHandle TaskScheduler::PopLocal(size_t queueIndex) {
+        WorkerQueue& queue = *m_queues[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) return nullptr;
+
+        // LIFO for the owner: the most recent task is the hottest in cache
+        TaskHandle node = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return node;
+    }
+
+    TaskScheduler::TaskHandle TaskScheduler::Steal(size_t thiefIndex) {
+        const size_t queueCount = m_queues.size();
+        for (size_t offset = 1; offset < queueCount; ++offset) {
+            WorkerQueue& queue = *m_queues[(thiefIndex + offset) % queueCount];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty()) continue;
+
+            // FIFO for thieves: take the oldest, likely largest, work
+            TaskHandle node = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            return node;
+        }
+        return nullptr;
+    }
+
+    size_t TaskScheduler::GetCurrentQueueIndex() const noexcept {
+        // Non-worker threads share the injection queue at the end
+        return (t_owner == this) ? t_queueIndex : m_workers.size();
+    }
+
+    void TaskScheduler::WorkerLoop(size_t workerIndex) {
+        t_owner = this;
+        t_queueIndex = workerIndex;
+
+        while (!m_stopping.load(std::memory_order_acquire)) {
+            if (TryRunOne(workerIndex)) continue;
+
+            std::unique_lock<std::mutex> lock(m_sleepMutex);
+            m_sleepCondition.wait(lock, [this]() {
+                return m_stopping.load(std::memory_order_acquire)
+                    || m_queuedCount.load(std::memory_order_acquire) > 0;
+            });
+        }
+    }
+
+}
@@ -0,0 +1,81 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// TaskScheduler.h: Work-stealing task pool for analyzer and renderer jobs.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#ifndef SPECTRUM_CPP_TASK_SCHEDULER_H
+#define SPECTRUM_CPP_TASK_SCHEDULER_H
+
+#include "Common.h"
+#include <condition_variable>
+#include <deque>
+
+namespace Spectrum {
+
+    class TaskScheduler {
+    public:
+        using Task = std::function<void()>;
+
+    private:
+        // A scheduled task plus the tasks waiting on it
+        struct TaskNode {
+            Task function;
+            std::atomic<int> pendingDependencies{ 1 };
+            std::atomic<bool> isDone{ false };
+            std::mutex mutex;
+            std::vector<std::shared_ptr<TaskNode>> dependents;
+            bool isFinished = false;
+        };
+
+        // Owner pushes/pops at the back, thieves take from the front
+        struct WorkerQueue {
+            std::deque<std::shared_ptr<TaskNode>> tasks;
+            std::mutex mutex;
+        };
+
+    public:
+        using TaskHandle = std::shared_ptr<TaskNode>;
+
+        // 0 picks hardware_concurrency - 1 (the caller thread also works)
+        explicit TaskScheduler(size_t workerCount = 0);
+        ~TaskScheduler();
+
+        TaskScheduler(const TaskScheduler&) = delete;
+        TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+        // Runs once every dependency has finished
+        TaskHandle Submit(Task task, const std::vector<TaskHandle>& dependencies = {});
+
+        // Blocks until the task is done, executing other work meanwhile and
+        // sleeping once there is none
+        void Wait(const TaskHandle& handle);
+        void WaitAll(const std::vector<TaskHandle>& handles);
+
+        // Runs body(0..count-1) across the pool and the calling thread
+        void ParallelFor(size_t count, const std::function<void(size_t)>& body);
+
+        size_t GetWorkerCount() const noexcept { return m_workers.size(); }
+
+    private:
+        void WorkerLoop(size_t workerIndex);
+        void Enqueue(const TaskHandle& node);
+        void Execute(const TaskHandle& node);
+        bool TryRunOne(size_t preferredQueue);
+        TaskHandle PopLocal(size_t queueIndex);
+        TaskHandle Steal(size_t thiefIndex);
+        size_t GetCurrentQueueIndex() const noexcept;
+
+        std::vector<std::thread> m_workers;
+        // One queue per worker plus a shared injection queue at the end
+        std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+
+        std::atomic<size_t> m_queuedCount{ 0 };
+        std::atomic<size_t> m_nextInjection{ 0 };
+        // Threads asleep in Wait(); finished tasks only wake them then
+        std::atomic<int> m_blockedWaiters{ 0 };
+        std::mutex m_sleepMutex;
+        std::condition_variable m_sleepCondition;
+        std::atomic<bool> m_stopping{ false };
+    };
+
+}
+
+#endif
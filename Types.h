@@ -82,11 +82,91 @@ namespace Spectrum {
         }
     };
 
+    struct GradientStop {
+        float position;
+        Color color;
+    };
+
+    // Row-vector 2D affine matrix with the same layout and composition order
+    // as D2D1_MATRIX_3X2_F: (a * b) applies a first, then b.
+    struct Transform2D {
+        float m11, m12, m21, m22, dx, dy;
+
+        static constexpr Transform2D Identity() noexcept {
+            return { 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f };
+        }
+
+        static constexpr Transform2D Translation(float x, float y) noexcept {
+            return { 1.0f, 0.0f, 0.0f, 1.0f, x, y };
+        }
+
+        static Transform2D Scale(
+            float sx, float sy, const Point& center = Point()
+        ) noexcept {
+            return {
+                sx, 0.0f, 0.0f, sy,
+                center.x - sx * center.x,
+                center.y - sy * center.y
+            };
+        }
+
+        static Transform2D Rotation(
+            float degrees, const Point& center = Point()
+        ) noexcept {
+            const float rad = degrees * DEG_TO_RAD;
+            const float c = std::cos(rad);
+            const float s = std::sin(rad);
+            return {
+                c, s, -s, c,
+                center.x - c * center.x + s * center.y,
+                center.y - s * center.x - c * center.y
+            };
+        }
+
+        Point TransformPoint(const Point& p) const noexcept {
+            return Point(
+                p.x * m11 + p.y * m21 + dx,
+                p.x * m12 + p.y * m22 + dy
+            );
+        }
+
+        Transform2D operator*(const Transform2D& o) const noexcept {
+            return {
+                m11 * o.m11 + m12 * o.m21,
+                m11 * o.m12 + m12 * o.m22,
+                m21 * o.m11 + m22 * o.m21,
+                m21 * o.m12 + m22 * o.m22,
+                dx * o.m11 + dy * o.m21 + o.dx,
+                dx * o.m12 + dy * o.m22 + o.dy
+            };
+        }
+    };
+
+    // Names something a backend may keep built between frames. A new
+    // revision means the source data changed and any retained copy is stale.
+    struct ResourceHandle {
+        uint32_t id = 0;
+        uint32_t revision = 0;
+    };
+
+    using GeometryHandle = ResourceHandle;
+    using LayerHandle = ResourceHandle;
+    using ImageHandle = ResourceHandle;
+
+    // One placement of a shared geometry. The transform is applied before
+    // the current one; the stroke width is in geometry space and is
+    // ignored for fills.
+    struct GeometryInstance {
+        Transform2D transform;
+        Color color;
+        float strokeWidth = 1.0f;
+    };
+
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
     // Enumerations
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
     enum class RenderStyle : uint8_t {
-        Bars = 0, Wave, CircularWave, Cubes, Fire, LedPanel, Gauge, KenwoodBars, Count
+        Bars = 0, Wave, CircularWave, Cubes, Fire, LedPanel, Gauge, KenwoodBars, Waterfall, Count
     };
 
     enum class RenderQuality : uint8_t {
@@ -101,6 +181,10 @@ namespace Spectrum {
         Linear = 0, Logarithmic, Mel, Count
     };
 
+    enum class TextAlignment : uint8_t {
+        Leading = 0, Center, Trailing
+    };
+
     enum class InputAction {
         ToggleCapture,
         ToggleAnimation,
@@ -114,6 +198,9 @@ namespace Spectrum {
         PrevFFTWindow,
         IncreaseBarCount,
         DecreaseBarCount,
+        CycleFrameRate,
+        ToggleQualityGovernor,
+        OpenView,
         Exit
     };
 
@@ -127,6 +214,8 @@ namespace Spectrum {
         float smoothing = DEFAULT_SMOOTHING;
         FFTWindowType windowType = FFTWindowType::Hann;
         SpectrumScale scaleType = SpectrumScale::Logarithmic;
+        bool resampleInput = false;
+        size_t internalSampleRate = DEFAULT_SAMPLE_RATE;
     };
 
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
@@ -21,7 +21,7 @@ namespace Spectrum {
                 return Color(v, v, v, 1.0f);
             }
 
-            h = std::fmodf(h, 1.0f);
+            h = std::fmod(h, 1.0f);
             if (h < 0.0f) {
                 h += 1.0f;
             }
@@ -99,6 +99,11 @@ namespace Spectrum {
                 static_cast<uint32_t>(b);
         }
 
+        uint32_t ColorToPremultipliedARGB(const Color& color) {
+            const float a = Saturate(color.a);
+            return ColorToARGB(Color(color.r * a, color.g * a, color.b * a, a));
+        }
+
         Color ARGBtoColor(uint32_t argb) {
             const float a = static_cast<float>((argb >> 24) & 0xFF) / 255.0f;
             const float r = static_cast<float>((argb >> 16) & 0xFF) / 255.0f;
@@ -134,56 +139,6 @@ namespace Spectrum {
             return out;
         }
 
-        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
-        // String utilities implementation
-        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
-
-        std::wstring StringToWString(const std::string& str) {
-            if (str.empty()) {
-                return std::wstring();
-            }
-
-            const int sizeW = MultiByteToWideChar(
-                CP_UTF8, 0, str.c_str(), -1, nullptr, 0
-            );
-            if (sizeW <= 0) {
-                return std::wstring();
-            }
-
-            std::wstring out(static_cast<size_t>(sizeW), L'\0');
-            MultiByteToWideChar(
-                CP_UTF8, 0, str.c_str(), -1, out.data(), sizeW
-            );
-
-            if (!out.empty() && out.back() == L'\0') {
-                out.pop_back();
-            }
-            return out;
-        }
-
-        std::string WStringToString(const std::wstring& wstr) {
-            if (wstr.empty()) {
-                return std::string();
-            }
-
-            const int sizeA = WideCharToMultiByte(
-                CP_UTF8, 0, wstr.c_str(), -1, nullptr, 0, nullptr, nullptr
-            );
-            if (sizeA <= 0) {
-                return std::string();
-            }
-
-            std::string out(static_cast<size_t>(sizeA), '\0');
-            WideCharToMultiByte(
-                CP_UTF8, 0, wstr.c_str(), -1, out.data(), sizeA, nullptr, nullptr
-            );
-
-            if (!out.empty() && out.back() == '\0') {
-                out.pop_back();
-            }
-            return out;
-        }
-
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
         // Timer implementation
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
@@ -209,8 +164,9 @@ namespace Spectrum {
         // Random implementation
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
 
+        // One generator per thread so pooled jobs never share engine state
         Random& Random::Instance() {
-            static Random inst;
+            static thread_local Random inst;
             return inst;
         }
 
@@ -44,6 +44,15 @@ namespace Spectrum {
             }
         }
 
+        inline std::string_view ToString(RenderQuality quality) {
+            switch (quality) {
+            case RenderQuality::Low: return "Low";
+            case RenderQuality::Medium: return "Medium";
+            case RenderQuality::High: return "High";
+            default: return "Unknown";
+            }
+        }
+
         inline std::string_view ToString(SpectrumScale type) {
             switch (type) {
             case SpectrumScale::Linear: return "Linear";
@@ -141,6 +150,8 @@ namespace Spectrum {
         HSV   RGBtoHSV(const Color& rgb);
 
         uint32_t ColorToARGB(const Color& color);
+        // Channels scaled by alpha, as D2D and the software target store them
+        uint32_t ColorToPremultipliedARGB(const Color& color);
         Color    ARGBtoColor(uint32_t argb);
 
         Color InterpolateColor(const Color& c1, const Color& c2, float t);
@@ -150,9 +161,6 @@ namespace Spectrum {
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
         // String utilities
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
-        std::wstring StringToWString(const std::string& str);
-        std::string  WStringToString(const std::wstring& wstr);
-
         template<typename... Args>
         [[nodiscard]] std::string Format(
             const std::string& fmt, Args... args
@@ -171,20 +179,6 @@ namespace Spectrum {
             );
         }
 
-        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
-        // Window utilities
-        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
-        [[nodiscard]] inline Point GetMousePosition(LPARAM lParam) noexcept {
-            return Point{
-                static_cast<float>(GET_X_LPARAM(lParam)),
-                static_cast<float>(GET_Y_LPARAM(lParam))
-            };
-        }
-
-        [[nodiscard]] inline bool IsKeyPressed(int vkCode) noexcept {
-            return (GetAsyncKeyState(vkCode) & 0x8000) != 0;
-        }
-
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
         // Time utilities
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
@@ -6,7 +6,7 @@
 #ifndef SPECTRUM_CPP_WASAPI_HELPER_H
 #define SPECTRUM_CPP_WASAPI_HELPER_H
 
-#include "Common.h"
+#include "Win32Common.h"
 
 namespace Spectrum {
     namespace WASAPI {
@@ -0,0 +1,193 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+// WaterfallRenderer.cpp: Implementation of the WaterfallRenderer class.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+#include "WaterfallRenderer.h"
+#include "SpectrumHistory.h"
+#include "Utils.h"
+
+namespace Spectrum {
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Constants
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    namespace {
+        // Bars quieter than this leave the background showing
+        constexpr float MIN_VISIBLE_INTENSITY = 0.02f;
+
+        // Fades in over the quiet end so low levels blend into the background
+        constexpr float FADE_IN_END = 0.3f;
+    }
+
+    WaterfallRenderer::WaterfallRenderer()
+        : m_columns(0),
+        m_rows(0),
+        m_head(0),
+        m_litRows(0),
+        m_readHistory(nullptr),
+        m_lastSequence(0) {
+        UpdateSettings();
+        CreatePaletteLut();
+    }
+
+    void WaterfallRenderer::UpdateSettings() {
+        switch (m_quality) {
+        case RenderQuality::Low:
+            m_settings = { 4 };
+            break;
+        case RenderQuality::Medium:
+            m_settings = { 3 };
+            break;
+        case RenderQuality::High:
+            m_settings = { 2 };
+            break;
+        default:
+            m_settings = { 3 };
+            break;
+        }
+    }
+
+    void WaterfallRenderer::CreatePaletteLut() {
+        static const Color STOPS[] = {
+            Color(0.05f, 0.0f, 0.2f, 1),
+            Color(0.35f, 0.0f, 0.5f, 1),
+            Color(0.8f, 0.1f, 0.3f, 1),
+            Color(1.0f, 0.5f, 0.0f, 1),
+            Color(1.0f, 0.9f, 0.3f, 1),
+            Color(1, 1, 1, 1)
+        };
+
+        m_paletteLut.Generate([](float intensity) {
+            if (intensity < MIN_VISIBLE_INTENSITY) return Color::Transparent();
+
+            const float scaled = intensity * (std::size(STOPS) - 1);
+            const size_t i1 = std::min(static_cast<size_t>(scaled), std::size(STOPS) - 2);
+            Color c = Utils::InterpolateColor(
+                STOPS[i1], STOPS[i1 + 1], scaled - static_cast<float>(i1)
+            );
+            c.a = Utils::SmoothStep(0.0f, FADE_IN_END, intensity);
+            return c;
+        });
+    }
+
+    // Rows only ever hold one width, so a new layout starts blank
+    void WaterfallRenderer::ResetImage(size_t columns, int rows) {
+        m_columns = columns;
+        m_rows = rows;
+        m_head = 0;
+        m_rowLit.assign(static_cast<size_t>(rows), 0);
+        m_litRows = 0;
+        m_image.Resize(static_cast<int>(columns), rows);
+
+        // Refill from whatever history is still retained
+        m_lastSequence = 0;
+    }
+
+    void WaterfallRenderer::UpdateAnimation(const SpectrumData& spectrum, float deltaTime) {
+        (void)deltaTime;
+
+        const int rows = std::max(1, m_height / m_settings.rowHeight);
+        if (spectrum.size() != m_columns || rows != m_rows) {
+            ResetImage(spectrum.size(), rows);
+        }
+
+        const SpectrumHistory* history = GetSpectrumHistory();
+        if (history != m_readHistory) {
+            m_readHistory = history;
+            m_lastSequence = 0;
+        }
+
+        if (!history) {
+            // No history: one row per frame
+            WriteRow(spectrum.data());
+            MarkRowsWritten(1);
+            return;
+        }
+
+        // Rows that would scroll off within this frame are never written
+        const auto reader = history->Read();
+        const uint64_t latest = reader.GetLatestSequence();
+        const uint64_t visible = static_cast<uint64_t>(m_rows);
+        const uint64_t after = std::max(m_lastSequence, latest > visible ? latest - visible : 0);
+        if (after >= latest) return;
+
+        int written = 0;
+        m_lastSequence = reader.ForEachSince(
+            after,
+            [this, &written](const SpectrumHistory::Frame& frame) {
+                if (frame.barCount != m_columns) return;
+                WriteRow(frame.bars);
+                ++written;
+            }
+        );
+        MarkRowsWritten(written);
+    }
+
+    // With a history rows arrive only with new hops, so a frozen image is
+    // settled however much of it is lit
+    bool WaterfallRenderer::IsSettled() const {
+        const SpectrumHistory* history = GetSpectrumHistory();
+        if (history) {
+            return history == m_readHistory
+                && history->GetLatestSequence() == m_lastSequence;
+        }
+        return m_litRows == 0;
+    }
+
+    void WaterfallRenderer::WriteRow(const float* bars) {
+        m_head = (m_head == 0 ? m_rows : m_head) - 1;
+
+        const uint32_t* lut = m_paletteLut.GetPixels();
+        uint32_t* row = m_image.GetPixels() + static_cast<size_t>(m_head) * m_columns;
+        uint32_t alpha = 0;
+        for (size_t i = 0; i < m_columns; ++i) {
+            row[i] = lut[PaletteLut::ToIndex(bars[i])];
+            alpha |= row[i] >> 24;
+        }
+
+        const uint8_t lit = alpha != 0;
+        m_litRows += lit - m_rowLit[m_head];
+        m_rowLit[m_head] = lit;
+    }
+
+    // The newest rows run from the head down, wrapping past the end of the
+    // texture, so a backend only has to upload those
+    void WaterfallRenderer::MarkRowsWritten(int count) {
+        if (count <= 0) return;
+        if (count >= m_rows) {
+            m_image.MarkDirty();
+            return;
+        }
+
+        const int tail = m_rows - m_head;
+        m_image.MarkRowsDirty(m_head, std::min(count, tail));
+        if (count > tail) m_image.MarkRowsDirty(0, count - tail);
+    }
+
+    // Rows from the head down to the end of the texture are the newest;
+    // the rows before the head continue below them
+    void WaterfallRenderer::DoRender(
+        RenderCommandList& commands,
+        const SpectrumData& /*spectrum*/
+    ) {
+        if (m_image.IsEmpty()) return;
+
+        const float width = static_cast<float>(m_width);
+        const float rowHeight = static_cast<float>(m_settings.rowHeight);
+        const float columns = static_cast<float>(m_columns);
+        const int newer = m_rows - m_head;
+
+        commands.DrawImage(
+            m_image,
+            Rect(0.0f, 0.0f, width, newer * rowHeight),
+            Rect(0.0f, static_cast<float>(m_head), columns, static_cast<float>(newer))
+        );
+        if (m_head == 0) return;
+
+        commands.DrawImage(
+            m_image,
+            Rect(0.0f, newer * rowHeight, width, m_head * rowHeight),
+            Rect(0.0f, 0.0f, columns, static_cast<float>(m_head))
+        );
+    }
+
+}
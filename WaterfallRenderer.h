@@ -0,0 +1,73 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+// WaterfallRenderer.h: Renders the spectrum history as a scrolling spectrogram.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+#ifndef SPECTRUM_CPP_WATERFALL_RENDERER_H
+#define SPECTRUM_CPP_WATERFALL_RENDERER_H
+
+#include "BaseRenderer.h"
+#include "PaletteLut.h"
+
+namespace Spectrum {
+
+    // One texture row per published spectrum, newest at the top. The
+    // texture is a ring: a new spectrum overwrites the oldest row through
+    // the palette table and moves the head, and drawing splits the image
+    // at the head into two blits. Nothing is scrolled in memory, so a
+    // frame costs the new rows whatever the history length.
+    class WaterfallRenderer final : public BaseRenderer {
+    public:
+        WaterfallRenderer();
+        ~WaterfallRenderer() override = default;
+
+        RenderStyle GetStyle() const override {
+            return RenderStyle::Waterfall;
+        }
+        std::string_view GetName() const override {
+            return "Waterfall";
+        }
+        bool SupportsPrimaryColor() const override {
+            return false;
+        }
+        bool IsSettled() const override;
+        void SetPrimaryColor(const Color& color) override {
+            (void)color;
+        }
+
+    protected:
+        void UpdateSettings() override;
+        void UpdateAnimation(const SpectrumData& spectrum,
+            float deltaTime) override;
+        void DoRender(RenderCommandList& commands,
+            const SpectrumData& spectrum) override;
+
+    private:
+        void CreatePaletteLut();
+        void ResetImage(size_t columns, int rows);
+        void WriteRow(const float* bars);
+        void MarkRowsWritten(int count);
+
+        struct Settings {
+            int rowHeight;
+        };
+
+        Settings m_settings;
+        size_t m_columns;
+        int m_rows;
+        int m_head;       // Row holding the newest spectrum
+
+        // Rows with any visible texel; without a history each frame adds a
+        // row, so only a blank image is settled
+        std::vector<uint8_t> m_rowLit;
+        int m_litRows;
+
+        const SpectrumHistory* m_readHistory;
+        uint64_t m_lastSequence;
+
+        PaletteLut m_paletteLut;
+        RetainedImage m_image;
+    };
+
+} // namespace Spectrum
+
+#endif // SPECTRUM_CPP_WATERFALL_RENDERER_H
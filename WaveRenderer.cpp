@@ -30,7 +30,7 @@ namespace Spectrum {
     }
 
     void WaveRenderer::DoRender(
-        GraphicsContext& context,
+        RenderCommandList& commands,
         const SpectrumData& spectrum
     ) {
         RenderUtils::BuildPolylineFromSpectrum(
@@ -40,18 +40,22 @@ namespace Spectrum {
             m_width,
             m_points
         );
-        context.DrawPolyline(m_points, m_primaryColor, m_settings.lineWidth);
-
-        if (!m_settings.useReflection) return;
-
-        std::vector<Point> refl = m_points;
-        for (auto& p : refl) {
-            p.y = static_cast<float>(m_height) - p.y;
+        m_wave.SetPoints(m_points, false);
+
+        GeometryInstance instances[2];
+        instances[0] = { Transform2D::Identity(), m_primaryColor, m_settings.lineWidth };
+        size_t instanceCount = 1;
+
+        if (m_settings.useReflection) {
+            Color rc = m_primaryColor;
+            rc.a *= m_settings.reflectionStrength;
+            const Transform2D mirror = Transform2D::Scale(
+                1.0f, -1.0f, { 0.0f, m_height * 0.5f }
+            );
+            instances[instanceCount++] = { mirror, rc, m_settings.lineWidth * 0.8f };
         }
 
-        Color rc = m_primaryColor;
-        rc.a *= m_settings.reflectionStrength;
-        context.DrawPolyline(refl, rc, m_settings.lineWidth * 0.8f);
+        commands.DrawGeometryInstances(m_wave, instances, instanceCount, false);
     }
 
 }
\ No newline at end of file
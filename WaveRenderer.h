@@ -16,10 +16,11 @@ namespace Spectrum {
 
         RenderStyle GetStyle() const override { return RenderStyle::Wave; }
         std::string_view GetName() const override { return "Wave"; }
+        bool IsSettled() const override { return true; }
 
     protected:
         void UpdateSettings() override;
-        void DoRender(GraphicsContext& context,
+        void DoRender(RenderCommandList& commands,
             const SpectrumData& spectrum) override;
 
     private:
@@ -31,6 +32,9 @@ namespace Spectrum {
 
         Settings m_settings;
         std::vector<Point> m_points;
+
+        // Drawn as is and mirrored about the horizontal centre line
+        RetainedGeometry m_wave;
     };
 
 } // namespace Spectrum
@@ -0,0 +1,39 @@
+// Win32Common.h
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// Win32Common.h: Common.h plus the Windows, Direct2D, DirectWrite and WASAPI
+// headers. Only the window, graphics and capture modules include it.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#ifndef SPECTRUM_CPP_WIN32_COMMON_H
+#define SPECTRUM_CPP_WIN32_COMMON_H
+
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+// Windows headers
+#include <windows.h>
+#include <windowsx.h>
+#include <d2d1_3.h>
+#include <dwrite_3.h>
+#include <wrl/client.h>
+#include <dwmapi.h>
+#include <mmdeviceapi.h>
+#include <audioclient.h>
+#include <functiondiscoverykeys_devpkey.h>
+
+// Link required libraries
+#pragma comment(lib, "d2d1.lib")
+#pragma comment(lib, "dwrite.lib")
+#pragma comment(lib, "ole32.lib")
+#pragma comment(lib, "uuid.lib")
+#pragma comment(lib, "dwmapi.lib")
+
+#include "Common.h"
+
+namespace wrl = Microsoft::WRL;
+
+#endif // SPECTRUM_CPP_WIN32_COMMON_H
@@ -5,7 +5,7 @@
 #ifndef SPECTRUM_CPP_WINDOW_HELPER_H
 #define SPECTRUM_CPP_WINDOW_HELPER_H
 
-#include "Common.h"
+#include "Win32Common.h"
 
 namespace Spectrum {
     namespace WindowUtils {
@@ -56,6 +56,21 @@ namespace Spectrum {
 
         void CenterOnScreen(HWND hwnd);
 
+        [[nodiscard]] inline Point GetMousePosition(LPARAM lParam) noexcept {
+            return Point{
+                static_cast<float>(GET_X_LPARAM(lParam)),
+                static_cast<float>(GET_Y_LPARAM(lParam))
+            };
+        }
+
+        [[nodiscard]] inline bool IsKeyPressed(int vkCode) noexcept {
+            return (GetAsyncKeyState(vkCode) & 0x8000) != 0;
+        }
+
+        // UTF-8 <-> UTF-16 through the Win32 code page functions
+        std::wstring StringToWString(const std::string& str);
+        std::string  WStringToString(const std::wstring& wstr);
+
     } // namespace WindowUtils
 } // namespace Spectrum
 
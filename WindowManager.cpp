@@ -9,6 +9,8 @@
 #include "GraphicsContext.h"
 #include "UIManager.h"
 #include "RendererManager.h"
+#include "RenderView.h"
+#include "AudioManager.h"
 
 namespace Spectrum {
 
@@ -18,7 +20,8 @@ namespace Spectrum {
         EventBus* bus
     ) : m_hInstance(hInstance),
         m_controller(controller),
-        m_isOverlay(false)
+        m_isOverlay(false),
+        m_isViewTransition(false)
     {
         m_uiManager = std::make_unique<UIManager>(m_controller);
 
@@ -26,6 +29,10 @@ namespace Spectrum {
             this->ToggleOverlay();
             });
 
+        bus->Subscribe(InputAction::OpenView, [this]() {
+            this->OpenView();
+            });
+
         bus->Subscribe(InputAction::Exit, [this]() {
             // In overlay mode ESC reverts to main window
             if (this->IsOverlayMode()) {
@@ -38,7 +45,12 @@ namespace Spectrum {
             });
     }
 
-    WindowManager::~WindowManager() = default;
+    // Views go first so their windows never reach a half-destroyed manager
+    WindowManager::~WindowManager() {
+        auto views = std::move(m_views);
+        m_isViewTransition = true;
+        views.clear();
+    }
 
     bool WindowManager::Initialize() {
         if (!InitializeMainWindow()) return false;
@@ -77,6 +89,7 @@ namespace Spectrum {
         if (m_mainWnd && m_mainWnd->IsRunning()) {
             m_mainWnd->ProcessMessages();
         }
+        RemoveClosedViews();
     }
 
     bool WindowManager::IsRunning() const {
@@ -172,4 +185,90 @@ namespace Spectrum {
 
         RecreateGraphicsAndNotify(newHwnd);
     }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Extra View Windows
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    void WindowManager::OpenView() {
+        auto* rendererManager = m_controller ? m_controller->GetRendererManager() : nullptr;
+        if (!rendererManager) return;
+
+        // Each new view continues from the newest one
+        const RenderStyle base = m_views.empty()
+            ? rendererManager->GetCurrentStyle()
+            : m_views.back()->GetStyle();
+        const RenderStyle style = Utils::CycleEnum(base, 1);
+
+        auto view = std::make_unique<RenderView>(
+            m_hInstance, rendererManager->CreateRenderer(style)
+        );
+
+        m_isViewTransition = true;
+        const bool created = view->Initialize(640, 360, this);
+        if (!created) view.reset();
+        m_isViewTransition = false;
+
+        if (!created) {
+            LOG_ERROR("Failed to open a view window");
+            return;
+        }
+
+        view->SetQuality(rendererManager->GetEffectiveQuality());
+
+        // Styles that read best at their own bar count get their own bars
+        // from the same FFT instead of the main window's
+        const size_t barCount = view->GetPreferredBarCount();
+        auto* audioManager = m_controller->GetAudioManager();
+        if (barCount > 0 && audioManager) {
+            view->SetSpectrumView(audioManager->AddSpectrumView(barCount));
+        }
+
+        LOG_INFO("Opened a view with " << view->GetName().data() << " renderer");
+        m_views.push_back(std::move(view));
+    }
+
+    void WindowManager::CloseView(HWND hwnd) {
+        if (auto* view = FindView(hwnd)) {
+            view->Close();
+        }
+    }
+
+    // Runs between frames, so no view is being drawn. Closed views leave
+    // the list before their windows are destroyed.
+    void WindowManager::RemoveClosedViews() {
+        const auto closed = std::stable_partition(m_views.begin(), m_views.end(),
+            [](const std::unique_ptr<RenderView>& view) { return !view->IsClosed(); });
+        if (closed == m_views.end()) return;
+
+        std::vector<std::unique_ptr<RenderView>> removed(
+            std::make_move_iterator(closed), std::make_move_iterator(m_views.end())
+        );
+        m_views.erase(closed, m_views.end());
+
+        if (auto* audioManager = m_controller ? m_controller->GetAudioManager() : nullptr) {
+            for (const auto& view : removed) {
+                audioManager->RemoveSpectrumView(view->GetSpectrumView());
+            }
+        }
+
+        m_isViewTransition = true;
+        removed.clear();
+        m_isViewTransition = false;
+    }
+
+    RenderView* WindowManager::FindView(HWND hwnd) const {
+        for (const auto& view : m_views) {
+            if (view && view->GetHwnd() == hwnd) return view.get();
+        }
+        return nullptr;
+    }
+
+    bool WindowManager::IsViewWindow(HWND hwnd) const {
+        if (FindView(hwnd)) return true;
+
+        // Messages sent while a view's window is created or destroyed
+        return m_isViewTransition
+            && hwnd != (m_mainWnd ? m_mainWnd->GetHwnd() : nullptr)
+            && hwnd != (m_overlayWnd ? m_overlayWnd->GetHwnd() : nullptr);
+    }
 }
\ No newline at end of file
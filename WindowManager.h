@@ -5,7 +5,7 @@
 #ifndef SPECTRUM_CPP_WINDOW_MANAGER_H
 #define SPECTRUM_CPP_WINDOW_MANAGER_H
 
-#include "Common.h"
+#include "Win32Common.h"
 #include "MainWindow.h"
 
 namespace Spectrum {
@@ -14,6 +14,7 @@ namespace Spectrum {
     class EventBus;
     class GraphicsContext;
     class UIManager;
+    class RenderView;
 
     class WindowManager {
     public:
@@ -26,6 +27,19 @@ namespace Spectrum {
         // Handles switching between main window and overlay
         void ToggleOverlay();
 
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Extra View Windows
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Opens a window drawing the same spectrum with the next style
+        void OpenView();
+        // Hides the view now; it is destroyed on the next message pump
+        void CloseView(HWND hwnd);
+
+        RenderView* FindView(HWND hwnd) const;
+        const std::vector<std::unique_ptr<RenderView>>& GetViews() const { return m_views; }
+        // Also true while a view window is being created or destroyed
+        bool IsViewWindow(HWND hwnd) const;
+
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
         // State & Getters
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
@@ -54,6 +68,7 @@ namespace Spectrum {
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
         void ActivateOverlayMode();
         void DeactivateOverlayMode();
+        void RemoveClosedViews();
 
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
         // Member State
@@ -67,6 +82,10 @@ namespace Spectrum {
 
         std::unique_ptr<GraphicsContext> m_graphics;
         std::unique_ptr<UIManager> m_uiManager;
+
+        // Destroyed before the main window, which owns the window class
+        std::vector<std::unique_ptr<RenderView>> m_views;
+        bool m_isViewTransition;
     };
 
 }
@@ -0,0 +1,134 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// AdaptiveWakeSchedulerTest.cpp: The polling capture loop run against a
+// simulated device clock, measuring how long packets wait to be read.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#include "TestHarness.h"
+#include "AdaptiveWakeScheduler.h"
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+using namespace Spectrum;
+using Internal::AdaptiveWakeScheduler;
+
+namespace {
+    using Micros = AdaptiveWakeScheduler::Duration;
+
+    constexpr uint32_t SAMPLE_RATE = 48000;
+    constexpr uint32_t PACKET_FRAMES = 480;
+    constexpr Micros DEVICE_PERIOD = Micros(10000);
+    constexpr size_t PACKET_COUNT = 5000;
+
+    // Packet latency in 0.5 ms buckets; the last bucket collects the rest
+    constexpr size_t HISTOGRAM_BUCKETS = 40;
+    constexpr int64_t HISTOGRAM_BUCKET_US = 500;
+
+    struct SimulationResult {
+        std::array<uint32_t, HISTOGRAM_BUCKETS> histogram{};
+        size_t packets = 0;
+        size_t wakes = 0;
+
+        // Upper edge of the bucket holding the given fraction of packets
+        float PercentileMs(float fraction) const {
+            const size_t target = static_cast<size_t>(fraction * packets + 0.999f);
+            size_t seen = 0;
+            for (size_t i = 0; i < HISTOGRAM_BUCKETS; ++i) {
+                seen += histogram[i];
+                if (seen >= target) return (i + 1) * HISTOGRAM_BUCKET_US / 1000.0f;
+            }
+            return HISTOGRAM_BUCKETS * HISTOGRAM_BUCKET_US / 1000.0f;
+        }
+
+        void Print(const char* name) const {
+            std::printf("  %-22s p50 %5.1f ms  p99 %5.1f ms  %.2f wakes/packet\n",
+                name, PercentileMs(0.5f), PercentileMs(0.99f),
+                static_cast<double>(wakes) / static_cast<double>(packets));
+        }
+    };
+
+    // The device delivers a packet every period, give or take arrivalJitter;
+    // each sleep overshoots by up to timerSlop, as a real timer does
+    SimulationResult Simulate(Micros arrivalJitter, Micros timerSlop) {
+        std::mt19937 random(1234);
+        std::uniform_int_distribution<int64_t> jitter(-arrivalJitter.count(), arrivalJitter.count());
+        std::uniform_int_distribution<int64_t> slop(0, timerSlop.count());
+
+        std::vector<int64_t> arrivals(PACKET_COUNT);
+        for (size_t i = 0; i < PACKET_COUNT; ++i) {
+            arrivals[i] = static_cast<int64_t>(i + 1) * DEVICE_PERIOD.count() + jitter(random);
+        }
+
+        AdaptiveWakeScheduler scheduler(DEVICE_PERIOD, SAMPLE_RATE);
+        SimulationResult result;
+        int64_t now = 0;
+        size_t next = 0;
+        uint32_t lastPacketFrames = 0;
+
+        while (next < PACKET_COUNT) {
+            uint32_t frames = 0;
+            while (next < PACKET_COUNT && arrivals[next] <= now) {
+                const int64_t latency = now - arrivals[next];
+                const size_t bucket = std::min<size_t>(
+                    static_cast<size_t>(latency / HISTOGRAM_BUCKET_US), HISTOGRAM_BUCKETS - 1
+                );
+                ++result.histogram[bucket];
+                ++result.packets;
+                frames += PACKET_FRAMES;
+                lastPacketFrames = PACKET_FRAMES;
+                ++next;
+            }
+
+            ++result.wakes;
+            scheduler.OnWake(frames, lastPacketFrames);
+            now += scheduler.GetNextSleep().count() + slop(random);
+        }
+        return result;
+    }
+
+    // A steady device and a high-resolution timer: packets are picked up
+    // within a couple of milliseconds, at about two wakes per packet
+    void TestSteadyStreamLatency() {
+        const SimulationResult result = Simulate(Micros(0), Micros(500));
+        result.Print("steady, 0.5 ms slop");
+        CHECK(result.packets == PACKET_COUNT);
+        CHECK(result.PercentileMs(0.99f) <= 2.5f);
+        CHECK(result.wakes < PACKET_COUNT * 3);
+    }
+
+    // Arrival jitter of a millisecond either way must not push packets into
+    // the idle back-off
+    void TestJitteryStreamLatency() {
+        const SimulationResult result = Simulate(Micros(1000), Micros(500));
+        result.Print("1 ms jitter, 0.5 ms slop");
+        CHECK(result.packets == PACKET_COUNT);
+        CHECK(result.PercentileMs(0.5f) <= 2.0f);
+        CHECK(result.PercentileMs(0.99f) <= 2.5f);
+        CHECK(result.wakes < PACKET_COUNT * 4);
+    }
+
+    // A silent stream backs off to the idle cap instead of polling at 1 kHz
+    void TestIdleStreamBacksOff() {
+        AdaptiveWakeScheduler scheduler(DEVICE_PERIOD, SAMPLE_RATE);
+        scheduler.OnWake(PACKET_FRAMES, PACKET_FRAMES);
+        CHECK(scheduler.GetNextSleep() < DEVICE_PERIOD);
+
+        Micros previous = Micros(0);
+        for (int wake = 0; wake < 20; ++wake) {
+            scheduler.OnWake(0, PACKET_FRAMES);
+            CHECK(wake == 0 || scheduler.GetNextSleep() >= previous);
+            previous = scheduler.GetNextSleep();
+        }
+        CHECK(scheduler.GetNextSleep() == Micros(100000));
+
+        scheduler.OnWake(PACKET_FRAMES, PACKET_FRAMES);
+        CHECK(scheduler.GetNextSleep() < DEVICE_PERIOD);
+    }
+}
+
+int main() {
+    Test::Run("steady stream is read promptly", TestSteadyStreamLatency);
+    Test::Run("jittery stream is read promptly", TestJitteryStreamLatency);
+    Test::Run("idle stream backs off", TestIdleStreamBacksOff);
+    return Test::Finish();
+}
@@ -0,0 +1,64 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// AllocationCounter.cpp: Global operator new/delete replacements that count.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#include "AllocationCounter.h"
+#include <cstdlib>
+#include <new>
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
+
+namespace {
+    thread_local size_t t_allocationCount = 0;
+
+    void* CountedAllocate(size_t size) {
+        ++t_allocationCount;
+        if (void* memory = std::malloc(size == 0 ? 1 : size)) return memory;
+        throw std::bad_alloc();
+    }
+
+    void* CountedAllocateAligned(size_t size, std::align_val_t alignment) {
+        ++t_allocationCount;
+        const size_t align = static_cast<size_t>(alignment);
+        const size_t rounded = (size + align - 1) / align * align;
+#ifdef _MSC_VER
+        void* memory = _aligned_malloc(rounded == 0 ? align : rounded, align);
+#else
+        void* memory = std::aligned_alloc(align, rounded == 0 ? align : rounded);
+#endif
+        if (memory) return memory;
+        throw std::bad_alloc();
+    }
+
+    void FreeAligned(void* memory) noexcept {
+#ifdef _MSC_VER
+        _aligned_free(memory);
+#else
+        std::free(memory);
+#endif
+    }
+}
+
+namespace Spectrum {
+    namespace Test {
+        size_t GetThreadAllocationCount() noexcept { return t_allocationCount; }
+    }
+}
+
+void* operator new(size_t size) { return CountedAllocate(size); }
+void* operator new[](size_t size) { return CountedAllocate(size); }
+void* operator new(size_t size, std::align_val_t alignment) {
+    return CountedAllocateAligned(size, alignment);
+}
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return CountedAllocateAligned(size, alignment);
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { FreeAligned(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { FreeAligned(memory); }
+void operator delete(void* memory, size_t, std::align_val_t) noexcept { FreeAligned(memory); }
+void operator delete[](void* memory, size_t, std::align_val_t) noexcept { FreeAligned(memory); }
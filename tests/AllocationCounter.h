@@ -0,0 +1,29 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// AllocationCounter.h: Counts heap allocations per thread by replacing the
+// global operator new. Link AllocationCounter.cpp into a test to enable it.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#ifndef SPECTRUM_CPP_ALLOCATION_COUNTER_H
+#define SPECTRUM_CPP_ALLOCATION_COUNTER_H
+
+#include <cstddef>
+
+namespace Spectrum {
+    namespace Test {
+
+        // operator new calls made by the calling thread since it started
+        size_t GetThreadAllocationCount() noexcept;
+
+        // Allocations the calling thread makes while it is alive
+        class AllocationScope {
+        public:
+            AllocationScope() noexcept : m_start(GetThreadAllocationCount()) {}
+            size_t GetCount() const noexcept { return GetThreadAllocationCount() - m_start; }
+
+        private:
+            size_t m_start;
+        };
+
+    }
+}
+
+#endif
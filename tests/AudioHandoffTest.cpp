@@ -0,0 +1,152 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// AudioHandoffTest.cpp: The sample ring and the capture-side handoff into
+// the analyzer, including the no-allocation promise of the capture thread,
+// and the extra views that share the analyzer's FFT.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#include "TestHarness.h"
+#include "AllocationCounter.h"
+#include "AudioRingBuffer.h"
+#include "SpectrumAnalyzer.h"
+#include "SpectrumView.h"
+
+using namespace Spectrum;
+
+namespace {
+    // 10 ms WASAPI packets of 48 kHz stereo
+    constexpr size_t PACKET_FRAMES = 480;
+    constexpr int CHANNELS = 2;
+    constexpr size_t PACKET_COUNT = 2000;
+
+    void FillTone(std::vector<float>& packet, size_t firstFrame, float frequency, float sampleRate) {
+        for (size_t frame = 0; frame < packet.size() / CHANNELS; ++frame) {
+            const float phase = TWO_PI * frequency * static_cast<float>(firstFrame + frame) / sampleRate;
+            const float sample = 0.5f * std::sin(phase);
+            for (int channel = 0; channel < CHANNELS; ++channel) {
+                packet[frame * CHANNELS + channel] = sample;
+            }
+        }
+    }
+
+    void TestRingWrapsInOrder() {
+        AudioRingBuffer ring(64);
+        CHECK(ring.GetCapacity() == 64);
+
+        std::vector<float> in(48), out(48);
+        float next = 0.0f;
+        for (int round = 0; round < 10; ++round) {
+            for (float& sample : in) sample = next++;
+            CHECK(ring.Write(in.data(), in.size()) == in.size());
+            CHECK(ring.Read(out.data(), out.size()) == out.size());
+            CHECK(out == in);
+        }
+        CHECK(ring.GetAvailable() == 0);
+    }
+
+    void TestRingDropsWholePackets() {
+        AudioRingBuffer ring(64);
+        std::vector<float> packet(40, 1.0f);
+
+        CHECK(ring.Write(packet.data(), packet.size()) == 40);
+        CHECK(ring.Write(packet.data(), packet.size()) == 0);
+        CHECK(ring.GetAvailable() == 40);
+        CHECK(ring.GetOverrunCount() == 1);
+
+        CHECK(ring.Skip(40) == 40);
+        CHECK(ring.Write(packet.data(), packet.size()) == 40);
+        ring.Clear();
+        CHECK(ring.GetAvailable() == 0);
+    }
+
+    // The capture thread feeds packets while this thread analyzes them,
+    // as RealtimeAudioSource runs it; the producer must never allocate
+    void TestCaptureThreadDoesNotAllocate() {
+        SpectrumAnalyzer analyzer;
+        analyzer.SetSampleRate(48000);
+
+        std::vector<float> packet(PACKET_FRAMES * CHANNELS);
+        FillTone(packet, 0, 1000.0f, 48000.0f);
+
+        std::atomic<size_t> packetsWritten{ 0 };
+        std::atomic<size_t> wakeups{ 0 };
+        analyzer.SetDataListener([&wakeups]() { wakeups.fetch_add(1, std::memory_order_relaxed); });
+
+        size_t captureAllocations = 0;
+        std::thread capture([&]() {
+            Test::AllocationScope scope;
+            for (size_t i = 0; i < PACKET_COUNT; ++i) {
+                analyzer.OnAudioData(packet.data(), packet.size(), CHANNELS);
+                packetsWritten.store(i + 1, std::memory_order_release);
+                std::this_thread::yield();
+            }
+            captureAllocations = scope.GetCount();
+        });
+
+        while (packetsWritten.load(std::memory_order_acquire) < PACKET_COUNT) {
+            analyzer.Update();
+            std::this_thread::yield();
+        }
+        capture.join();
+        analyzer.Update();
+
+        CHECK(captureAllocations == 0);
+        CHECK(wakeups.load() == PACKET_COUNT);
+        CHECK(analyzer.GetSpectrumVersion() > 0);
+
+        const SpectrumData bars = analyzer.GetSpectrum();
+        CHECK(*std::max_element(bars.begin(), bars.end()) > 0.0f);
+    }
+
+    // After warming up, draining and analyzing a hop allocates nothing either
+    void TestSteadyStateAnalysisDoesNotAllocate() {
+        SpectrumAnalyzer analyzer;
+        analyzer.SetSampleRate(48000);
+
+        std::vector<float> packet(PACKET_FRAMES * CHANNELS);
+        for (size_t i = 0; i < 64; ++i) {
+            FillTone(packet, i * PACKET_FRAMES, 440.0f, 48000.0f);
+            analyzer.OnAudioData(packet.data(), packet.size(), CHANNELS);
+            analyzer.Update();
+        }
+
+        Test::AllocationScope scope;
+        for (size_t i = 64; i < 256; ++i) {
+            FillTone(packet, i * PACKET_FRAMES, 440.0f, 48000.0f);
+            analyzer.OnAudioData(packet.data(), packet.size(), CHANNELS);
+            analyzer.Update();
+        }
+        CHECK(scope.GetCount() == 0);
+    }
+
+    // A view keeps its bar count but follows every other analyzer setting,
+    // whether it changed before or after the view was added
+    void TestViewsFollowAnalyzerSettings() {
+        SpectrumAnalyzer analyzer;
+        analyzer.SetSampleRate(48000);
+        analyzer.SetAmplification(2.0f);
+
+        SpectrumView* view = analyzer.AddView(32, SpectrumScale::Linear);
+        CHECK(view != nullptr);
+        CHECK(view->GetAmplification() == 2.0f);
+        CHECK(view->GetSmoothing() == analyzer.GetSmoothing());
+
+        analyzer.SetAmplification(3.5f);
+        analyzer.SetSmoothing(0.25f);
+        analyzer.SetScaleType(SpectrumScale::Mel);
+        CHECK(view->GetAmplification() == 3.5f);
+        CHECK(view->GetSmoothing() == 0.25f);
+        CHECK(view->GetScaleType() == SpectrumScale::Mel);
+
+        analyzer.SetBarCount(96);
+        CHECK(view->GetBarCount() == 32);
+        analyzer.RemoveView(view);
+    }
+}
+
+int main() {
+    Test::Run("ring keeps samples in order across the wrap", TestRingWrapsInOrder);
+    Test::Run("ring drops a packet that does not fit whole", TestRingDropsWholePackets);
+    Test::Run("capture thread makes no heap allocation", TestCaptureThreadDoesNotAllocate);
+    Test::Run("steady analysis makes no heap allocation", TestSteadyStateAnalysisDoesNotAllocate);
+    Test::Run("views follow analyzer settings", TestViewsFollowAnalyzerSettings);
+    return Test::Finish();
+}
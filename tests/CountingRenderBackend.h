@@ -0,0 +1,147 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// CountingRenderBackend.h: Backend that draws nothing and counts what a
+// frame would cost a retained-mode GPU backend.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#ifndef SPECTRUM_CPP_COUNTING_RENDER_BACKEND_H
+#define SPECTRUM_CPP_COUNTING_RENDER_BACKEND_H
+
+#include "IRenderBackend.h"
+#include "RenderCommandList.h"
+
+namespace Spectrum {
+    namespace Test {
+
+        // Handles are cached like GraphicsContext does: geometry is built and
+        // images uploaded only when the handle is new or its revision moved,
+        // and a layer replays its content only then. An image upload covers
+        // only its dirty rows when the image can say which they are. Nothing
+        // allocates once every handle has been seen.
+        class CountingRenderBackend final : public IRenderBackend {
+        public:
+            struct Counters {
+                size_t drawCalls = 0;
+                size_t shapes = 0;
+                size_t geometryBuilds = 0;
+                size_t imageUploads = 0;
+                size_t imageRowsUploaded = 0;
+                size_t layerRecords = 0;
+            };
+
+            void ResetCounters() noexcept { m_counters = Counters(); }
+            const Counters& GetCounters() const noexcept { return m_counters; }
+
+            void DrawRectangle(const Rect&, const Color&, bool, float) override { AddDraw(); }
+            void DrawRoundedRectangle(const Rect&, float, const Color&, bool, float) override {
+                AddDraw();
+            }
+            void DrawEllipse(const Point&, float, float, const Color&, bool, float) override {
+                AddDraw();
+            }
+            void DrawLine(const Point&, const Point&, const Color&, float) override { AddDraw(); }
+
+            // Transient paths are built on every call
+            void DrawPolyline(const Point*, size_t, const Color&, float) override {
+                AddDraw();
+                ++m_counters.geometryBuilds;
+            }
+            void DrawPolygon(const Point*, size_t, const Color&, bool, float) override {
+                AddDraw();
+                ++m_counters.geometryBuilds;
+            }
+
+            void DrawGeometry(
+                GeometryHandle handle, const Point*, size_t, bool, const Color&, bool, float
+            ) override {
+                AddDraw();
+                if (IsStale(m_geometryRevisions, handle)) ++m_counters.geometryBuilds;
+            }
+            void DrawGeometryInstances(
+                GeometryHandle handle,
+                const Point*,
+                size_t,
+                bool,
+                const GeometryInstance*,
+                size_t instanceCount,
+                bool
+            ) override {
+                m_counters.drawCalls += instanceCount;
+                m_counters.shapes += instanceCount;
+                if (instanceCount > 0 && IsStale(m_geometryRevisions, handle)) {
+                    ++m_counters.geometryBuilds;
+                }
+            }
+
+            void FillRectangles(const Rect*, size_t count, const Color&) override {
+                ++m_counters.drawCalls;
+                m_counters.shapes += count;
+            }
+            void FillEllipses(const Rect*, size_t count, const Color&) override {
+                ++m_counters.drawCalls;
+                m_counters.shapes += count;
+            }
+
+            void DrawGradientRectangle(const Rect&, const GradientStop*, size_t, bool) override {
+                AddDraw();
+            }
+            void DrawRadialGradient(const Point&, float, const GradientStop*, size_t) override {
+                AddDraw();
+            }
+
+            void DrawImage(const RetainedImage& image, const Rect&, const Rect&) override {
+                AddDraw();
+                const ImageHandle handle = image.GetHandle();
+                auto [it, inserted] = m_imageRevisions.try_emplace(handle.id, handle.revision);
+                if (!inserted && it->second == handle.revision) return;
+
+                int first = 0;
+                int count = image.GetHeight();
+                if (!inserted) image.GetRowsDirtySince(it->second, first, count);
+                it->second = handle.revision;
+
+                ++m_counters.imageUploads;
+                m_counters.imageRowsUploaded += static_cast<size_t>(count);
+            }
+
+            void DrawLayer(LayerHandle handle, const RenderCommandList& content) override {
+                if (IsStale(m_layerRevisions, handle)) {
+                    ++m_counters.layerRecords;
+                    content.Execute(*this);
+                }
+                AddDraw();
+            }
+
+            void DrawText(
+                std::wstring_view, const Point&, const Color&, float, TextAlignment
+            ) override {
+                AddDraw();
+            }
+
+            void SetTransform(const Transform2D&) override {}
+            void ResetTransform() override {}
+
+        private:
+            using RevisionMap = std::unordered_map<uint32_t, uint32_t>;
+
+            void AddDraw() noexcept {
+                ++m_counters.drawCalls;
+                ++m_counters.shapes;
+            }
+
+            static bool IsStale(RevisionMap& revisions, ResourceHandle handle) {
+                auto [it, inserted] = revisions.try_emplace(handle.id, handle.revision);
+                if (inserted) return true;
+                if (it->second == handle.revision) return false;
+                it->second = handle.revision;
+                return true;
+            }
+
+            Counters m_counters;
+            RevisionMap m_geometryRevisions;
+            RevisionMap m_imageRevisions;
+            RevisionMap m_layerRevisions;
+        };
+
+    }
+}
+
+#endif
@@ -0,0 +1,98 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// FrameArenaTest.cpp: The per-frame bump allocator, and steady frames that
+// leave the heap alone once renderers draw from it.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#include "TestHarness.h"
+#include "AllocationCounter.h"
+#include "CountingRenderBackend.h"
+#include "FrameArena.h"
+#include "CircularWaveRenderer.h"
+
+using namespace Spectrum;
+
+namespace {
+    void TestAllocationsAreAligned() {
+        FrameArena arena(1024);
+        for (size_t alignment : { 1, 4, 8, 16, 64 }) {
+            void* p = arena.Allocate(3, alignment);
+            CHECK(p != nullptr);
+            CHECK(reinterpret_cast<uintptr_t>(p) % alignment == 0);
+        }
+    }
+
+    // An overflowing frame grows once; the same frame then fits in one block
+    void TestOverflowSettlesIntoOneBlock() {
+        FrameArena arena(256);
+        auto runFrame = [&arena]() {
+            arena.Reset();
+            for (int i = 0; i < 16; ++i) arena.AllocateArray<float>(32);
+        };
+
+        runFrame();
+        runFrame();
+        const size_t settledBlocks = arena.GetBlockAllocationCount();
+        CHECK(arena.GetCapacity() >= 16 * 32 * sizeof(float));
+
+        Test::AllocationScope scope;
+        for (int frame = 0; frame < 100; ++frame) runFrame();
+        CHECK(scope.GetCount() == 0);
+        CHECK(arena.GetBlockAllocationCount() == settledBlocks);
+        CHECK(arena.GetPeakBytes() >= 16 * 32 * sizeof(float));
+    }
+
+    void TestArenaVectorGrowsInPlaceOfTheHeap() {
+        FrameArena arena;
+        ArenaVector<int> values(arena);
+        Test::AllocationScope scope;
+        for (int i = 0; i < 1000; ++i) values.PushBack(i);
+        CHECK(values.GetSize() == 1000);
+        CHECK(values[999] == 999);
+
+        arena.Reset();
+        ArenaVector<int> reused(arena, 1000);
+        for (int i = 0; i < 1000; ++i) reused.PushBack(i);
+        CHECK(reused[999] == 999);
+        CHECK(scope.GetCount() == 0);
+    }
+
+    // Rings, their instances and the recorded frame all come from reused
+    // storage, so a warmed-up frame allocates nothing at any quality
+    void TestCircularWaveFramesDoNotAllocate() {
+        SpectrumData spectrum(DEFAULT_BAR_COUNT);
+        for (size_t i = 0; i < spectrum.size(); ++i) {
+            spectrum[i] = 0.5f + 0.45f * std::sin(static_cast<float>(i) * 0.3f);
+        }
+
+        for (auto quality : { RenderQuality::Low, RenderQuality::Medium, RenderQuality::High }) {
+            FrameArena arena;
+            CircularWaveRenderer renderer;
+            renderer.SetFrameArena(&arena);
+            renderer.SetQuality(quality);
+            renderer.OnActivate(640, 360);
+            Test::CountingRenderBackend backend;
+
+            auto runFrame = [&]() {
+                arena.Reset();
+                renderer.Render(backend, spectrum, FRAME_TIME);
+            };
+            for (int frame = 0; frame < 10; ++frame) runFrame();
+
+            Test::AllocationScope scope;
+            for (int frame = 0; frame < 120; ++frame) runFrame();
+            if (scope.GetCount() != 0) {
+                std::fprintf(stderr, "quality %d allocated %zu times\n",
+                    static_cast<int>(quality), scope.GetCount());
+            }
+            CHECK(scope.GetCount() == 0);
+            CHECK(backend.GetCounters().drawCalls > 0);
+        }
+    }
+}
+
+int main() {
+    Test::Run("allocations honour their alignment", TestAllocationsAreAligned);
+    Test::Run("overflow settles into one block", TestOverflowSettlesIntoOneBlock);
+    Test::Run("arena vector stays off the heap", TestArenaVectorGrowsInPlaceOfTheHeap);
+    Test::Run("circular wave frames make no heap allocation", TestCircularWaveFramesDoNotAllocate);
+    return Test::Finish();
+}
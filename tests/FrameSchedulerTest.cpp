@@ -0,0 +1,127 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// FrameSchedulerTest.cpp: Frame pacing driven by ManualFrameClock, so every
+// interval is exact and the run takes no real time.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#include "TestHarness.h"
+#include "FrameScheduler.h"
+#include <cmath>
+
+using namespace Spectrum;
+using namespace std::chrono_literals;
+
+namespace {
+    struct ManualScheduler {
+        ManualFrameClock* clock;
+        FrameScheduler scheduler;
+
+        ManualScheduler() : ManualScheduler(std::make_unique<ManualFrameClock>()) {}
+
+        // Runs the next frame, returning how many WaitForFrame calls it took
+        int NextFrame() {
+            int polls = 1;
+            while (!scheduler.WaitForFrame()) ++polls;
+            return polls;
+        }
+
+    private:
+        explicit ManualScheduler(std::unique_ptr<ManualFrameClock> owned)
+            : clock(owned.get()), scheduler(std::move(owned)) {
+        }
+    };
+
+    bool NearlyEqual(float a, float b, float tolerance) {
+        return std::fabs(a - b) <= tolerance;
+    }
+
+    void TestFramesLandOnTheGrid() {
+        ManualScheduler s;
+        s.scheduler.SetTargetRate(60.0f);
+
+        for (int frame = 0; frame < 120; ++frame) {
+            s.NextFrame();
+            if (frame > 0) CHECK(NearlyEqual(s.scheduler.GetDeltaTime(), 1.0f / 60.0f, 1e-4f));
+            // Work shorter than a period never moves the grid
+            s.clock->Advance(frame % 2 == 0 ? 4ms : 11ms);
+        }
+
+        CHECK(s.scheduler.GetFrameCount() == 120);
+        CHECK(s.scheduler.GetMissedDeadlines() == 0);
+        CHECK(s.scheduler.GetPercentileMs(0.5f) == 17.0f);
+        CHECK(s.scheduler.GetPercentileMs(0.99f) == 17.0f);
+    }
+
+    // One slot late catches up right away; the average rate stays on target
+    void TestSlightlyLateFrameCatchesUp() {
+        ManualScheduler s;
+        s.scheduler.SetTargetRate(50.0f);
+
+        s.NextFrame();
+        s.clock->Advance(25ms);
+        s.NextFrame();
+        CHECK(NearlyEqual(s.scheduler.GetDeltaTime(), 0.025f, 1e-4f));
+
+        s.clock->Advance(1ms);
+        s.NextFrame();
+        CHECK(NearlyEqual(s.scheduler.GetDeltaTime(), 0.015f, 1e-4f));
+        CHECK(s.scheduler.GetMissedDeadlines() == 0);
+    }
+
+    // Far behind resyncs to a fresh grid instead of bursting frames
+    void TestStallResyncs() {
+        ManualScheduler s;
+        s.scheduler.SetTargetRate(50.0f);
+
+        s.NextFrame();
+        s.clock->Advance(100ms);
+        s.NextFrame();
+        CHECK(s.scheduler.GetMissedDeadlines() == 1);
+
+        s.NextFrame();
+        CHECK(NearlyEqual(s.scheduler.GetDeltaTime(), 0.020f, 1e-4f));
+    }
+
+    void TestUncappedNeverWaits() {
+        ManualScheduler s;
+        s.scheduler.SetTargetRate(0.0f);
+        CHECK(s.scheduler.IsUncapped());
+
+        for (int frame = 0; frame < 10; ++frame) {
+            CHECK(s.NextFrame() == 1);
+            s.clock->Advance(3ms);
+        }
+        CHECK(NearlyEqual(s.scheduler.GetDeltaTime(), 0.003f, 1e-4f));
+    }
+
+    // Idle frames are slow and stay out of the statistics; Wake() brings
+    // the next one forward
+    void TestIdleSlowsDownAndWakes() {
+        ManualScheduler s;
+        s.scheduler.SetTargetRate(60.0f);
+        s.NextFrame();
+        s.NextFrame();
+        s.scheduler.ResetStatistics();
+
+        s.scheduler.SetIdle(true);
+        s.NextFrame();
+        CHECK(NearlyEqual(s.scheduler.GetDeltaTime(), 0.1f, 1e-4f));
+        CHECK(s.scheduler.GetPercentileMs(0.5f) == 0.0f);
+
+        s.clock->Advance(5ms);
+        s.scheduler.Wake();
+        s.NextFrame();
+        CHECK(s.scheduler.GetDeltaTime() < 0.02f);
+
+        s.scheduler.SetIdle(false);
+        s.NextFrame();
+        CHECK(NearlyEqual(s.scheduler.GetDeltaTime(), 1.0f / 60.0f, 1e-4f));
+    }
+}
+
+int main() {
+    Test::Run("frames land on a fixed grid", TestFramesLandOnTheGrid);
+    Test::Run("a slightly late frame catches up", TestSlightlyLateFrameCatchesUp);
+    Test::Run("a stall resyncs instead of bursting", TestStallResyncs);
+    Test::Run("uncapped frames never wait", TestUncappedNeverWaits);
+    Test::Run("idle frames slow down until woken", TestIdleSlowsDownAndWakes);
+    return Test::Finish();
+}
@@ -0,0 +1,109 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// HeadlessRenderTest.cpp: Renders every style into the software backend
+// without a window or GPU and checks that each one produces pixels.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#include "TestHarness.h"
+#include "SoftwareRenderBackend.h"
+#include "TaskScheduler.h"
+#include "BarsRenderer.h"
+#include "WaveRenderer.h"
+#include "CircularWaveRenderer.h"
+#include "CubesRenderer.h"
+#include "FireRenderer.h"
+#include "LedPanelRenderer.h"
+#include "GaugeRenderer.h"
+#include "KenwoodBarsRenderer.h"
+#include "WaterfallRenderer.h"
+
+using namespace Spectrum;
+
+namespace {
+    constexpr int WIDTH = 320;
+    constexpr int HEIGHT = 180;
+    constexpr int FRAMES = 20;
+    constexpr Color BACKGROUND = Color::FromRGB(13, 13, 26);
+
+    // Mirrors RendererManager::CreateRenderer without the window layer
+    std::unique_ptr<IRenderer> CreateRenderer(RenderStyle style, TaskScheduler* scheduler) {
+        switch (style) {
+        case RenderStyle::Bars:         return std::make_unique<BarsRenderer>();
+        case RenderStyle::Wave:         return std::make_unique<WaveRenderer>();
+        case RenderStyle::CircularWave: return std::make_unique<CircularWaveRenderer>();
+        case RenderStyle::Cubes:        return std::make_unique<CubesRenderer>();
+        case RenderStyle::Fire:         return std::make_unique<FireRenderer>(scheduler);
+        case RenderStyle::LedPanel:     return std::make_unique<LedPanelRenderer>();
+        case RenderStyle::Gauge:        return std::make_unique<GaugeRenderer>();
+        case RenderStyle::KenwoodBars:  return std::make_unique<KenwoodBarsRenderer>();
+        case RenderStyle::Waterfall:    return std::make_unique<WaterfallRenderer>();
+        default:                        return nullptr;
+        }
+    }
+
+    SpectrumData MakeSpectrum(size_t barCount) {
+        SpectrumData spectrum(barCount);
+        for (size_t i = 0; i < barCount; ++i) {
+            spectrum[i] = 0.5f + 0.45f * std::sin(static_cast<float>(i) * 0.3f);
+        }
+        return spectrum;
+    }
+
+    size_t CountDrawnPixels(const SoftwareRenderBackend& backend, uint32_t background) {
+        const size_t total = static_cast<size_t>(backend.GetWidth()) * backend.GetHeight();
+        const uint32_t* pixels = backend.GetPixels();
+        return static_cast<size_t>(std::count_if(pixels, pixels + total,
+            [background](uint32_t pixel) { return pixel != background; }));
+    }
+
+    void RenderEveryStyle(TaskScheduler* scheduler, RenderQuality quality) {
+        SoftwareRenderBackend backend(scheduler);
+        backend.Resize(WIDTH, HEIGHT);
+
+        backend.BeginDraw();
+        backend.Clear(BACKGROUND);
+        backend.EndDraw();
+        const uint32_t background = backend.GetPixels()[0];
+
+        const SpectrumData spectrum = MakeSpectrum(DEFAULT_BAR_COUNT);
+        const size_t minimumDrawn = static_cast<size_t>(WIDTH) * HEIGHT / 200;
+
+        for (int i = 0; i < static_cast<int>(RenderStyle::Count); ++i) {
+            const auto style = static_cast<RenderStyle>(i);
+            auto renderer = CreateRenderer(style, scheduler);
+            CHECK(renderer != nullptr);
+            if (!renderer) continue;
+
+            renderer->SetQuality(quality);
+            renderer->OnActivate(WIDTH, HEIGHT);
+            for (int frame = 0; frame < FRAMES; ++frame) {
+                backend.BeginDraw();
+                backend.Clear(BACKGROUND);
+                renderer->Render(backend, spectrum, FRAME_TIME);
+                backend.EndDraw();
+            }
+
+            const size_t drawn = CountDrawnPixels(backend, background);
+            if (drawn < minimumDrawn) {
+                std::fprintf(stderr, "%s drew %zu pixels\n", renderer->GetName().data(), drawn);
+            }
+            CHECK(renderer->GetStyle() == style);
+            CHECK(drawn >= minimumDrawn);
+        }
+    }
+}
+
+int main() {
+    TaskScheduler scheduler;
+
+    Test::Run("every style draws on one thread", [] {
+        RenderEveryStyle(nullptr, RenderQuality::Medium);
+    });
+    Test::Run("every style draws with tiles in parallel", [&] {
+        RenderEveryStyle(&scheduler, RenderQuality::Medium);
+    });
+    Test::Run("every style draws at low and high quality", [&] {
+        RenderEveryStyle(&scheduler, RenderQuality::Low);
+        RenderEveryStyle(&scheduler, RenderQuality::High);
+    });
+
+    return Test::Finish();
+}
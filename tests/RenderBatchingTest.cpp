@@ -0,0 +1,179 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// RenderBatchingTest.cpp: Draw calls, path builds and texture uploads a
+// frame costs once same-color fills are batched and resources are retained.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#include "TestHarness.h"
+#include "CountingRenderBackend.h"
+#include "RenderCommandList.h"
+#include "WaveRenderer.h"
+#include "CircularWaveRenderer.h"
+#include "CubesRenderer.h"
+#include "LedPanelRenderer.h"
+#include "WaterfallRenderer.h"
+
+using namespace Spectrum;
+
+namespace {
+    constexpr int WIDTH = 640;
+    constexpr int HEIGHT = 360;
+    constexpr int FRAMES = 30;
+
+    SpectrumData MakeSpectrum(size_t barCount, float phase) {
+        SpectrumData spectrum(barCount);
+        for (size_t i = 0; i < barCount; ++i) {
+            spectrum[i] = 0.5f + 0.45f * std::sin(static_cast<float>(i) * 0.3f + phase);
+        }
+        return spectrum;
+    }
+
+    void TestBatchMergesByColor() {
+        const Color red = Color::FromRGB(255, 0, 0);
+        const Color blue = Color::FromRGB(0, 0, 255);
+
+        RenderCommandList commands;
+        commands.BeginBatch();
+        for (int i = 0; i < 64; ++i) {
+            const Rect rect(i * 10.0f, 0.0f, 8.0f, 8.0f);
+            commands.DrawRectangle(rect, i % 2 == 0 ? red : blue);
+            commands.DrawEllipse({ i * 10.0f, 20.0f }, 4.0f, 4.0f, i % 2 == 0 ? red : blue);
+        }
+        commands.EndBatch();
+
+        CHECK(commands.GetCommandCount() == 4);
+        CHECK(commands.GetBatchedShapeCount() == 128);
+
+        Test::CountingRenderBackend backend;
+        commands.Execute(backend);
+        CHECK(backend.GetCounters().drawCalls == 4);
+        CHECK(backend.GetCounters().shapes == 128);
+    }
+
+    // Anything that is not a solid fill flushes first, keeping painter's order
+    void TestOtherCommandsFlushTheBatch() {
+        const Color white = Color::FromRGB(255, 255, 255);
+
+        RenderCommandList commands;
+        commands.BeginBatch();
+        commands.DrawRectangle(Rect(0.0f, 0.0f, 4.0f, 4.0f), white);
+        commands.DrawRectangle(Rect(8.0f, 0.0f, 4.0f, 4.0f), white);
+        commands.DrawLine({ 0.0f, 0.0f }, { 10.0f, 10.0f }, white);
+        commands.DrawRectangle(Rect(16.0f, 0.0f, 4.0f, 4.0f), white);
+        commands.DrawRectangle(Rect(24.0f, 0.0f, 4.0f, 4.0f), white, false);
+        commands.EndBatch();
+
+        // Fill pair, line, single fill, outline
+        CHECK(commands.GetCommandCount() == 4);
+        CHECK(commands.GetBatchedShapeCount() == 3);
+    }
+
+    // Lit LEDs snap to a few brightness steps, so each row costs a handful
+    // of fills instead of one per column
+    void TestLedPanelBatchesLitLeds() {
+        LedPanelRenderer renderer;
+        renderer.OnActivate(WIDTH, HEIGHT);
+        Test::CountingRenderBackend backend;
+
+        for (int frame = 0; frame < FRAMES; ++frame) {
+            renderer.Render(backend, MakeSpectrum(DEFAULT_BAR_COUNT, frame * 0.1f), FRAME_TIME);
+        }
+
+        backend.ResetCounters();
+        renderer.Render(backend, MakeSpectrum(DEFAULT_BAR_COUNT, FRAMES * 0.1f), FRAME_TIME);
+        const auto& counters = backend.GetCounters();
+        const size_t batched = renderer.GetCommandList().GetBatchedShapeCount();
+
+        std::printf("  LED panel      %zu draw calls for %zu shapes, %zu batched\n",
+            counters.drawCalls, counters.shapes, batched);
+        CHECK(batched > 0);
+        CHECK(counters.drawCalls * 4 <= counters.shapes);
+    }
+
+    // A still frame builds nothing after the first; a moving one builds at
+    // most the shape that changed
+    template <typename TRenderer>
+    void CheckGeometryBuilds(const char* name, size_t maxMovingBuilds) {
+        TRenderer renderer;
+        renderer.OnActivate(WIDTH, HEIGHT);
+        Test::CountingRenderBackend backend;
+
+        const SpectrumData still = MakeSpectrum(DEFAULT_BAR_COUNT, 0.0f);
+        for (int frame = 0; frame < FRAMES; ++frame) {
+            renderer.Render(backend, still, FRAME_TIME);
+        }
+        const size_t stillBuilds = backend.GetCounters().geometryBuilds;
+
+        backend.ResetCounters();
+        for (int frame = 0; frame < FRAMES; ++frame) {
+            renderer.Render(backend, MakeSpectrum(DEFAULT_BAR_COUNT, frame * 0.1f), FRAME_TIME);
+        }
+        const size_t movingBuilds = backend.GetCounters().geometryBuilds;
+
+        std::printf("  %-14s still %zu, moving %zu over %d frames\n",
+            name, stillBuilds, movingBuilds, FRAMES);
+        CHECK(stillBuilds == 1);
+        CHECK(movingBuilds <= maxMovingBuilds);
+    }
+
+    void TestRetainedShapesBuildOnce() {
+        // The wave line changes with the spectrum; its reflection is free
+        CheckGeometryBuilds<WaveRenderer>("Wave", FRAMES);
+        // Rings and cube faces are instances of one unit shape
+        CheckGeometryBuilds<CircularWaveRenderer>("Circular wave", 0);
+        CheckGeometryBuilds<CubesRenderer>("Cubes", 0);
+    }
+
+    void TestDirtyRowsCoverRecentWrites() {
+        RetainedImage image;
+        image.Resize(4, 100);
+        const uint32_t start = image.GetHandle().revision;
+
+        int first = -1, count = -1;
+        CHECK(image.GetRowsDirtySince(start, first, count));
+        CHECK(count == 0);
+
+        image.MarkRowsDirty(40, 2);
+        image.MarkRowsDirty(10, 5);
+        CHECK(image.GetRowsDirtySince(start, first, count));
+        CHECK(first == 10 && count == 32);
+        CHECK(image.GetRowsDirtySince(start + 1, first, count));
+        CHECK(first == 10 && count == 5);
+
+        // A copy older than the log has to take the whole image
+        for (int i = 0; i < 16; ++i) image.MarkRowsDirty(i, 1);
+        CHECK(!image.GetRowsDirtySince(start, first, count));
+    }
+
+    // Without a history the waterfall scrolls one row per frame, and only
+    // that row goes to the texture, including where the ring wraps
+    void TestWaterfallUploadsNewRowsOnly() {
+        WaterfallRenderer renderer;
+        renderer.OnActivate(WIDTH, HEIGHT);
+        Test::CountingRenderBackend backend;
+
+        for (int frame = 0; frame < FRAMES; ++frame) {
+            renderer.Render(backend, MakeSpectrum(DEFAULT_BAR_COUNT, frame * 0.1f), FRAME_TIME);
+        }
+
+        backend.ResetCounters();
+        const int frames = HEIGHT;
+        for (int frame = 0; frame < frames; ++frame) {
+            renderer.Render(backend, MakeSpectrum(DEFAULT_BAR_COUNT, frame * 0.1f), FRAME_TIME);
+        }
+        const auto& counters = backend.GetCounters();
+
+        std::printf("  Waterfall      %zu rows over %zu uploads\n",
+            counters.imageRowsUploaded, counters.imageUploads);
+        CHECK(counters.imageUploads == static_cast<size_t>(frames));
+        CHECK(counters.imageRowsUploaded == static_cast<size_t>(frames));
+    }
+}
+
+int main() {
+    Test::Run("batched fills merge by color", TestBatchMergesByColor);
+    Test::Run("other commands flush the batch", TestOtherCommandsFlushTheBatch);
+    Test::Run("lit LEDs batch into few fills", TestLedPanelBatchesLitLeds);
+    Test::Run("retained shapes build once", TestRetainedShapesBuildOnce);
+    Test::Run("dirty rows cover recent writes", TestDirtyRowsCoverRecentWrites);
+    Test::Run("waterfall uploads only new rows", TestWaterfallUploadsNewRowsOnly);
+    return Test::Finish();
+}
@@ -0,0 +1,82 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// SpectrumHistoryTest.cpp: Rows walked in order, and readers on several
+// threads sharing the history while a producer waits its turn.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#include "TestHarness.h"
+#include "SpectrumHistory.h"
+
+using namespace Spectrum;
+
+namespace {
+    using Clock = SpectrumHistory::Clock;
+
+    constexpr size_t BAR_COUNT = 16;
+    constexpr size_t READER_THREADS = 4;
+
+    void PushRow(SpectrumHistory& history, float value) {
+        const SpectrumData bars(BAR_COUNT, value);
+        history.Push(bars, Clock::now());
+    }
+
+    void TestReaderWalksNewRowsInOrder() {
+        SpectrumHistory history(8);
+        for (int i = 1; i <= 12; ++i) PushRow(history, i / 16.0f);
+
+        const auto reader = history.Read();
+        CHECK(reader.GetCount() == 8);
+        CHECK(reader.GetLatestSequence() == 12);
+        CHECK(reader.GetFrame(0).bars[0] == 12 / 16.0f);
+
+        uint64_t expected = 10;
+        const uint64_t latest = reader.ForEachSince(9, [&](const SpectrumHistory::Frame& frame) {
+            CHECK(frame.sequence == expected);
+            CHECK(frame.bars[BAR_COUNT - 1] == expected / 16.0f);
+            ++expected;
+        });
+        CHECK(latest == 12);
+        CHECK(expected == 13);
+    }
+
+    // Every reader thread holds its Reader until all of them do; with
+    // exclusive readers the first would never see the others arrive
+    void TestReadersOverlapAcrossThreads() {
+        SpectrumHistory history;
+        PushRow(history, 0.5f);
+
+        std::atomic<size_t> holding{ 0 };
+        std::atomic<size_t> overlapped{ 0 };
+        const auto deadline = Clock::now() + std::chrono::seconds(5);
+        auto waitForReaders = [&] {
+            while (holding.load() < READER_THREADS && Clock::now() < deadline) {
+                std::this_thread::yield();
+            }
+        };
+
+        std::vector<std::thread> readers;
+        for (size_t i = 0; i < READER_THREADS; ++i) {
+            readers.emplace_back([&] {
+                const auto reader = history.Read();
+                holding.fetch_add(1);
+                waitForReaders();
+                if (holding.load() == READER_THREADS) overlapped.fetch_add(1);
+                CHECK(reader.GetFrame(0).bars[0] == 0.5f);
+            });
+        }
+
+        // A producer arriving while they read gets in once they are gone
+        waitForReaders();
+        std::thread producer([&] { PushRow(history, 0.25f); });
+        for (auto& reader : readers) reader.join();
+        producer.join();
+
+        CHECK(overlapped.load() == READER_THREADS);
+        CHECK(history.GetLatestSequence() == 2);
+        CHECK(history.Read().GetFrame(0).bars[0] == 0.25f);
+    }
+}
+
+int main() {
+    Test::Run("reader walks new rows in order", TestReaderWalksNewRowsInOrder);
+    Test::Run("readers overlap across threads", TestReadersOverlapAcrossThreads);
+    return Test::Finish();
+}
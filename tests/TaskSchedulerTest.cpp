@@ -0,0 +1,135 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// TaskSchedulerTest.cpp: Ordering and completion guarantees of the pool,
+// plus its scaling from one to every core on a bank of analyzers.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#include "TestHarness.h"
+#include "TaskScheduler.h"
+#include "SpectrumAnalyzer.h"
+
+using namespace Spectrum;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    void TestParallelForVisitsEveryIndexOnce() {
+        TaskScheduler scheduler(3);
+        std::vector<std::atomic<int>> visits(1000);
+
+        scheduler.ParallelFor(visits.size(), [&](size_t i) {
+            visits[i].fetch_add(1, std::memory_order_relaxed);
+        });
+
+        for (const auto& count : visits) CHECK(count.load() == 1);
+    }
+
+    void TestDependenciesRunFirst() {
+        TaskScheduler scheduler(3);
+        std::atomic<int> step{ 0 };
+        int firstSeen = -1, secondSeen = -1, joinSeen = -1;
+
+        auto first = scheduler.Submit([&] { firstSeen = step.fetch_add(1); });
+        auto second = scheduler.Submit([&] { secondSeen = step.fetch_add(1); });
+        auto join = scheduler.Submit([&] { joinSeen = step.fetch_add(1); }, { first, second });
+        scheduler.Wait(join);
+
+        CHECK(firstSeen >= 0 && secondSeen >= 0);
+        CHECK(joinSeen == 2);
+    }
+
+    void TestNestedParallelForCompletes() {
+        TaskScheduler scheduler(2);
+        std::atomic<int> total{ 0 };
+
+        scheduler.ParallelFor(8, [&](size_t) {
+            scheduler.ParallelFor(8, [&](size_t) { total.fetch_add(1); });
+        });
+
+        CHECK(total.load() == 64);
+    }
+
+    // A waiter with nothing to help with sleeps instead of spinning
+    void TestWaitSleepsWhileIdle() {
+        TaskScheduler scheduler(1);
+        auto slow = scheduler.Submit([] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        });
+
+        const auto start = Clock::now();
+        const std::clock_t cpuStart = std::clock();
+        scheduler.Wait(slow);
+        const double cpuMs = 1000.0 * static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+        const double wallMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        CHECK(slow->isDone.load());
+        CHECK(wallMs >= 90.0);
+        // Process CPU time; a spinning waiter would burn about wallMs
+        CHECK(cpuMs < wallMs * 0.5);
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Scaling benchmark: a bank of independent analyzers, one task each
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    constexpr size_t ANALYZER_COUNT = 8;
+    constexpr size_t ROUNDS = 20;
+    constexpr size_t FRAMES_PER_ROUND = 4800;
+
+    struct AnalyzerBank {
+        std::vector<std::unique_ptr<SpectrumAnalyzer>> analyzers;
+        std::vector<float> block;
+
+        AnalyzerBank() : block(FRAMES_PER_ROUND * 2) {
+            for (size_t i = 0; i < ANALYZER_COUNT; ++i) {
+                analyzers.push_back(std::make_unique<SpectrumAnalyzer>(128, 4096));
+                analyzers.back()->SetSampleRate(48000);
+            }
+            for (size_t i = 0; i < block.size(); ++i) {
+                block[i] = 0.5f * std::sin(static_cast<float>(i) * 0.01f);
+            }
+        }
+
+        void RunOne(size_t index) {
+            analyzers[index]->OnAudioData(block.data(), block.size(), 2);
+            analyzers[index]->Update();
+        }
+    };
+
+    double RunBank(TaskScheduler* scheduler) {
+        AnalyzerBank bank;
+        const auto start = Clock::now();
+        for (size_t round = 0; round < ROUNDS; ++round) {
+            if (scheduler) {
+                scheduler->ParallelFor(ANALYZER_COUNT, [&](size_t i) { bank.RunOne(i); });
+            }
+            else {
+                for (size_t i = 0; i < ANALYZER_COUNT; ++i) bank.RunOne(i);
+            }
+        }
+        const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        for (const auto& analyzer : bank.analyzers) CHECK(analyzer->GetSpectrumVersion() > 0);
+        return ms / ROUNDS;
+    }
+
+    void BenchmarkAnalyzerBankScaling() {
+        const size_t cores = std::max<size_t>(1, std::thread::hardware_concurrency());
+        const double serialMs = RunBank(nullptr);
+        std::printf("  threads  ms/round  speedup\n");
+        std::printf("  %7d  %8.2f  %6.2fx\n", 1, serialMs, 1.0);
+
+        // The calling thread works too, so N threads means N - 1 workers
+        for (size_t threads = 2; threads <= cores; ++threads) {
+            TaskScheduler scheduler(threads - 1);
+            const double ms = RunBank(&scheduler);
+            std::printf("  %7zu  %8.2f  %6.2fx\n", threads, ms, serialMs / ms);
+        }
+    }
+}
+
+int main() {
+    Test::Run("parallel for visits every index once", TestParallelForVisitsEveryIndexOnce);
+    Test::Run("dependencies finish before their dependent", TestDependenciesRunFirst);
+    Test::Run("nested parallel for completes", TestNestedParallelForCompletes);
+    Test::Run("wait sleeps while there is nothing to run", TestWaitSleepsWhileIdle);
+    Test::Run("analyzer bank scaling", BenchmarkAnalyzerBankScaling);
+    return Test::Finish();
+}
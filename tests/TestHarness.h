@@ -0,0 +1,42 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// TestHarness.h: Minimal checks shared by the standalone test executables.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#ifndef SPECTRUM_CPP_TEST_HARNESS_H
+#define SPECTRUM_CPP_TEST_HARNESS_H
+
+#include <cstdio>
+
+namespace Spectrum {
+    namespace Test {
+
+        inline int& FailureCount() {
+            static int failures = 0;
+            return failures;
+        }
+
+        inline void ReportFailure(const char* file, int line, const char* expression) {
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+            ++FailureCount();
+        }
+
+        // Runs one named case and prints its outcome
+        template<typename TCase>
+        void Run(const char* name, TCase&& testCase) {
+            const int before = FailureCount();
+            testCase();
+            std::printf("[%s] %s\n", FailureCount() == before ? " OK " : "FAIL", name);
+        }
+
+        inline int Finish() {
+            return FailureCount() == 0 ? 0 : 1;
+        }
+
+    }
+}
+
+#define CHECK(expression) \
+    do { \
+        if (!(expression)) ::Spectrum::Test::ReportFailure(__FILE__, __LINE__, #expression); \
+    } while (false)
+
+#endif